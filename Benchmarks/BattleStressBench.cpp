@@ -0,0 +1,492 @@
+/**
+ * @file       BattleStressBench.cpp
+ * @brief      按场景脚本运行整场战斗的压力基准
+ * @details    读取场景文件（地图、建筑布局、兵力与投放脚本），以固定种子、固定步长推进 N 步，输出：
+ *             1. 各子系统每步耗时的平均值 / p50 / p99 / 最大值：单位 AI、兵群分离、弹道、陷阱、
+ *                防御建筑、伤害结算（BattleWorld::getStepTimings），以及表现同步（见下）；
+ *             2. 每帧耗时（一步模拟 + 表现同步）的 p50 / p99；
+ *             3. 模拟期间的堆分配次数与字节数（本程序替换全局 operator new 计数）；
+ *             4. 回归检查：每步结束时统计处于攻击状态却既不在射程内也未接触目标建筑的单位（stalled attacks），
+ *                不为 0 时程序以失败退出。regression_last_defender.txt 为专门的回归场景（不在标准场景之列）。
+ *             表现同步只包含 BattleScene::syncBattleViews 中不依赖引擎的部分：读取核心状态、插值单位与弹道位置、
+ *             按视野剔除并消费事件；引擎绘制需要在游戏内用 Director::setDisplayStats 观察，不在本基准范围内。
+ *             用法：battle_stress_bench [选项] [场景文件...]，不指定场景文件时依次运行 scenarios 目录下的三个标准场景：
+ *               enemy_map1_50.txt     Enemy_map1 布局，50 名士兵
+ *               enemy_map4_500.txt    Enemy_map4 布局，500 名士兵
+ *               synthetic_2000.txt    6400x3584 合成大地图，2000 名士兵
+ *             选项：--ticks N 覆盖步数；--seed S 覆盖随机种子；--threads N 使用 N 个工作线程（默认单线程）
+ * @version    1.0
+ * @note       只依赖 battle_core；结果末尾的状态哈希可用于确认两次运行的模拟完全一致。
+ *             场景文件为逐行的文本指令（# 之后为注释），坐标均为地图节点坐标：
+ *               name <名称>                                        场景名称
+ *               map <宽> <高> <瓦片宽> <瓦片高>                      地图尺寸（像素）
+ *               ticks <步数> / seed <种子> / splash <溅射半径>        默认 1800 步、种子 1、BattleRules::CANNON_SPLASH_RADIUS
+ *               view <x> <y> <宽> <高>                               表现同步的视野（默认整张地图）
+ *               forbid <x> <y> <宽> <高>                             禁止投放区域
+ *               trap <x> <y> <宽> <高> <伤害>                        陷阱
+ *               building <类型> <x> <y> <宽> <高> <血量> <攻击> <射程> [驻军]   建筑（EnemyType 名称，(x, y) 为占地左下角）
+ *               army <兵种> <数量>                                   可投放兵力（SoldierType 名称）
+ *               deploy <步> <兵种> <数量> <x> <y> <宽> <高>          第 <步> 步之前在矩形内随机投放
+ */
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "BattleJobSystem.h"
+#include "BattleRules.h"
+#include "BattleWorld.h"
+
+// =========================================================
+// 1. 堆分配计数
+// =========================================================
+
+namespace {
+
+std::atomic<long long> g_allocCount(0);
+std::atomic<long long> g_allocBytes(0);
+
+void* countedAlloc(std::size_t size)
+{
+    g_allocCount.fetch_add(1, std::memory_order_relaxed);
+    g_allocBytes.fetch_add(static_cast<long long>(size), std::memory_order_relaxed);
+    void* p = std::malloc(size ? size : 1);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+
+} // namespace
+
+void* operator new(std::size_t size) { return countedAlloc(size); }
+void* operator new[](std::size_t size) { return countedAlloc(size); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+
+namespace {
+
+// =========================================================
+// 2. 场景文件
+// =========================================================
+
+#ifndef BATTLE_SCENARIO_DIR
+#define BATTLE_SCENARIO_DIR "Benchmarks/scenarios"
+#endif
+
+const char* const CANONICAL_SCENARIOS[] = {
+    "enemy_map1_50.txt",
+    "enemy_map4_500.txt",
+    "synthetic_2000.txt"
+};
+
+/// 投放点不合法时在同一矩形内重新取点的次数
+const int DEPLOY_ATTEMPTS = 16;
+
+/// 一条投放指令：第 tick 步之前在矩形内随机投放 count 名士兵
+struct DeployCommand {
+    int tick;
+    SoldierType type;
+    int count;
+    BattleRect area;
+};
+
+/// 一个场景
+struct Scenario {
+    std::string name;
+    BattleLevelDesc level;
+    int army[BATTLE_SOLDIER_TYPE_COUNT];
+    std::vector<DeployCommand> deploys;
+    BattleRect view;            ///< 表现同步使用的视野（默认整张地图）
+    bool hasView;
+    int ticks;
+    unsigned seed;
+    float step;
+
+    Scenario() : hasView(false), ticks(1800), seed(1u), step(1.0f / 30.0f)
+    {
+        for (int t = 0; t < BATTLE_SOLDIER_TYPE_COUNT; ++t) army[t] = 0;
+        level.cannonSplashRadius = BattleRules::CANNON_SPLASH_RADIUS;
+    }
+};
+
+bool parseSoldier(const std::string& token, SoldierType& out)
+{
+    static const char* const NAMES[BATTLE_SOLDIER_TYPE_COUNT] = { "ORIGINAL", "ARROW", "BOOM", "GIANT", "AIRFORCE" };
+    for (int t = 0; t < BATTLE_SOLDIER_TYPE_COUNT; ++t) {
+        if (token == NAMES[t]) {
+            out = static_cast<SoldierType>(t);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool parseBuilding(const std::string& token, EnemyType& out)
+{
+    static const char* const NAMES[] = {
+        "BASE", "BARRACKS", "MINE", "WATER", "GOLD_STORAGE", "WATER_STORAGE", "CANNON", "TOWER", "WALL"
+    };
+    for (int t = 0; t < static_cast<int>(sizeof(NAMES) / sizeof(NAMES[0])); ++t) {
+        if (token == NAMES[t]) {
+            out = static_cast<EnemyType>(t);
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief      读取场景文件
+ * @param      path   文件路径
+ * @param      out    输出的场景
+ * @param      error  失败时的错误信息（含行号）
+ * @return     bool   成功返回 true
+ */
+bool loadScenario(const std::string& path, Scenario& out, std::string& error)
+{
+    std::ifstream in(path.c_str());
+    if (!in) {
+        error = "cannot open " + path;
+        return false;
+    }
+
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(in, line)) {
+        lineNumber++;
+        const size_t comment = line.find('#');
+        if (comment != std::string::npos) line.erase(comment);
+
+        std::istringstream fields(line);
+        std::string keyword;
+        if (!(fields >> keyword)) continue;
+
+        bool ok = true;
+        if (keyword == "name") {
+            ok = static_cast<bool>(fields >> out.name);
+        }
+        else if (keyword == "map") {
+            ok = static_cast<bool>(fields >> out.level.mapWidth >> out.level.mapHeight
+                >> out.level.tileWidth >> out.level.tileHeight);
+        }
+        else if (keyword == "ticks") {
+            ok = static_cast<bool>(fields >> out.ticks);
+        }
+        else if (keyword == "seed") {
+            ok = static_cast<bool>(fields >> out.seed);
+        }
+        else if (keyword == "splash") {
+            ok = static_cast<bool>(fields >> out.level.cannonSplashRadius);
+        }
+        else if (keyword == "view") {
+            float x, y, w, h;
+            ok = static_cast<bool>(fields >> x >> y >> w >> h);
+            out.view = BattleRect(x, y, w, h);
+            out.hasView = true;
+        }
+        else if (keyword == "forbid") {
+            float x, y, w, h;
+            ok = static_cast<bool>(fields >> x >> y >> w >> h);
+            out.level.forbiddenRects.push_back(BattleRect(x, y, w, h));
+        }
+        else if (keyword == "trap") {
+            BattleTrapDesc trap;
+            float x, y, w, h;
+            ok = static_cast<bool>(fields >> x >> y >> w >> h >> trap.damage);
+            trap.area = BattleRect(x, y, w, h);
+            out.level.traps.push_back(trap);
+        }
+        else if (keyword == "building") {
+            // building <类型> <x> <y> <宽> <高> <血量> <攻击> <射程> [驻军]，(x, y) 为占地左下角
+            std::string type;
+            BattleBuildingDesc b;
+            float x, y, w, h;
+            ok = static_cast<bool>(fields >> type >> x >> y >> w >> h >> b.hp >> b.attack >> b.range)
+                && parseBuilding(type, b.type);
+            fields >> b.garrison;
+            b.footprint = BattleRect(x, y, w, h);
+            b.position = b.footprint.center();
+            out.level.buildings.push_back(b);
+        }
+        else if (keyword == "army") {
+            std::string type;
+            SoldierType soldier;
+            int count;
+            ok = static_cast<bool>(fields >> type >> count) && parseSoldier(type, soldier);
+            if (ok) out.army[soldier] += count;
+        }
+        else if (keyword == "deploy") {
+            // deploy <步> <兵种> <数量> <x> <y> <宽> <高>
+            std::string type;
+            DeployCommand d;
+            float x, y, w, h;
+            ok = static_cast<bool>(fields >> d.tick >> type >> d.count >> x >> y >> w >> h) && parseSoldier(type, d.type);
+            d.area = BattleRect(x, y, w, h);
+            out.deploys.push_back(d);
+        }
+        else {
+            ok = false;
+        }
+
+        if (!ok) {
+            error = path + ":" + std::to_string(lineNumber) + ": cannot parse '" + line + "'";
+            return false;
+        }
+    }
+
+    if (out.level.mapWidth <= 0.0f || out.level.buildings.empty()) {
+        error = path + ": missing map size or buildings";
+        return false;
+    }
+    if (out.name.empty()) out.name = path;
+    if (!out.hasView) out.view = BattleRect(0.0f, 0.0f, out.level.mapWidth, out.level.mapHeight);
+    std::stable_sort(out.deploys.begin(), out.deploys.end(),
+        [](const DeployCommand& a, const DeployCommand& b) { return a.tick < b.tick; });
+    return true;
+}
+
+// =========================================================
+// 3. 运行与统计
+// =========================================================
+
+/// 固定种子的线性同余随机数（[0, 1)）
+struct Random {
+    unsigned state;
+    explicit Random(unsigned seed) : state(seed) {}
+    float next()
+    {
+        state = state * 1664525u + 1013904223u;
+        return static_cast<float>(state >> 8) / 16777216.0f;
+    }
+};
+
+/// 统计列：每步一个样本（微秒）
+enum Column {
+    COL_AI = 0,
+    COL_SEPARATION,
+    COL_PROJECTILES,
+    COL_TRAPS,
+    COL_TOWERS,
+    COL_DAMAGE,
+    COL_STEP,
+    COL_VIEW,
+    COL_FRAME,
+    COLUMN_COUNT
+};
+
+const char* const COLUMN_NAMES[COLUMN_COUNT] = {
+    "soldier ai", "separation", "projectiles", "traps", "towers", "damage", "step total", "view sync", "frame"
+};
+
+/**
+ * @brief      表现同步中不依赖引擎的部分（对应 BattleScene::syncBattleViews）
+ * @details    插值存活单位与飞行中弹道的位置并按视野剔除，随后消费事件
+ * @return     int  视野内的单位与弹道数量
+ */
+int syncView(BattleWorld& world, const BattleRect& view, float alpha, float renderDelay)
+{
+    int visible = 0;
+    const BattleUnitStore& units = world.units();
+    for (size_t i = 0; i < units.size(); ++i) {
+        if (!units.alive[i]) continue;
+        const float x = units.prevX[i] + (units.x[i] - units.prevX[i]) * alpha;
+        const float y = units.prevY[i] + (units.y[i] - units.prevY[i]) * alpha;
+        if (view.containsPoint(x, y)) visible++;
+    }
+
+    const BattleProjectilePool& pool = world.projectiles();
+    for (int slot = 0; slot < static_cast<int>(pool.getCapacity()); ++slot) {
+        const BattleProjectile& p = pool.at(slot);
+        if (!p.active) continue;
+        float progress = 1.0f;
+        if (p.flightTime > 0.0f) {
+            progress = std::max(0.0f, std::min(1.0f, (p.flightTime - p.timeLeft - renderDelay) / p.flightTime));
+        }
+        const BattleVec2 pos = p.from + (p.to - p.from) * progress;
+        if (view.containsPoint(pos.x, pos.y)) visible++;
+    }
+
+    world.clearEvents();
+    return visible;
+}
+
+double percentile(std::vector<double> samples, double q)
+{
+    if (samples.empty()) return 0.0;
+    const size_t k = std::min(samples.size() - 1, static_cast<size_t>(q * (samples.size() - 1) + 0.5));
+    std::nth_element(samples.begin(), samples.begin() + k, samples.end());
+    return samples[k];
+}
+
+/**
+ * @brief      统计本步结束时“隔空攻击”的进攻方单位数（回归检查）
+ * @details    处于攻击状态、没有交战守军、目标建筑仍存在，却既不在射程内也未接触目标的单位：
+ *             这样的单位会一直原地攻击而不再移动（例如与最后一名守军交战后沿用了攻击结论）。
+ *             判定与 BattleWorld::thinkUnit 的攻击条件一致
+ */
+int countStalledAttacks(const BattleWorld& world)
+{
+    int stalled = 0;
+    const BattleUnitStore& units = world.units();
+    const BattleBuildingStore& buildings = world.buildings();
+    for (size_t i = 0; i < units.size(); ++i) {
+        if (!units.alive[i] || units.team[i] || units.foe[i] != BATTLE_INVALID_INDEX) continue;
+        if (units.state[i] != static_cast<uint8_t>(BattleUnitState::ATTACKING)) continue;
+        const int t = units.target[i];
+        if (t == BATTLE_INVALID_INDEX || buildings.hp[t] <= 0 || buildings.destroyed[t]) continue;
+
+        const BattleVec2 pos(units.x[i], units.y[i]);
+        if (pos.distance(BattleVec2(buildings.x[t], buildings.y[t])) <= units.attackRange[i]) continue;
+        const float h = units.halfSize[i];
+        if (BattleRect(units.x[i] - h, units.y[i] - h, h * 2.0f, h * 2.0f).intersects(buildings.footprint[t])) continue;
+        stalled++;
+    }
+    return stalled;
+}
+
+const char* outcomeName(BattleOutcome outcome)
+{
+    switch (outcome) {
+        case BattleOutcome::VICTORY: return "victory";
+        case BattleOutcome::DEFEAT: return "defeat";
+        default: return "running";
+    }
+}
+
+/**
+ * @brief      运行一个场景并输出统计
+ * @return     bool  未发现隔空攻击的单位返回 true
+ */
+bool runScenario(const Scenario& scenario, BattleJobSystem* jobs)
+{
+    BattleWorld world;
+    world.loadLevel(scenario.level);
+    world.setJobSystem(jobs);
+    world.setProfilingEnabled(true);
+    for (int t = 0; t < BATTLE_SOLDIER_TYPE_COUNT; ++t) world.setReserve(static_cast<SoldierType>(t), scenario.army[t]);
+
+    std::vector<double> samples[COLUMN_COUNT];
+    for (int c = 0; c < COLUMN_COUNT; ++c) samples[c].reserve(scenario.ticks);
+
+    Random random(scenario.seed);
+    size_t nextDeploy = 0;
+    int deployed = 0;
+    int rejected = 0;
+    int peakUnits = 0;
+    int peakVisible = 0;
+    long long stalledAttacks = 0;
+    long long allocCount = 0;
+    long long allocBytes = 0;
+    int tick = 0;
+
+    // 渲染时刻取两步中间，与 60 帧显示 30 Hz 模拟时的平均插值系数一致
+    const float alpha = 0.5f;
+    for (; tick < scenario.ticks && world.getOutcome() == BattleOutcome::RUNNING; ++tick) {
+        // 投放在第 tick 步之前执行（与 BattleScene 录像的投放时机一致），投放点不合法时重新取点
+        for (; nextDeploy < scenario.deploys.size() && scenario.deploys[nextDeploy].tick <= tick; ++nextDeploy) {
+            const DeployCommand& d = scenario.deploys[nextDeploy];
+            for (int k = 0; k < d.count; ++k) {
+                bool placed = false;
+                for (int attempt = 0; attempt < DEPLOY_ATTEMPTS && !placed; ++attempt) {
+                    const BattleVec2 pos(d.area.x + random.next() * d.area.w, d.area.y + random.next() * d.area.h);
+                    placed = world.deployUnit(d.type, pos) != BATTLE_INVALID_INDEX;
+                }
+                if (placed) deployed++;
+                else rejected++;
+            }
+        }
+
+        const long long countBefore = g_allocCount.load(std::memory_order_relaxed);
+        const long long bytesBefore = g_allocBytes.load(std::memory_order_relaxed);
+        const auto begin = std::chrono::steady_clock::now();
+        world.step(scenario.step);
+        const auto stepped = std::chrono::steady_clock::now();
+        const int visible = syncView(world, scenario.view, alpha, (1.0f - alpha) * scenario.step);
+        const auto end = std::chrono::steady_clock::now();
+        stalledAttacks += countStalledAttacks(world);
+        allocCount += g_allocCount.load(std::memory_order_relaxed) - countBefore;
+        allocBytes += g_allocBytes.load(std::memory_order_relaxed) - bytesBefore;
+
+        const BattleStepTimings& t = world.getStepTimings();
+        samples[COL_AI].push_back(t.ai);
+        samples[COL_SEPARATION].push_back(t.separation);
+        samples[COL_PROJECTILES].push_back(t.projectiles);
+        samples[COL_TRAPS].push_back(t.traps);
+        samples[COL_TOWERS].push_back(t.towers);
+        samples[COL_DAMAGE].push_back(t.damage);
+        samples[COL_STEP].push_back(std::chrono::duration<double, std::micro>(stepped - begin).count());
+        samples[COL_VIEW].push_back(std::chrono::duration<double, std::micro>(end - stepped).count());
+        samples[COL_FRAME].push_back(std::chrono::duration<double, std::micro>(end - begin).count());
+        peakUnits = std::max(peakUnits, world.getAliveUnitCount() + world.getAliveDefenderCount());
+        peakVisible = std::max(peakVisible, visible);
+    }
+
+    std::printf("== %s ==\n", scenario.name.c_str());
+    std::printf("ticks %d/%d  deployed %d  rejected %d  peak units %d  peak visible %d  outcome %s  destruction %d%%\n",
+        tick, scenario.ticks, deployed, rejected, peakUnits, peakVisible, outcomeName(world.getOutcome()),
+        world.getDestructionPercent());
+    std::printf("%-12s %10s %10s %10s %10s %10s\n", "subsystem", "total ms", "mean us", "p50 us", "p99 us", "max us");
+    for (int c = 0; c < COLUMN_COUNT; ++c) {
+        const std::vector<double>& s = samples[c];
+        double total = 0.0;
+        for (double v : s) total += v;
+        const double maxValue = s.empty() ? 0.0 : *std::max_element(s.begin(), s.end());
+        std::printf("%-12s %10.2f %10.2f %10.2f %10.2f %10.2f\n", COLUMN_NAMES[c], total / 1000.0,
+            s.empty() ? 0.0 : total / s.size(), percentile(s, 0.5), percentile(s, 0.99), maxValue);
+    }
+    std::printf("frame time p50 %.3f ms  p99 %.3f ms\n",
+        percentile(samples[COL_FRAME], 0.5) / 1000.0, percentile(samples[COL_FRAME], 0.99) / 1000.0);
+    std::printf("allocations %lld (%.2f per tick)  %.1f KiB\n", allocCount,
+        tick > 0 ? static_cast<double>(allocCount) / tick : 0.0, allocBytes / 1024.0);
+    std::printf("stalled attacks %lld\n", stalledAttacks);
+    std::printf("state hash %08x\n\n", world.computeStateHash());
+    return stalledAttacks == 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    int ticks = -1;
+    long long seed = -1;
+    int threads = 0;
+    std::vector<std::string> paths;
+    for (int i = 1; i < argc; ++i) {
+        const bool hasValue = i + 1 < argc;
+        if (std::strcmp(argv[i], "--ticks") == 0 && hasValue) ticks = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--seed") == 0 && hasValue) seed = std::atoll(argv[++i]);
+        else if (std::strcmp(argv[i], "--threads") == 0 && hasValue) threads = std::atoi(argv[++i]);
+        else if (argv[i][0] == '-') {
+            std::fprintf(stderr, "usage: %s [--ticks N] [--seed S] [--threads N] [scenario...]\n", argv[0]);
+            return EXIT_FAILURE;
+        }
+        else paths.push_back(argv[i]);
+    }
+    if (paths.empty()) {
+        for (const char* name : CANONICAL_SCENARIOS) paths.push_back(std::string(BATTLE_SCENARIO_DIR) + "/" + name);
+    }
+
+    BattleJobSystem* jobs = threads > 0 ? new BattleJobSystem(threads) : nullptr;
+    int failures = 0;
+    for (const std::string& path : paths) {
+        Scenario scenario;
+        std::string error;
+        if (!loadScenario(path, scenario, error)) {
+            std::fprintf(stderr, "%s\n", error.c_str());
+            failures++;
+            continue;
+        }
+        if (ticks > 0) scenario.ticks = ticks;
+        if (seed >= 0) scenario.seed = static_cast<unsigned>(seed);
+        if (!runScenario(scenario, jobs)) failures++;
+    }
+    delete jobs;
+    return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -45,6 +45,14 @@ bool AirforceSoldier::init(BattleScene* battleScene, SoldierType type)
     return true;
 }
 
+/**
+ * @brief      析构函数：释放缓存的上下浮动动作
+ */
+AirforceSoldier::~AirforceSoldier()
+{
+    CC_SAFE_RELEASE_NULL(_floatAction);
+}
+
 /**
  * @brief      配置空军士兵的核心属性（重写父类虚函数）
  * @details    加载空军士兵（猫头鹰）的初始纹理，设置专属的生命值、攻击力、攻击范围、
@@ -58,14 +66,7 @@ void AirforceSoldier::setupProperties(SoldierType type)
     // 资源路径：Resources/anim/Owl1.png
     if (!this->initWithFile("anim/Owl1.png")) return;
 
-    // 配置空军士兵的核心属性值
-    _maxHp = 50;                // 最大生命值
-    _currentHp = _maxHp;         // 当前生命值初始化为最大生命值
-    _attackDamage = 6;          // 攻击伤害值
-    _attackRange = 80.0f;       // 攻击范围（近战范围，适配猫头鹰攻击逻辑）
-    _attackInterval = 1.0f;     // 攻击间隔（每秒1次攻击）
-    _moveSpeed = 80.0f;         // 飞行移动速度（像素/秒）
-
+    // 生命、攻击力、射程、移速等数值统一由 BattleRules::unitStats 提供（已在 Soldier::init 中读取 _maxHp）
     // 计算血条每一格对应的伤害值（血条分为5格）
     _damagePerNotch = _maxHp / 5;
     // 确保每格伤害值不小于1，避免低生命值时出现无效血条
@@ -74,43 +75,29 @@ void AirforceSoldier::setupProperties(SoldierType type)
 
 /**
  * @brief      播放空军士兵的飞行动画（重写父类虚函数，原父类为行走动画）
- * @details    1.  通过动作标签101判断是否已存在飞行动画，避免重复创建；
- *             2.  加载猫头鹰4帧飞行纹理，创建循环飞行动画；
- *             3.  添加上下浮动动作（标签102），增强飞行真实感；
- *             4.  两个动作均设置永久循环，标签用于后续精准停止
+ * @details    1.  运行兵种动画注册表中共享的猫头鹰4帧飞行动画（标签101），动作首次使用时创建并持有；
+ *             2.  运行上下浮动动作（标签102），增强飞行真实感，同样只创建一次并反复运行；
+ *             3.  两个动作均为永久循环，标签用于后续精准停止
  * @override   Soldier::playWalkAnim
  * @note       函数名保留`playWalkAnim`是为了兼容父类接口，实际功能为播放飞行动画
  */
 void AirforceSoldier::playWalkAnim()
 {
-    // 检查标签101对应的飞行动画是否已存在，存在则直接返回
-    if (this->getActionByTag(101)) return;
+    // 飞行动画帧由 TroopAnimationRegistry 共享，这里只重新运行缓存的循环动作
+    this->runTroopAnim(TroopAnimKind::WALK, 101);
 
-    // 创建飞行动画对象
-    auto animation = Animation::create();
-    // 循环加载4帧猫头鹰飞行纹理（Owl1.png ~ Owl4.png）
-    for (int i = 1; i <= 4; ++i) {
-        // 拼接每帧纹理的完整路径
-        std::string name = StringUtils::format("anim/Owl%d.png", i);
-        // 向动画对象中添加对应精灵帧
-        animation->addSpriteFrameWithFile(name);
+    // ========== 上下浮动动作，模拟飞行时的轻微晃动（只创建一次，之后复用） ==========
+    if (this->getActionByTag(102)) return;
+    if (!_floatAction) {
+        _floatAction = RepeatForever::create(Sequence::create(
+            MoveBy::create(0.5f, Vec2(0, 5)),  // 0.5秒向上移动5像素
+            MoveBy::create(0.5f, Vec2(0, -5)), // 0.5秒向下移动5像素
+            nullptr                            // 序列动作结束标记
+        ));
+        _floatAction->setTag(102); // 设置浮动动作标签102，用于后续停止
+        _floatAction->retain();
     }
-    // 设置动画每帧播放间隔（0.1秒/帧，模拟快速扇动翅膀）
-    animation->setDelayPerUnit(0.1f);
-
-    // 创建永久循环的飞行动画动作，并设置标签101
-    auto action = RepeatForever::create(Animate::create(animation));
-    action->setTag(101);
-    this->runAction(action);
-
-    // ========== 添加上下浮动动作，模拟飞行时的轻微晃动 ==========
-    auto floatAction = RepeatForever::create(Sequence::create(
-        MoveBy::create(0.5f, Vec2(0, 5)),  // 0.5秒向上移动5像素
-        MoveBy::create(0.5f, Vec2(0, -5)), // 0.5秒向下移动5像素
-        nullptr                            // 序列动作结束标记
-    ));
-    floatAction->setTag(102); // 设置浮动动作标签102，用于后续停止
-    this->runAction(floatAction);
+    this->runAction(_floatAction);
 }
 
 /**
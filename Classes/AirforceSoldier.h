@@ -36,6 +36,11 @@ public:
      */
     virtual bool init(BattleScene* battleScene, SoldierType type) override;
 
+    /**
+     * @brief      析构函数：释放缓存的上下浮动动作
+     */
+    virtual ~AirforceSoldier();
+
     /**
      * @brief      配置空军士兵的核心属性（重写父类虚函数）
      * @details    初始化空军士兵的精灵纹理，设置专属的最大生命值、攻击力、攻击范围、
@@ -47,7 +52,7 @@ public:
 
     /**
      * @brief      播放空军士兵的飞行动画（重写父类虚函数，原父类为行走动画）
-     * @details    创建并运行循环飞行动画，通过动作标签避免重复创建相同动画实例，
+     * @details    运行兵种动画注册表中共享的循环飞行动画与缓存的上下浮动动作，通过动作标签避免重复运行，
      *             动画帧来源于空军专属的纹理资源，与地面士兵行走动画区分
      * @override   Soldier::playWalkAnim
      * @note       函数名保留`playWalkAnim`是为了兼容父类接口，实际功能为播放飞行动画
@@ -76,12 +81,14 @@ public:
     /**
      * @brief      （可选）空军士兵攻击目标的特效逻辑（暂未启用，注释保留）
      * @details    若需要为空军士兵实现自定义攻击特效（如发射导弹、投掷炸弹等），
-     *             可取消该注释并实现具体逻辑；当前暂使用父类的近战攻击逻辑，无需额外修改
-     * @param      target       敌方建筑指针（EnemyBuilding*），指向被攻击的目标建筑
-     * @override   Soldier::attackTarget
+     *             可取消该注释并实现具体逻辑；当前暂使用父类的近战攻击反馈，无需额外修改
+     * @override   Soldier::playAttackEffect
      * @note       该函数为可选扩展接口，当前处于注释状态，不影响现有功能
      */
-     // virtual void attackTarget(EnemyBuilding* target) override; 
+     // virtual void playAttackEffect() override;
+
+private:
+    cocos2d::Action* _floatAction = nullptr; ///< 上下浮动循环动作（首次飞行时创建，之后复用）
 };
 
 #endif // AIRFORCE_SOLDIER_H_
\ No newline at end of file
@@ -24,6 +24,7 @@
 
 #include "AppDelegate.h"
 #include "HelloWorldScene.h"
+#include "BattleScene.h"
 
 // #define USE_AUDIO_ENGINE 1
 
@@ -118,6 +119,8 @@ bool AppDelegate::applicationDidFinishLaunching() {
 
 // This function will be called when the app is inactive. Note, when receiving a phone call it is invoked.
 void AppDelegate::applicationDidEnterBackground() {
+    // the process may be killed while in background, keep the running battle resumable
+    BattleScene::saveRunningCheckpoint();
     Director::getInstance()->stopAnimation();
 
 #if USE_AUDIO_ENGINE
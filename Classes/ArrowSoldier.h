@@ -2,11 +2,11 @@
  * @file       ArrowSoldier.h
  * @brief      弓箭士兵（ArrowSoldier）类的头文件定义
  * @details    该文件声明了弓箭士兵的核心接口与成员变量，弓箭士兵继承自基础士兵类（Soldier），
- *             核心特性是实现远程射箭攻击逻辑，同时重写了父类的初始化、属性配置、动画播放/停止
- *             等接口，具备地面行走能力和专属远程攻击特效（需在 cpp 文件中实现具体射箭逻辑）
+ *             核心特性是远程射箭攻击，同时重写了父类的初始化、属性配置、动画播放/停止
+ *             等接口，具备地面行走能力；射出的箭由战斗核心的弹道池模拟、BattleProjectileLayer 批量绘制
  * @version    1.0
  * @note       该类依赖 Soldier 基类、BattleScene 及 EnemyBuilding 相关头文件，使用前需确保依赖文件已引入；
- *             远程攻击的箭支特效、弹道逻辑需在对应 cpp 文件中实现，本头文件仅声明接口
+ *             行走动画等表现逻辑在对应 cpp 文件中实现，本头文件仅声明接口
  */
 #ifndef ARROW_SOLDIER_H_
 #define ARROW_SOLDIER_H_
@@ -16,9 +16,9 @@
  /**
   * @class      ArrowSoldier
   * @brief      弓箭士兵类，实现远程射箭攻击的核心逻辑
-  * @details    继承自 Soldier 基类，重写了父类的初始化、属性配置、行走动画播放/停止及攻击目标等虚函数，
-  *             作为远程地面单位，具备比近战单位更远的攻击范围，核心差异化在于`attackTarget`函数中
-  *             的远程射箭逻辑，行走动画依赖私有常量指定的纹理路径
+  * @details    继承自 Soldier 基类，重写了父类的初始化、属性配置、行走动画播放/停止等虚函数，
+  *             作为远程地面单位，具备比近战单位更远的攻击范围（由 BattleRules 属性表给出），
+  *             行走动画依赖私有常量指定的纹理路径
   * @extends    Soldier
   * @note       该类保护成员可被子类继承扩展，私有成员为行走动画基础路径，不可外部访问
   */
@@ -48,8 +48,8 @@ protected:
 
     /**
      * @brief      播放弓箭士兵的行走动画（重写父类虚函数）
-     * @details    根据私有常量指定的行走动画基础路径，加载并运行循环行走动画，
-     *             通过动作标签避免重复创建相同动画实例，适配弓箭士兵的地面移动特性
+     * @details    运行兵种动画注册表中共享的循环行走动画，
+     *             动作只创建一次并由士兵持有，通过动作标签避免重复运行，适配弓箭士兵的地面移动特性
      * @override   Soldier::playWalkAnim
      */
     virtual void playWalkAnim() override;
@@ -62,20 +62,11 @@ protected:
      */
     virtual void stopAnim() override;
 
-    /**
-     * @brief      弓箭士兵攻击目标的核心逻辑（重写父类虚函数）
-     * @details    实现远程射箭攻击的完整流程：创建箭支特效、计算弹道轨迹、
-     *             对敌方建筑造成远程伤害，是弓箭士兵与近战士兵的核心差异化接口
-     * @param      target       敌方建筑指针（EnemyBuilding*），指向被攻击的目标建筑，若为 nullptr 则不执行攻击逻辑
-     * @override   Soldier::attackTarget
-     */
-    virtual void attackTarget(EnemyBuilding* target) override;
-
 private:
     /**
      * @brief      行走动画的基础路径常量
      * @details    弓箭士兵行走动画帧的文件路径前缀，动画帧文件命名格式为 "anim/arrow1.png" ~ "anim/arrow4.png"（可根据实际帧数量调整），
-     *             该常量用于拼接完整的动画帧文件路径，方便加载行走动画纹理
+     *             该常量用于拼接初始纹理（第一帧）路径；行走动画帧登记在 TroopAnimationRegistry 的兵种动画表中
      */
     const std::string WALK_ANIM_BASE = "anim/arrow";
 };
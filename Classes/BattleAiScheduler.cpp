@@ -0,0 +1,120 @@
+/**
+ * @file       BattleAiScheduler.cpp
+ * @brief      单位 AI 分级思考与分帧寻靶的实现
+ * @version    1.0
+ */
+#include "BattleAiScheduler.h"
+#include <algorithm>
+#include <cmath>
+#include "BattleOccupancyMap.h"
+#include "BattleRules.h"
+#include "BattleWorld.h"
+
+BattleAiScheduler::BattleAiScheduler()
+    : _peakDeferred(0)
+{
+}
+
+void BattleAiScheduler::reset()
+{
+    _plans.clear();
+    _coastX.clear();
+    _coastY.clear();
+    _pending.clear();
+    _step = BattleAiStats();
+    _total = BattleAiStats();
+    _peakDeferred = 0;
+}
+
+void BattleAiScheduler::plan(const BattleUnitStore& units, const BattleBuildingStore& buildings,
+    const BattleOccupancyMap& occupancy, bool defendersActive, int step, float dt)
+{
+    const int count = static_cast<int>(units.size());
+    _plans.assign(count, THINK);
+    _coastX.resize(count);
+    _coastY.resize(count);
+    _pending.clear();
+    _step = BattleAiStats();
+
+    for (int i = 0; i < count; ++i) {
+        // 守军由 BattleWorld::updateDefenders 单独驱动，不参与规划
+        if (!units.alive[i] || units.team[i]) continue;
+
+        // 上一步与守军交战：目标是移动的单位，上一步的结论不能沿用；
+        // 守军已阵亡时同样要完整思考，此时的攻击状态是对守军的，对目标建筑未必在射程内
+        if (units.foe[i] != BATTLE_INVALID_INDEX) {
+            _step.thinks++;
+            continue;
+        }
+
+        const int t = units.target[i];
+        if (t == BATTLE_INVALID_INDEX || buildings.hp[t] <= 0 || buildings.destroyed[t]) {
+            _pending.push_back(i);
+            continue;
+        }
+
+        // 有守军时会交战的单位随时可能被守军接近，每步完整思考
+        if (defendersActive && BattleRules::fightsUnits(static_cast<SoldierType>(units.type[i]))) {
+            _step.thinks++;
+            continue;
+        }
+
+        // 稳定攻击：单位与目标都没有移动，射程 / 接触判定与上一步相同
+        const BattleUnitState state = static_cast<BattleUnitState>(units.state[i]);
+        if (state == BattleUnitState::ATTACKING) {
+            _plans[i] = KEEP_ATTACKING;
+            _step.attackHolds++;
+            continue;
+        }
+
+        // 远距离滑行：错峰相位之外沿上一步的方向前进
+        if (state == BattleUnitState::MOVING && (step + i) % BattleRules::AI_FAR_THINK_INTERVAL != 0) {
+            const float dx = units.x[i] - units.prevX[i];
+            const float dy = units.y[i] - units.prevY[i];
+            const float moved = std::sqrt(dx * dx + dy * dy);
+            const float tx = buildings.x[t] - units.x[i];
+            const float ty = buildings.y[t] - units.y[i];
+            const float dist = std::sqrt(tx * tx + ty * ty);
+            if (moved > 0.0f && dist - units.attackRange[i] > BattleRules::AI_FAR_DISTANCE) {
+                const float scale = units.moveSpeed[i] * dt / moved;
+                const float nx = units.x[i] + dx * scale;
+                const float ny = units.y[i] + dy * scale;
+                if (units.flying[i] || !occupancy.isBlocked(BattleVec2(nx, ny))) {
+                    _plans[i] = COAST;
+                    _coastX[i] = nx;
+                    _coastY[i] = ny;
+                    _step.coasts++;
+                    continue;
+                }
+            }
+        }
+        _step.thinks++;
+    }
+
+    // 分帧寻靶：从随步数轮转的起点开始，最多放行预算个，其余等待
+    const int pending = static_cast<int>(_pending.size());
+    if (pending > 0) {
+        const int budget = BattleRules::AI_RETARGET_BUDGET;
+        const int start = static_cast<int>(
+            std::lower_bound(_pending.begin(), _pending.end(),
+                static_cast<int>(static_cast<long long>(step) * budget % count)) - _pending.begin());
+        for (int k = 0; k < pending; ++k) {
+            const int i = _pending[(start + k) % pending];
+            if (k < budget) {
+                _step.retargets++;
+                _step.thinks++;
+            }
+            else {
+                _plans[i] = WAIT_TARGET;
+                _step.deferredRetargets++;
+            }
+        }
+    }
+
+    _total.thinks += _step.thinks;
+    _total.attackHolds += _step.attackHolds;
+    _total.coasts += _step.coasts;
+    _total.retargets += _step.retargets;
+    _total.deferredRetargets += _step.deferredRetargets;
+    _peakDeferred = std::max(_peakDeferred, _step.deferredRetargets);
+}
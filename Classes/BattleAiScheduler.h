@@ -0,0 +1,101 @@
+/**
+ * @file       BattleAiScheduler.h
+ * @brief      单位 AI 的分级思考（LOD）与分帧重新寻靶
+ * @details    每一步开始时按单位索引顺序为所有存活单位规划本步的处理方式：
+ *             1. 稳定攻击：上一步在攻击、目标仍存活的单位直接沿用攻击决策（单位与建筑都没有移动，
+ *                射程 / 接触判定的结果不会变化，与完整思考等价）；
+ *             2. 远距离滑行：离目标还很远、上一步在移动的单位只在错峰的相位上完整思考，
+ *                其余步沿上一步的方向继续前进，下一步被建筑阻挡时仍完整思考；
+ *             3. 分帧寻靶：目标失效的单位每步最多处理 BattleRules::AI_RETARGET_BUDGET 个，
+ *                超出的单位原地等待下一步，起点随步数轮转，避免大本营等建筑被摧毁的一瞬间
+ *                所有攻击它的士兵同时寻靶造成卡顿。
+ *             场上有守军时，正在与守军交战或可能与守军交战的单位不做上述简化，每步完整思考；
+ *             上一步与守军交战的单位即使守军已阵亡也要完整思考，它的攻击状态来自与守军的交战，不能当作稳定攻击。
+ *             规划只依赖快照中保存的状态（位置、上一步位置、状态、目标与步数），因此快照恢复与回放保持确定
+ * @version    1.0
+ * @note       该文件无引擎依赖；规划在单线程中完成，并行思考阶段只读取规划结果
+ */
+#ifndef BATTLE_AI_SCHEDULER_H_
+#define BATTLE_AI_SCHEDULER_H_
+
+#include <vector>
+#include "BattleTypes.h"
+
+struct BattleUnitStore;
+struct BattleBuildingStore;
+class BattleOccupancyMap;
+
+/**
+ * @struct     BattleAiStats
+ * @brief      AI 调度计数
+ */
+struct BattleAiStats {
+    int thinks;               ///< 完整思考的单位数
+    int attackHolds;          ///< 沿用攻击决策的单位数
+    int coasts;               ///< 沿上一步方向滑行的单位数
+    int retargets;            ///< 执行的重新寻靶次数
+    int deferredRetargets;    ///< 因预算用尽推迟的重新寻靶次数
+
+    BattleAiStats() : thinks(0), attackHolds(0), coasts(0), retargets(0), deferredRetargets(0) {}
+};
+
+/**
+ * @class      BattleAiScheduler
+ * @brief      每步的单位 AI 规划
+ */
+class BattleAiScheduler
+{
+public:
+    /// 单位本步的处理方式
+    enum Plan : uint8_t {
+        THINK = 0,          ///< 完整思考（含重新寻靶）
+        KEEP_ATTACKING,     ///< 沿用攻击决策
+        COAST,              ///< 沿上一步方向移动到 getCoastX/Y
+        WAIT_TARGET         ///< 本步寻靶预算已用尽，原地等待
+    };
+
+    BattleAiScheduler();
+
+    /// 清空规划与累计计数（载入关卡时调用）
+    void reset();
+
+    /**
+     * @brief      规划本步所有单位的处理方式
+     * @details    须在记录上一步位置（prevX/prevY）之前调用，此时 x - prevX 即上一步的位移
+     * @param      units      单位
+     * @param      buildings  建筑
+     * @param      occupancy  建筑占据栅格（陆军滑行的阻挡判定）
+     * @param      defendersActive  场上是否有存活的守军（有守军时会与守军交战的单位每步都完整思考）
+     * @param      step       本步序号（决定错峰相位与寻靶轮转起点）
+     * @param      dt         本步步长
+     */
+    void plan(const BattleUnitStore& units, const BattleBuildingStore& buildings,
+        const BattleOccupancyMap& occupancy, bool defendersActive, int step, float dt);
+
+    /// 单位本步的处理方式
+    Plan getPlan(int unit) const { return static_cast<Plan>(_plans[unit]); }
+
+    /// COAST：本步的新位置
+    float getCoastX(int unit) const { return _coastX[unit]; }
+    float getCoastY(int unit) const { return _coastY[unit]; }
+
+    /// 最近一步的计数
+    const BattleAiStats& getStepStats() const { return _step; }
+
+    /// 载入关卡以来的累计计数
+    const BattleAiStats& getTotalStats() const { return _total; }
+
+    /// 单步推迟寻靶数的峰值
+    int getPeakDeferred() const { return _peakDeferred; }
+
+private:
+    std::vector<uint8_t> _plans;     ///< 各单位本步的处理方式（Plan）
+    std::vector<float> _coastX;      ///< COAST 的新位置 X
+    std::vector<float> _coastY;      ///< COAST 的新位置 Y
+    std::vector<int> _pending;       ///< 本步需要重新寻靶的单位（按索引升序）
+    BattleAiStats _step;             ///< 最近一步的计数
+    BattleAiStats _total;            ///< 累计计数
+    int _peakDeferred;               ///< 单步推迟寻靶数的峰值
+};
+
+#endif // BATTLE_AI_SCHEDULER_H_
@@ -0,0 +1,104 @@
+/**
+ * @file       BattleAreaEffect.cpp
+ * @brief      范围效果区域与查询内核的实现
+ * @version    1.0
+ */
+#include "BattleAreaEffect.h"
+#include <algorithm>
+#include "BattleSimd.h"
+#include "BattleSpatialGrid.h"
+#include "BattleTargetIndex.h"
+
+// =========================================================
+// 1. 区域
+// =========================================================
+
+BattleArea BattleArea::circle(const BattleVec2& c, float r)
+{
+    BattleArea area;
+    area.shape = CIRCLE;
+    area.center = c;
+    area.radius = r;
+    return area;
+}
+
+BattleArea BattleArea::box(const BattleRect& r)
+{
+    BattleArea area;
+    area.shape = RECT;
+    area.rect = r;
+    area.center = r.center();
+    return area;
+}
+
+BattleRect BattleArea::bounds() const
+{
+    if (shape == RECT) return rect;
+    return BattleRect(center.x - radius, center.y - radius, radius * 2.0f, radius * 2.0f);
+}
+
+bool BattleArea::contains(float px, float py) const
+{
+    if (shape == RECT) return rect.containsPoint(px, py);
+    const float dx = px - center.x;
+    const float dy = py - center.y;
+    return dx * dx + dy * dy <= radius * radius;
+}
+
+bool BattleArea::overlaps(const BattleRect& r) const
+{
+    if (shape == RECT) return rect.intersects(r);
+    // 圆心到矩形的最近点
+    const float nx = std::min(std::max(center.x, r.minX()), r.maxX());
+    const float ny = std::min(std::max(center.y, r.minY()), r.maxY());
+    return contains(nx, ny);
+}
+
+// =========================================================
+// 2. 查询
+// =========================================================
+
+namespace BattleAreaEffect {
+
+int collectUnits(const BattleSpatialGrid& grid, const BattleArea& area, int layers, std::vector<int>& out)
+{
+    out.clear();
+    const BattleGridCellRange cells = grid.cellsInRect(area.bounds());
+    for (int layer = 0; layer < BattleSpatialGrid::LAYER_COUNT; ++layer) {
+        if (!(layers & (1 << layer))) continue;
+        for (int row = cells.minRow; row <= cells.maxRow; ++row) {
+            for (int col = cells.minCol; col <= cells.maxCol; ++col) {
+                const BattlePointList& bucket = grid.bucket(col, row, static_cast<BattleSpatialGrid::Layer>(layer));
+                const int count = bucket.size();
+                if (area.shape == BattleArea::RECT) {
+                    // 矩形区域（陷阱）走向量化的包含判定，一次比较 4 个坐标
+                    const float* xs = bucket.x.data();
+                    const float* ys = bucket.y.data();
+                    for (int k = BattleSimd::firstInRect(area.rect, xs, ys, 0, count); k < count;
+                        k = BattleSimd::firstInRect(area.rect, xs, ys, k + 1, count)) {
+                        out.push_back(bucket.ids[k]);
+                    }
+                    continue;
+                }
+                for (int k = 0; k < count; ++k) {
+                    if (area.contains(bucket.x[k], bucket.y[k])) out.push_back(bucket.ids[k]);
+                }
+            }
+        }
+    }
+    std::sort(out.begin(), out.end());
+    return static_cast<int>(out.size());
+}
+
+int collectBuildings(const BattleTargetIndex& index, const std::vector<BattleRect>& footprints,
+    const BattleArea& area, std::vector<int>& out)
+{
+    index.collectNear(area.bounds(), out);
+    out.erase(std::remove_if(out.begin(), out.end(), [&](int b) {
+        return !area.overlaps(footprints[b]);
+    }), out.end());
+    std::sort(out.begin(), out.end());
+    return static_cast<int>(out.size());
+}
+
+} // namespace BattleAreaEffect
@@ -0,0 +1,88 @@
+/**
+ * @file       BattleAreaEffect.h
+ * @brief      范围效果（AoE）的区域描述与查询内核
+ * @details    陷阱爆炸、炸弹人自爆与加农炮溅射共用同一套查询：
+ *             1. 区域为圆形或矩形（闭区间），单位按位置判定、建筑按占地矩形与区域是否相交判定；
+ *             2. 单位从 BattleSpatialGrid 中只取区域包围盒覆盖的格子，按层（地面 / 空中）过滤，
+ *                矩形区域逐格调用 BattleSimd::firstInRect 做向量化的包含判定；
+ *             3. 建筑从 BattleTargetIndex 中取包围盒附近格子里的存活建筑，再精确判定占地；
+ *             查询代价只与区域附近的实体数量有关，与全场兵力无关。结果按索引升序输出，与桶内顺序无关
+ * @version    1.0
+ * @note       该文件无引擎依赖；伤害由 BattleWorld 记入伤害队列，步末统一结算
+ */
+#ifndef BATTLE_AREA_EFFECT_H_
+#define BATTLE_AREA_EFFECT_H_
+
+#include <vector>
+#include "BattleTypes.h"
+
+class BattleSpatialGrid;
+class BattleTargetIndex;
+
+/**
+ * @enum       BattleAreaLayer
+ * @brief      范围效果作用的单位层（可按位组合）
+ */
+enum BattleAreaLayer {
+    BATTLE_AREA_GROUND = 1,                                    ///< 地面单位
+    BATTLE_AREA_AIR = 2,                                       ///< 空中单位
+    BATTLE_AREA_ALL = BATTLE_AREA_GROUND | BATTLE_AREA_AIR     ///< 全部单位
+};
+
+/**
+ * @struct     BattleArea
+ * @brief      范围效果的区域（圆形或矩形）
+ */
+struct BattleArea {
+    /// 区域形状
+    enum Shape : uint8_t {
+        CIRCLE = 0,     ///< 圆：center + radius
+        RECT            ///< 矩形：rect
+    };
+
+    Shape shape;
+    BattleVec2 center;   ///< CIRCLE：圆心
+    float radius;        ///< CIRCLE：半径
+    BattleRect rect;     ///< RECT：矩形
+
+    BattleArea() : shape(CIRCLE), radius(0.0f) {}
+
+    static BattleArea circle(const BattleVec2& c, float r);
+    static BattleArea box(const BattleRect& r);
+
+    /// 区域的轴对齐包围盒
+    BattleRect bounds() const;
+
+    /// 点是否在区域内（含边界）
+    bool contains(float px, float py) const;
+
+    /// 矩形（建筑占地）是否与区域相交（含边界接触）
+    bool overlaps(const BattleRect& r) const;
+};
+
+namespace BattleAreaEffect {
+
+/**
+ * @brief      收集区域内的存活单位
+ * @param      grid    存活单位的空间网格
+ * @param      area    区域
+ * @param      layers  作用层（BattleAreaLayer 的组合）
+ * @param      out     输出的单位索引（清空后按升序写入）
+ * @return     int     单位数量
+ */
+int collectUnits(const BattleSpatialGrid& grid, const BattleArea& area, int layers, std::vector<int>& out);
+
+/**
+ * @brief      收集占地与区域相交的存活建筑
+ * @param      index       存活建筑的寻靶索引
+ * @param      footprints  各建筑的占地矩形（下标为建筑索引）
+ * @param      area        区域
+ * @param      out         输出的建筑索引（清空后按升序写入）
+ * @return     int         建筑数量
+ */
+int collectBuildings(const BattleTargetIndex& index, const std::vector<BattleRect>& footprints,
+    const BattleArea& area, std::vector<int>& out);
+
+} // namespace BattleAreaEffect
+
+#endif // BATTLE_AREA_EFFECT_H_
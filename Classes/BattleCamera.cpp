@@ -0,0 +1,110 @@
+/**
+ * @file       BattleCamera.cpp
+ * @brief      战斗地图相机的实现
+ * @version    1.0
+ */
+#include "BattleCamera.h"
+#include <algorithm>
+
+USING_NS_CC;
+
+const float BattleCamera::ZOOM_STEP = 0.1f;
+const float BattleCamera::MAX_SCALE = 2.0f;
+
+BattleCamera::BattleCamera()
+    : _map(nullptr)
+    , _minScale(1.0f)
+    , _moved(true)
+{
+}
+
+void BattleCamera::attach(Node* map, float scale, const Vec2& focus)
+{
+    _map = map;
+    if (!_map) return;
+
+    const Size visibleSize = Director::getInstance()->getVisibleSize();
+    const Vec2 origin = Director::getInstance()->getVisibleOrigin();
+    const Size mapSize = _map->getContentSize();
+    const float fitScale = std::min(visibleSize.width / mapSize.width, visibleSize.height / mapSize.height);
+    _minScale = std::min(fitScale, scale);
+
+    _map->setAnchorPoint(Vec2::ZERO);
+    _map->setScale(scale);
+    _map->setPosition(origin + Vec2(visibleSize.width / 2, visibleSize.height / 2) - focus * scale);
+    clamp();
+}
+
+void BattleCamera::panBy(const Vec2& screenDelta)
+{
+    if (!_map) return;
+    _map->setPosition(_map->getPosition() + screenDelta);
+    clamp();
+}
+
+void BattleCamera::zoomBy(float steps)
+{
+    if (!_map) return;
+
+    const float oldScale = _map->getScale();
+    const float newScale = std::max(_minScale, std::min(MAX_SCALE, oldScale + steps * ZOOM_STEP));
+    if (newScale == oldScale) return;
+
+    // 屏幕中心对应的地图点在缩放前后保持不动
+    const Size visibleSize = Director::getInstance()->getVisibleSize();
+    const Vec2 center = Director::getInstance()->getVisibleOrigin() + Vec2(visibleSize.width / 2, visibleSize.height / 2);
+    const Vec2 focus = (center - _map->getPosition()) / oldScale;
+    _map->setScale(newScale);
+    _map->setPosition(center - focus * newScale);
+    clamp();
+}
+
+Rect BattleCamera::getViewRect(float margin) const
+{
+    return Rect(_viewRect.origin.x - margin, _viewRect.origin.y - margin,
+        _viewRect.size.width + margin * 2.0f, _viewRect.size.height + margin * 2.0f);
+}
+
+bool BattleCamera::consumeMoved()
+{
+    const bool moved = _moved;
+    _moved = false;
+    return moved;
+}
+
+float BattleCamera::getScale() const
+{
+    return _map ? _map->getScale() : 1.0f;
+}
+
+void BattleCamera::clamp()
+{
+    const Size visibleSize = Director::getInstance()->getVisibleSize();
+    const Vec2 origin = Director::getInstance()->getVisibleOrigin();
+    const float scale = _map->getScale();
+    const float mapWidth = _map->getContentSize().width * scale;
+    const float mapHeight = _map->getContentSize().height * scale;
+
+    // 地图比屏幕小的方向居中，否则限制在 [屏幕尺寸 - 地图尺寸, 0] 之间，不露出地图外的黑边
+    Vec2 pos = _map->getPosition();
+    if (mapWidth <= visibleSize.width) pos.x = origin.x + (visibleSize.width - mapWidth) / 2;
+    else pos.x = std::min(origin.x, std::max(origin.x + visibleSize.width - mapWidth, pos.x));
+    if (mapHeight <= visibleSize.height) pos.y = origin.y + (visibleSize.height - mapHeight) / 2;
+    else pos.y = std::min(origin.y, std::max(origin.y + visibleSize.height - mapHeight, pos.y));
+    _map->setPosition(pos);
+
+    updateViewRect();
+}
+
+void BattleCamera::updateViewRect()
+{
+    const Size visibleSize = Director::getInstance()->getVisibleSize();
+    const Vec2 origin = Director::getInstance()->getVisibleOrigin();
+    const float scale = _map->getScale();
+    const Vec2 bottomLeft = (origin - _map->getPosition()) / scale;
+    const Rect view(bottomLeft.x, bottomLeft.y, visibleSize.width / scale, visibleSize.height / scale);
+    if (!view.equals(_viewRect)) {
+        _viewRect = view;
+        _moved = true;
+    }
+}
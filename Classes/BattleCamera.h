@@ -0,0 +1,80 @@
+/**
+ * @file       BattleCamera.h
+ * @brief      战斗地图的相机（平移、缩放与视野矩形）
+ * @details    地图不再假设能在一屏内放下：相机直接控制地图节点的位置与缩放，
+ *             拖动平移、滚轮缩放（以屏幕中心为基准，手感与 GameScene::onMouseScroll 一致），
+ *             并把地图限制在屏幕内（地图比屏幕小的方向居中）。
+ *             相机同时给出当前视野在地图节点坐标系下的矩形，供表现层剔除视野外的精灵
+ * @version    1.0
+ * @note       地图节点的锚点须为 (0, 0)；相机只改变表现，不影响战斗核心
+ */
+#ifndef BATTLE_CAMERA_H_
+#define BATTLE_CAMERA_H_
+
+#include "cocos2d.h"
+
+/**
+ * @class      BattleCamera
+ * @brief      控制地图节点位置与缩放的相机
+ * @details    使用流程：载入地图后 attach() -> 触摸拖动调用 panBy()、滚轮调用 zoomBy()
+ *             -> 每帧读取 getViewRect()，consumeMoved() 为 true 时重新剔除静态精灵
+ */
+class BattleCamera
+{
+public:
+    /// 每格滚轮的缩放增量
+    static const float ZOOM_STEP;
+
+    /// 最大缩放
+    static const float MAX_SCALE;
+
+    BattleCamera();
+
+    /**
+     * @brief      绑定地图节点并设置初始缩放与焦点
+     * @details    最小缩放为整张地图完整显示的缩放（初始缩放更小时取初始缩放）
+     * @param      map    地图节点（锚点为 (0, 0)）
+     * @param      scale  初始缩放
+     * @param      focus  初始时位于屏幕中心的地图节点坐标（随后按边界修正）
+     */
+    void attach(cocos2d::Node* map, float scale, const cocos2d::Vec2& focus);
+
+    /**
+     * @brief      按屏幕位移平移地图
+     * @param      screenDelta  屏幕坐标系下的位移（触摸的 getDelta）
+     */
+    void panBy(const cocos2d::Vec2& screenDelta);
+
+    /**
+     * @brief      以屏幕中心为基准缩放
+     * @param      steps  缩放格数（正数放大，负数缩小）
+     */
+    void zoomBy(float steps);
+
+    /**
+     * @brief      当前视野在地图节点坐标系下的矩形
+     * @param      margin  向外扩展的边距（地图像素），覆盖精灵超出锚点的部分
+     * @return     cocos2d::Rect  视野矩形
+     */
+    cocos2d::Rect getViewRect(float margin = 0.0f) const;
+
+    /**
+     * @brief      自上次调用以来相机是否移动或缩放过（调用后清除标记）
+     * @return     bool  移动过返回 true；attach 之后的第一次调用总是返回 true
+     */
+    bool consumeMoved();
+
+    /// 当前缩放
+    float getScale() const;
+
+private:
+    void clamp();
+    void updateViewRect();
+
+    cocos2d::Node* _map;        ///< 地图节点（由场景持有）
+    float _minScale;            ///< 最小缩放（整张地图可见）
+    cocos2d::Rect _viewRect;    ///< 视野矩形（地图节点坐标）
+    bool _moved;                ///< 自上次 consumeMoved 以来是否移动过
+};
+
+#endif // BATTLE_CAMERA_H_
@@ -0,0 +1,105 @@
+/**
+ * @file       BattleCheckpointWriter.cpp
+ * @brief      续玩存档后台写盘的实现
+ * @version    1.0
+ */
+#include "BattleCheckpointWriter.h"
+#include <cstdio>
+
+BattleCheckpointWriter::BattleCheckpointWriter()
+    : _hasPending(false)
+    , _stop(false)
+{
+    _thread = std::thread(&BattleCheckpointWriter::run, this);
+}
+
+BattleCheckpointWriter::~BattleCheckpointWriter()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stop = true;
+    }
+    _wake.notify_one();
+    if (_thread.joinable()) _thread.join();
+}
+
+void BattleCheckpointWriter::post(const std::string& path, std::vector<uint8_t>& bytes)
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _pending.swap(bytes);
+        _pendingPath = path;
+        _hasPending = true;
+    }
+    _wake.notify_one();
+}
+
+bool BattleCheckpointWriter::writeNow(const std::string& path, const std::vector<uint8_t>& bytes)
+{
+    std::lock_guard<std::mutex> fileLock(_fileMutex);
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _hasPending = false;
+    }
+    return writeFile(path, bytes);
+}
+
+void BattleCheckpointWriter::discard(const std::string& path)
+{
+    std::lock_guard<std::mutex> fileLock(_fileMutex);
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _hasPending = false;
+    }
+    std::remove(path.c_str());
+}
+
+void BattleCheckpointWriter::run()
+{
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _wake.wait(lock, [this] { return _hasPending || _stop; });
+            if (!_hasPending) return;
+        }
+
+        // 先取得写盘锁再取数据：等待期间若被 discard / writeNow 丢弃，这里就不再写出旧数据
+        std::lock_guard<std::mutex> fileLock(_fileMutex);
+        std::string path;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (!_hasPending) continue;
+            _writing.swap(_pending);
+            path.swap(_pendingPath);
+            _hasPending = false;
+        }
+        writeFile(path, _writing);
+    }
+}
+
+/**
+ * @brief      写入存档文件
+ * @details    先写临时文件再改名，写到一半时进程被回收也不会留下残缺的存档
+ */
+bool BattleCheckpointWriter::writeFile(const std::string& path, const std::vector<uint8_t>& bytes)
+{
+    const std::string temp = path + ".tmp";
+    FILE* file = std::fopen(temp.c_str(), "wb");
+    if (!file) return false;
+    const bool written = std::fwrite(bytes.data(), 1, bytes.size(), file) == bytes.size();
+    const bool closed = std::fclose(file) == 0;
+    if (!written || !closed) {
+        std::remove(temp.c_str());
+        return false;
+    }
+
+    // Windows 上 rename 不会覆盖已存在的文件
+    if (std::rename(temp.c_str(), path.c_str()) != 0) {
+        std::remove(path.c_str());
+        if (std::rename(temp.c_str(), path.c_str()) != 0) {
+            std::remove(temp.c_str());
+            return false;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,70 @@
+/**
+ * @file       BattleCheckpointWriter.h
+ * @brief      续玩存档的后台写盘
+ * @details    战斗中每隔一段时间写一次续玩存档，同步写盘在移动设备的存储上可能耗时数毫秒甚至更久，
+ *             不能放在渲染线程的帧循环里。帧内只截取快照并序列化到缓冲区，再把字节交给本类的后台线程写盘；
+ *             后台线程只保留最新的一份待写数据，写盘跟不上时旧数据直接被新数据替换
+ * @version    1.0
+ * @note       该文件无引擎依赖。删除存档与同步写入都会先丢弃待写数据，并与后台写盘互斥，
+ *             因此删除之后不会再被一份较早提交的数据重新写出文件
+ */
+#ifndef BATTLE_CHECKPOINT_WRITER_H_
+#define BATTLE_CHECKPOINT_WRITER_H_
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @class      BattleCheckpointWriter
+ * @brief      单线程的续玩存档写盘器
+ * @details    使用流程：帧内 post() 提交（立即返回）；切到后台时 writeNow() 同步写入；
+ *             战斗结束时 discard() 删除存档。析构时写完最后一份待写数据再退出
+ */
+class BattleCheckpointWriter
+{
+public:
+    BattleCheckpointWriter();
+    ~BattleCheckpointWriter();
+
+    /**
+     * @brief      提交一份待写数据（后台写盘，立即返回）
+     * @details    与 bytes 交换内容而非复制，bytes 换回上一份数据的缓冲区，调用方可继续复用其容量
+     * @param      path   存档路径
+     * @param      bytes  存档内容（调用后内容不确定）
+     */
+    void post(const std::string& path, std::vector<uint8_t>& bytes);
+
+    /**
+     * @brief      丢弃待写数据并立即同步写入
+     * @return     bool  写入成功返回 true
+     */
+    bool writeNow(const std::string& path, const std::vector<uint8_t>& bytes);
+
+    /**
+     * @brief      丢弃待写数据并删除存档文件
+     */
+    void discard(const std::string& path);
+
+private:
+    BattleCheckpointWriter(const BattleCheckpointWriter&);
+    BattleCheckpointWriter& operator=(const BattleCheckpointWriter&);
+
+    void run();
+    static bool writeFile(const std::string& path, const std::vector<uint8_t>& bytes);
+
+    std::mutex _fileMutex;              ///< 写盘与删除互斥（先于 _mutex 加锁）
+    std::mutex _mutex;                  ///< 保护待写数据与退出标志
+    std::condition_variable _wake;      ///< 有待写数据或需要退出时唤醒后台线程
+    std::string _pendingPath;           ///< 待写数据的路径
+    std::vector<uint8_t> _pending;      ///< 待写数据
+    std::vector<uint8_t> _writing;      ///< 后台线程正在写的数据（与 _pending 交换复用）
+    bool _hasPending;                   ///< 是否有待写数据
+    bool _stop;                         ///< 退出标志
+    std::thread _thread;                ///< 后台写盘线程
+};
+
+#endif // BATTLE_CHECKPOINT_WRITER_H_
@@ -0,0 +1,45 @@
+/**
+ * @file       BattleClock.cpp
+ * @brief      固定步长时钟的实现
+ * @version    1.0
+ */
+#include "BattleClock.h"
+
+BattleClock::BattleClock(float stepSeconds, int maxStepsPerFrame)
+    : _step(stepSeconds > 0.0f ? stepSeconds : BattleRules::SIMULATION_STEP)
+    , _maxStepsPerFrame(maxStepsPerFrame > 0 ? maxStepsPerFrame : 1)
+    , _speed(1.0f)
+    , _accumulator(0.0f)
+    , _ticks(0)
+{
+}
+
+void BattleClock::reset(int tickCount)
+{
+    _accumulator = 0.0f;
+    _ticks = tickCount > 0 ? tickCount : 0;
+}
+
+void BattleClock::setSpeed(float speed)
+{
+    if (speed > 0.0f) _speed = speed;
+}
+
+int BattleClock::advance(float frameSeconds)
+{
+    if (frameSeconds > 0.0f) _accumulator += frameSeconds * _speed;
+
+    int steps = static_cast<int>(_accumulator / _step);
+    if (steps > _maxStepsPerFrame) {
+        // 追不上时丢弃积压的时间（表现为短暂减速），避免后续帧越追越多
+        steps = _maxStepsPerFrame;
+        _accumulator = 0.0f;
+    }
+    else {
+        _accumulator -= steps * _step;
+        if (_accumulator < 0.0f) _accumulator = 0.0f;
+    }
+
+    _ticks += steps;
+    return steps;
+}
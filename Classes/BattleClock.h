@@ -0,0 +1,63 @@
+/**
+ * @file       BattleClock.h
+ * @brief      战斗模拟的固定步长时钟
+ * @details    表现层每帧把真实帧间隔交给时钟，时钟按倍速累积模拟时间，并换算成本帧需要推进的
+ *             固定步数；BattleWorld 每次只以固定步长推进，因此战斗结果与帧率、倍速都无关。
+ *             累积剩余的不足一步的时间以插值系数给出，表现层据此在上一步与当前步之间插值绘制
+ * @version    1.0
+ * @note       该文件无引擎依赖；单帧步数设有上限，卡顿时宁可放慢模拟也不让追帧越积越多
+ */
+#ifndef BATTLE_CLOCK_H_
+#define BATTLE_CLOCK_H_
+
+#include "BattleRules.h"
+
+/**
+ * @class      BattleClock
+ * @brief      固定步长 + 倍速 + 插值系数
+ */
+class BattleClock
+{
+public:
+    /**
+     * @param      stepSeconds        每一步的模拟时长（秒）
+     * @param      maxStepsPerFrame   单帧最多推进的步数
+     */
+    explicit BattleClock(float stepSeconds = BattleRules::SIMULATION_STEP,
+        int maxStepsPerFrame = BattleRules::MAX_STEPS_PER_FRAME);
+
+    /**
+     * @brief      清空累积时间并把步数计数设为 tickCount（倍速保持不变）
+     * @param      tickCount  起始步数（录像从中途开始回放时为快进到的步数）
+     */
+    void reset(int tickCount = 0);
+
+    /**
+     * @brief      累积一帧真实时间
+     * @param      frameSeconds  真实帧间隔（秒）
+     * @return     int           本帧需要调用 BattleWorld::step(getStep()) 的次数
+     */
+    int advance(float frameSeconds);
+
+    /// 设置倍速（1 / 2 / 4 ...，小于等于 0 的值忽略）
+    void setSpeed(float speed);
+    float getSpeed() const { return _speed; }
+
+    /// 每一步的模拟时长（秒）
+    float getStep() const { return _step; }
+
+    /// 插值系数 [0, 1)：累积但尚未推进的时间占一步的比例
+    float getAlpha() const { return _accumulator / _step; }
+
+    /// 已推进的总步数（含 reset 时给定的起始步数）
+    int getTickCount() const { return _ticks; }
+
+private:
+    float _step;             ///< 固定步长
+    int _maxStepsPerFrame;   ///< 单帧步数上限
+    float _speed;            ///< 倍速
+    float _accumulator;      ///< 尚未推进的模拟时间
+    int _ticks;              ///< 已推进的总步数
+};
+
+#endif // BATTLE_CLOCK_H_
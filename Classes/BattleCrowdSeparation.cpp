@@ -0,0 +1,199 @@
+/**
+ * @file       BattleCrowdSeparation.cpp
+ * @brief      密集兵群局部分离转向的实现
+ * @version    1.0
+ */
+#include "BattleCrowdSeparation.h"
+#include <algorithm>
+#include <cmath>
+#include "BattleOccupancyMap.h"
+#include "BattleRules.h"
+#include "BattleWorld.h"
+
+namespace {
+
+/// 黄金角（弧度）：完全重合的单位按各自索引的黄金角方向错开，任意两个单位的方向都不相同
+const float GOLDEN_ANGLE = 2.39996323f;
+
+/// 推力小于该值（像素）时视为没有重叠
+const float MIN_PUSH = 0.01f;
+
+bool isMover(const BattleUnitStore& units, int i)
+{
+    return units.alive[i] && units.state[i] == static_cast<uint8_t>(BattleUnitState::MOVING);
+}
+
+} // namespace
+
+BattleCrowdSeparation::BattleCrowdSeparation()
+    : _cellSize(BattleRules::SEPARATION_CELL_SIZE)
+    , _cols(1)
+    , _rows(1)
+    , _cursor(0)
+{
+}
+
+void BattleCrowdSeparation::reset(float width, float height)
+{
+    _cellSize = BattleRules::SEPARATION_CELL_SIZE;
+    _cols = std::max(1, static_cast<int>(std::ceil(width / _cellSize)));
+    _rows = std::max(1, static_cast<int>(std::ceil(height / _cellSize)));
+    _cellStart.assign(static_cast<size_t>(_cols) * _rows * 2 + 1, 0);
+    _cellUnits.clear();
+    _cellX.clear();
+    _cellY.clear();
+    _unitCell.clear();
+    _moveUnits.clear();
+    _moveX.clear();
+    _moveY.clear();
+    _cursor = 0;
+    _step = BattleSeparationStats();
+    _total = BattleSeparationStats();
+}
+
+int BattleCrowdSeparation::cellOf(float x, float y) const
+{
+    // 超出地图的单位钳制到边缘格子，与 BattleSpatialGrid 一致
+    int col = std::min(std::max(static_cast<int>(std::floor(x / _cellSize)), 0), _cols - 1);
+    int row = std::min(std::max(static_cast<int>(std::floor(y / _cellSize)), 0), _rows - 1);
+    return row * _cols + col;
+}
+
+void BattleCrowdSeparation::buildGrid(const BattleUnitStore& units)
+{
+    // 计数排序：统计各桶数量 -> 前缀和得到起点 -> 按单位索引顺序填充（桶内按索引升序）
+    const int count = static_cast<int>(units.size());
+    const int buckets = _cols * _rows * 2;
+    std::fill(_cellStart.begin(), _cellStart.end(), 0);
+    _unitCell.assign(count, BATTLE_INVALID_INDEX);
+
+    int total = 0;
+    for (int i = 0; i < count; ++i) {
+        if (!units.alive[i]) continue;
+        const int cell = cellOf(units.x[i], units.y[i]);
+        _unitCell[i] = cell;
+        _cellStart[cell * 2 + units.flying[i] + 1]++;
+        total++;
+    }
+    for (int b = 0; b < buckets; ++b) _cellStart[b + 1] += _cellStart[b];
+
+    _cellUnits.resize(total);
+    _cellX.resize(total);
+    _cellY.resize(total);
+    for (int i = 0; i < count; ++i) {
+        if (_unitCell[i] == BATTLE_INVALID_INDEX) continue;
+        const int slot = _cellStart[_unitCell[i] * 2 + units.flying[i]]++;
+        _cellUnits[slot] = i;
+        _cellX[slot] = units.x[i];
+        _cellY[slot] = units.y[i];
+    }
+
+    // 填充后每个起点都前移到了下一个桶的起点，整体右移一位复原
+    for (int b = buckets; b > 0; --b) _cellStart[b] = _cellStart[b - 1];
+    _cellStart[0] = 0;
+}
+
+void BattleCrowdSeparation::accumulate(const BattleUnitStore& units, int i, int cell, float& pushX, float& pushY)
+{
+    const int layer = units.flying[i];
+    const int col = cell % _cols;
+    const int row = cell / _cols;
+    const float x = units.x[i];
+    const float y = units.y[i];
+    const float half = units.halfSize[i];
+
+    for (int r = std::max(row - 1, 0); r <= std::min(row + 1, _rows - 1); ++r) {
+        for (int c = std::max(col - 1, 0); c <= std::min(col + 1, _cols - 1); ++c) {
+            const int bucket = (r * _cols + c) * 2 + layer;
+            for (int k = _cellStart[bucket]; k < _cellStart[bucket + 1]; ++k) {
+                const int j = _cellUnits[k];
+                if (j == i) continue;
+                _step.pairChecks++;
+
+                const float spacing = (half + units.halfSize[j]) * BattleRules::SEPARATION_SPACING_SCALE;
+                const float dx = x - _cellX[k];
+                const float dy = y - _cellY[k];
+                const float d2 = dx * dx + dy * dy;
+                if (d2 >= spacing * spacing) continue;
+
+                const float d = std::sqrt(d2);
+                if (d > MIN_PUSH) {
+                    const float overlap = (spacing - d) / d;
+                    pushX += dx * overlap;
+                    pushY += dy * overlap;
+                }
+                else {
+                    // 完全重合：两者沿各自黄金角方向之差反向错开（对 i、j 反对称）
+                    const float ax = std::cos(i * GOLDEN_ANGLE) - std::cos(j * GOLDEN_ANGLE);
+                    const float ay = std::sin(i * GOLDEN_ANGLE) - std::sin(j * GOLDEN_ANGLE);
+                    const float len = std::sqrt(ax * ax + ay * ay);
+                    if (len > 0.0f) {
+                        pushX += ax / len * spacing;
+                        pushY += ay / len * spacing;
+                    }
+                }
+            }
+        }
+    }
+}
+
+void BattleCrowdSeparation::solve(const BattleUnitStore& units, const BattleOccupancyMap& occupancy, float dt)
+{
+    _moveUnits.clear();
+    _moveX.clear();
+    _moveY.clear();
+    _step = BattleSeparationStats();
+
+    const int count = static_cast<int>(units.size());
+    bool anyMover = false;
+    for (int i = 0; i < count && !anyMover; ++i) anyMover = isMover(units, i);
+    if (!anyMover) return;
+
+    buildGrid(units);
+
+    // 从上一步中断处开始轮转处理；预算用尽后记录下一步的起点
+    if (_cursor < 0 || _cursor >= count) _cursor = 0;
+    const float maxStep = BattleRules::SEPARATION_MAX_SPEED * dt;
+    int resume = BATTLE_INVALID_INDEX;
+    for (int k = 0; k < count; ++k) {
+        const int i = (_cursor + k) % count;
+        if (!isMover(units, i)) continue;
+        if (_step.pairChecks >= BattleRules::SEPARATION_PAIR_BUDGET) {
+            if (resume == BATTLE_INVALID_INDEX) resume = i;
+            _step.skipped++;
+            continue;
+        }
+        _step.movers++;
+
+        float pushX = 0.0f;
+        float pushY = 0.0f;
+        accumulate(units, i, _unitCell[i], pushX, pushY);
+        pushX *= BattleRules::SEPARATION_STIFFNESS;
+        pushY *= BattleRules::SEPARATION_STIFFNESS;
+
+        float len = std::sqrt(pushX * pushX + pushY * pushY);
+        if (len < MIN_PUSH) continue;
+        if (len > maxStep) {
+            pushX *= maxStep / len;
+            pushY *= maxStep / len;
+        }
+
+        const float nx = units.x[i] + pushX;
+        const float ny = units.y[i] + pushY;
+        if (!units.flying[i] && occupancy.isBlocked(BattleVec2(nx, ny))) {
+            _step.blocked++;
+            continue;
+        }
+        _moveUnits.push_back(i);
+        _moveX.push_back(nx);
+        _moveY.push_back(ny);
+        _step.pushes++;
+    }
+    if (resume != BATTLE_INVALID_INDEX) _cursor = resume;
+
+    _total.movers += _step.movers;
+    _total.pairChecks += _step.pairChecks;
+    _total.pushes += _step.pushes;
+    _total.blocked += _step.blocked;
+    _total.skipped += _step.skipped;
+}
@@ -0,0 +1,103 @@
+/**
+ * @file       BattleCrowdSeparation.h
+ * @brief      密集兵群的局部分离转向
+ * @details    原先士兵之间互不感知，同一点投放的几十个士兵会重叠在同一个像素上成团移动。
+ *             每步单位 AI 之后，对处于移动状态的单位按与邻居的重叠量计算一个远离邻居的推力：
+ *             1. 邻居网格：每步按层（地面 / 空中）把存活单位计数排序进一个瓦片大小的紧凑网格，
+ *                每个单位只检查周围 3x3 个格子，代替 O(n²) 的两两检查；
+ *             2. 推力全部基于本步开始分离前的位置计算，再统一写回，结果与处理顺序无关；
+ *             3. 每步检查的单位对数有预算（BattleRules::SEPARATION_PAIR_BUDGET），超出后剩余单位
+ *                顺延到下一步，下一步从中断处继续；
+ *             4. 陆军被推入建筑时放弃本步的推力，阻挡判定与 BattleWorld::isPositionBlocked 一致。
+ *             正在攻击的单位只作为邻居参与计算、自身不被推动，保证其射程 / 接触判定不变
+ * @version    1.0
+ * @note       该文件无引擎依赖；求解在单线程中完成，推入建筑与完全重合等边界情况的处理都是确定的
+ */
+#ifndef BATTLE_CROWD_SEPARATION_H_
+#define BATTLE_CROWD_SEPARATION_H_
+
+#include <vector>
+#include "BattleTypes.h"
+
+struct BattleUnitStore;
+class BattleOccupancyMap;
+
+/**
+ * @struct     BattleSeparationStats
+ * @brief      分离转向计数
+ */
+struct BattleSeparationStats {
+    int movers;        ///< 参与分离的移动单位数
+    int pairChecks;    ///< 检查的单位对数
+    int pushes;        ///< 被推动的单位数
+    int blocked;       ///< 推力会进入建筑而被放弃的单位数
+    int skipped;       ///< 因预算用尽顺延到下一步的单位数
+
+    BattleSeparationStats() : movers(0), pairChecks(0), pushes(0), blocked(0), skipped(0) {}
+};
+
+/**
+ * @class      BattleCrowdSeparation
+ * @brief      基于邻居网格的分离转向求解器
+ * @details    使用流程：reset(地图尺寸) -> 每步 solve() -> 按 getMoveCount() 逐个读取并应用新位置
+ */
+class BattleCrowdSeparation
+{
+public:
+    BattleCrowdSeparation();
+
+    /**
+     * @brief      按地图尺寸重建邻居网格并清空游标与计数（载入关卡时调用）
+     * @param      width   地图宽度（像素）
+     * @param      height  地图高度（像素）
+     */
+    void reset(float width, float height);
+
+    /**
+     * @brief      计算本步的分离位移
+     * @param      units      单位（只读）
+     * @param      occupancy  建筑占据栅格（陆军的阻挡判定）
+     * @param      dt         本步步长
+     */
+    void solve(const BattleUnitStore& units, const BattleOccupancyMap& occupancy, float dt);
+
+    /// 本步需要移动的单位数
+    int getMoveCount() const { return static_cast<int>(_moveUnits.size()); }
+
+    /// 第 k 个需要移动的单位及其新位置（各单位的新位置互不依赖，应用顺序不影响结果）
+    int getMoveUnit(int k) const { return _moveUnits[k]; }
+    float getMoveX(int k) const { return _moveX[k]; }
+    float getMoveY(int k) const { return _moveY[k]; }
+
+    /// 下一步开始处理的单位索引（预算用尽时的中断位置，快照保存）
+    int getCursor() const { return _cursor; }
+    void setCursor(int cursor) { _cursor = cursor; }
+
+    /// 最近一步的计数
+    const BattleSeparationStats& getStepStats() const { return _step; }
+
+    /// 载入关卡以来的累计计数
+    const BattleSeparationStats& getTotalStats() const { return _total; }
+
+private:
+    void buildGrid(const BattleUnitStore& units);
+    int cellOf(float x, float y) const;
+    void accumulate(const BattleUnitStore& units, int i, int cell, float& pushX, float& pushY);
+
+    float _cellSize;                  ///< 邻居网格的格子边长
+    int _cols;                        ///< 列数
+    int _rows;                        ///< 行数
+    std::vector<int> _cellStart;      ///< 各桶在 _cellUnits 中的起点（桶 = 格子 * 2 + 层，末尾为总数）
+    std::vector<int> _cellUnits;      ///< 按桶排列的单位索引
+    std::vector<float> _cellX;        ///< 按桶排列的单位位置 X
+    std::vector<float> _cellY;        ///< 按桶排列的单位位置 Y
+    std::vector<int> _unitCell;       ///< 各单位所在格子（未入网格为 -1）
+    std::vector<int> _moveUnits;      ///< 本步需要移动的单位
+    std::vector<float> _moveX;        ///< 新位置 X
+    std::vector<float> _moveY;        ///< 新位置 Y
+    int _cursor;                      ///< 下一步开始处理的单位索引
+    BattleSeparationStats _step;      ///< 最近一步的计数
+    BattleSeparationStats _total;     ///< 累计计数
+};
+
+#endif // BATTLE_CROWD_SEPARATION_H_
@@ -0,0 +1,64 @@
+/**
+ * @file       BattleDamageQueue.cpp
+ * @brief      单步伤害队列的实现
+ * @version    1.0
+ */
+#include "BattleDamageQueue.h"
+
+BattleDamageQueue::BattleDamageQueue()
+    : _hits(0)
+{
+}
+
+void BattleDamageQueue::reset(int buildingCount)
+{
+    const size_t count = buildingCount > 0 ? static_cast<size_t>(buildingCount) : 0;
+    _buildingDamage.assign(count, 0);
+    _buildingHit.assign(count, 0);
+    _unitDamage.clear();
+    _unitHit.clear();
+    _buildings.clear();
+    _units.clear();
+    _hits = 0;
+}
+
+void BattleDamageQueue::addBuildingDamage(int building, int damage)
+{
+    if (building < 0 || static_cast<size_t>(building) >= _buildingDamage.size()) return;
+    if (!_buildingHit[building]) {
+        _buildingHit[building] = 1;
+        _buildings.push_back(building);
+    }
+    _buildingDamage[building] += damage;
+    _hits++;
+}
+
+void BattleDamageQueue::addUnitDamage(int unit, int damage)
+{
+    if (unit < 0) return;
+    if (static_cast<size_t>(unit) >= _unitDamage.size()) {
+        _unitDamage.resize(unit + 1, 0);
+        _unitHit.resize(unit + 1, 0);
+    }
+    if (!_unitHit[unit]) {
+        _unitHit[unit] = 1;
+        _units.push_back(unit);
+    }
+    _unitDamage[unit] += damage;
+    _hits++;
+}
+
+void BattleDamageQueue::clear()
+{
+    for (int b : _buildings) {
+        _buildingDamage[b] = 0;
+        _buildingHit[b] = 0;
+    }
+    for (int u : _units) {
+        _unitDamage[u] = 0;
+        _unitHit[u] = 0;
+    }
+    _buildings.clear();
+    _units.clear();
+    _hits = 0;
+}
@@ -0,0 +1,72 @@
+/**
+ * @file       BattleDamageQueue.h
+ * @brief      单步伤害队列（延迟结算）
+ * @details    近战攻击、自爆、箭 / 炮弹命中与陷阱爆炸在模拟过程中只把伤害记入队列，不立即修改血量；
+ *             BattleWorld 在每一步的末尾统一结算：同一实体在本步内的多次命中先累加为一次伤害，
+ *             每座建筑本步最多产生一条受击事件与一条摧毁事件，表现层的血条因此每步最多刷新一次。
+ *             结算期间不会有其他系统遍历建筑或单位，彻底避免“遍历途中建筑被摧毁”的顺序问题。
+ *             唯一的例外是自爆单位本身：爆炸伤害照常入队，但单位在引爆时即阵亡，不经过队列
+ * @version    1.0
+ * @note       该文件无引擎依赖；结算顺序为首次命中的顺序（建筑在前、单位在后），与线程数无关，保证确定性。
+ *             队列在每一步结束时清空，因此不进入战斗快照
+ */
+#ifndef BATTLE_DAMAGE_QUEUE_H_
+#define BATTLE_DAMAGE_QUEUE_H_
+
+#include <vector>
+#include "BattleTypes.h"
+
+/**
+ * @class      BattleDamageQueue
+ * @brief      按实体累加的本步伤害
+ * @details    每类实体一个累加数组（下标为实体索引）加一个“首次命中顺序”列表；
+ *             记录与清空都只触及本步被命中的实体，缓冲区在战斗中复用
+ */
+class BattleDamageQueue
+{
+public:
+    BattleDamageQueue();
+
+    /**
+     * @brief      清空队列并按建筑数量预分配（载入关卡时调用）
+     */
+    void reset(int buildingCount);
+
+    /// 对建筑记入一次伤害
+    void addBuildingDamage(int building, int damage);
+
+    /// 对单位记入一次伤害（单位数量随投放增长，按需扩容）
+    void addUnitDamage(int unit, int damage);
+
+    /// 本步是否没有任何伤害
+    bool empty() const { return _buildings.empty() && _units.empty(); }
+
+    /// 本步受到伤害的建筑（按首次命中顺序）
+    const std::vector<int>& damagedBuildings() const { return _buildings; }
+
+    /// 本步受到伤害的单位（按首次命中顺序）
+    const std::vector<int>& damagedUnits() const { return _units; }
+
+    /// 建筑本步累计伤害
+    int getBuildingDamage(int building) const { return _buildingDamage[building]; }
+
+    /// 单位本步累计伤害
+    int getUnitDamage(int unit) const { return _unitDamage[unit]; }
+
+    /// 本步记入的命中次数（合并前）
+    int getHitCount() const { return _hits; }
+
+    /// 结算完成后清空（只重置本步被命中的实体）
+    void clear();
+
+private:
+    std::vector<int> _buildingDamage;   ///< 建筑累计伤害（下标为建筑索引）
+    std::vector<int> _unitDamage;       ///< 单位累计伤害（下标为单位索引）
+    std::vector<uint8_t> _buildingHit;  ///< 建筑本步是否已登记
+    std::vector<uint8_t> _unitHit;      ///< 单位本步是否已登记
+    std::vector<int> _buildings;        ///< 首次命中顺序的建筑列表
+    std::vector<int> _units;            ///< 首次命中顺序的单位列表
+    int _hits;                          ///< 本步命中次数
+};
+
+#endif // BATTLE_DAMAGE_QUEUE_H_
@@ -0,0 +1,110 @@
+/**
+ * @file       BattleDeployMask.cpp
+ * @brief      投放合法性掩码的实现
+ * @version    1.0
+ */
+#include "BattleDeployMask.h"
+#include <algorithm>
+
+BattleDeployMask::BattleDeployMask()
+    : _cols(0)
+    , _rows(0)
+    , _tileWidth(32.0f)
+    , _tileHeight(32.0f)
+    , _halfExtent(0.0f)
+    , _forbiddenTileCount(0)
+{
+}
+
+void BattleDeployMask::build(const BattleLevelDesc& level, float halfExtent)
+{
+    _tileWidth = level.tileWidth > 0.0f ? level.tileWidth : 32.0f;
+    _tileHeight = level.tileHeight > 0.0f ? level.tileHeight : 32.0f;
+    _cols = std::max(0, static_cast<int>(std::ceil(level.mapWidth / _tileWidth)));
+    _rows = std::max(0, static_cast<int>(std::ceil(level.mapHeight / _tileHeight)));
+    _halfExtent = halfExtent;
+    const int tileCount = _cols * _rows;
+    const size_t wordCount = (static_cast<size_t>(tileCount) + 31) / 32;
+
+    _rects = level.forbiddenRects;
+    _forbiddenBits.assign(wordCount, 0u);
+    _partialBits.assign(wordCount, 0u);
+    _partial.assign(tileCount, std::vector<int>());
+    _outside.clear();
+    _forbiddenTileCount = 0;
+
+    const float mapW = _cols * _tileWidth;
+    const float mapH = _rows * _tileHeight;
+    for (size_t r = 0; r < _rects.size(); ++r) {
+        // 扩张后的禁止区域：投放点落在其中（含边界）即与判定方块相交
+        const float minX = _rects[r].minX() - halfExtent;
+        const float maxX = _rects[r].maxX() + halfExtent;
+        const float minY = _rects[r].minY() - halfExtent;
+        const float maxY = _rects[r].maxY() + halfExtent;
+
+        if (minX < 0.0f || minY < 0.0f || maxX >= mapW || maxY >= mapH) {
+            _outside.push_back(static_cast<int>(r));
+        }
+        if (tileCount == 0) continue;
+
+        int minCol = std::max(0, static_cast<int>(std::floor(minX / _tileWidth)));
+        int maxCol = std::min(_cols - 1, static_cast<int>(std::floor(maxX / _tileWidth)));
+        int minRow = std::max(0, static_cast<int>(std::floor(minY / _tileHeight)));
+        int maxRow = std::min(_rows - 1, static_cast<int>(std::floor(maxY / _tileHeight)));
+
+        for (int row = minRow; row <= maxRow; ++row) {
+            float y0 = row * _tileHeight;
+            bool fullY = minY <= y0 && y0 + _tileHeight <= maxY;
+            for (int col = minCol; col <= maxCol; ++col) {
+                int tile = row * _cols + col;
+                if (testBit(_forbiddenBits, tile)) continue;
+
+                float x0 = col * _tileWidth;
+                bool fullX = minX <= x0 && x0 + _tileWidth <= maxX;
+                if (fullX && fullY) {
+                    // 整块禁止后部分禁止列表不再需要
+                    setBit(_forbiddenBits, tile);
+                    std::vector<int>().swap(_partial[tile]);
+                    _forbiddenTileCount++;
+                }
+                else {
+                    setBit(_partialBits, tile);
+                    _partial[tile].push_back(static_cast<int>(r));
+                }
+            }
+        }
+    }
+}
+
+int BattleDeployMask::tileOf(const BattleVec2& pos) const
+{
+    if (pos.x < 0.0f || pos.y < 0.0f) return BATTLE_INVALID_INDEX;
+    int col = static_cast<int>(pos.x / _tileWidth);
+    int row = static_cast<int>(pos.y / _tileHeight);
+    if (col >= _cols || row >= _rows) return BATTLE_INVALID_INDEX;
+    return row * _cols + col;
+}
+
+bool BattleDeployMask::hitsRect(int rect, const BattleVec2& pos) const
+{
+    // 与原判定相同：判定方块与禁止区域相交（含边界）
+    const float e = _halfExtent;
+    BattleRect probe(pos.x - e, pos.y - e, e * 2.0f, e * 2.0f);
+    return _rects[rect].intersects(probe);
+}
+
+bool BattleDeployMask::canDeployAt(const BattleVec2& pos) const
+{
+    int tile = tileOf(pos);
+    const std::vector<int>* candidates = &_outside;
+    if (tile != BATTLE_INVALID_INDEX) {
+        if (testBit(_forbiddenBits, tile)) return false;
+        if (!testBit(_partialBits, tile)) return true;
+        candidates = &_partial[tile];
+    }
+
+    for (int r : *candidates) {
+        if (hitsRect(r, pos)) return false;
+    }
+    return true;
+}
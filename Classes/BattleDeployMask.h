@@ -0,0 +1,67 @@
+/**
+ * @file       BattleDeployMask.h
+ * @brief      士兵投放合法性的瓦片位掩码
+ * @details    投放判定为“以投放点为中心、边长 2 * DEPLOY_HALF_EXTENT 的方块不与任何禁止区域相交”，
+ *             等价于“投放点不落在任何向外扩张 DEPLOY_HALF_EXTENT 的禁止区域内”。
+ *             载入关卡时把扩张后的禁止区域一次性光栅化到瓦片网格，每个瓦片用两个位表示：
+ *             整块禁止（直接判定非法）与部分禁止（只检查与该瓦片相交的少数禁止区域），
+ *             其余瓦片直接判定合法。结果与逐个禁止区域做相交测试完全一致
+ * @version    1.0
+ * @note       禁止区域在一局中不会变化，掩码只在载入关卡时构建一次
+ */
+#ifndef BATTLE_DEPLOY_MASK_H_
+#define BATTLE_DEPLOY_MASK_H_
+
+#include <vector>
+#include "BattleTypes.h"
+
+/**
+ * @class      BattleDeployMask
+ * @brief      按瓦片烘焙的投放合法性掩码
+ */
+class BattleDeployMask
+{
+public:
+    BattleDeployMask();
+
+    /**
+     * @brief      根据关卡禁止区域构建掩码
+     * @param      level       关卡描述（地图尺寸、瓦片尺寸、禁止区域）
+     * @param      halfExtent  投放判定方块的半边长
+     */
+    void build(const BattleLevelDesc& level, float halfExtent);
+
+    /**
+     * @brief      判定地图节点坐标是否可以投放士兵
+     */
+    bool canDeployAt(const BattleVec2& pos) const;
+
+    /// 整块禁止的瓦片数量（调试 / 统计用）
+    int getForbiddenTileCount() const { return _forbiddenTileCount; }
+
+private:
+    int tileOf(const BattleVec2& pos) const;
+    bool hitsRect(int rect, const BattleVec2& pos) const;
+
+    static bool testBit(const std::vector<uint32_t>& bits, int index) {
+        return (bits[index >> 5] >> (index & 31)) & 1u;
+    }
+    static void setBit(std::vector<uint32_t>& bits, int index) {
+        bits[index >> 5] |= 1u << (index & 31);
+    }
+
+    int _cols;                                 ///< 瓦片列数
+    int _rows;                                 ///< 瓦片行数
+    float _tileWidth;                          ///< 瓦片宽
+    float _tileHeight;                         ///< 瓦片高
+    float _halfExtent;                         ///< 投放判定方块的半边长
+    int _forbiddenTileCount;                   ///< 整块禁止的瓦片数量
+
+    std::vector<BattleRect> _rects;            ///< 禁止区域（未扩张）
+    std::vector<uint32_t> _forbiddenBits;      ///< 整块禁止位
+    std::vector<uint32_t> _partialBits;        ///< 部分禁止位
+    std::vector<std::vector<int>> _partial;    ///< 部分禁止瓦片上需要检查的禁止区域
+    std::vector<int> _outside;                 ///< 扩张后超出地图范围的禁止区域（地图外的点逐个检查）
+};
+
+#endif // BATTLE_DEPLOY_MASK_H_
@@ -0,0 +1,295 @@
+/**
+ * @file       BattleFlowField.cpp
+ * @brief      陆军共享流场的实现
+ * @version    1.0
+ */
+#include "BattleFlowField.h"
+#include "BattleRules.h"
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <utility>
+
+namespace {
+
+const float FLOW_INF = std::numeric_limits<float>::infinity();
+const float DIAGONAL_STEP = 1.41421356f;
+
+// 8 邻居：先正交后对角，距离相同时按该顺序取第一个，保证结果确定
+const int NEIGHBOR_DC[8] = { 1, -1, 0, 0, 1, -1, 1, -1 };
+const int NEIGHBOR_DR[8] = { 0, 0, 1, -1, 1, 1, -1, -1 };
+
+} // namespace
+
+BattleFlowFieldCache::BattleFlowFieldCache()
+    : _cols(0)
+    , _rows(0)
+    , _tileWidth(32.0f)
+    , _tileHeight(32.0f)
+    , _fieldCount(0)
+{
+}
+
+void BattleFlowFieldCache::build(const BattleLevelDesc& level)
+{
+    _tileWidth = level.tileWidth > 0.0f ? level.tileWidth : 32.0f;
+    _tileHeight = level.tileHeight > 0.0f ? level.tileHeight : 32.0f;
+    _cols = static_cast<int>(std::ceil(level.mapWidth / _tileWidth));
+    _rows = static_cast<int>(std::ceil(level.mapHeight / _tileHeight));
+    if (_cols < 0) _cols = 0;
+    if (_rows < 0) _rows = 0;
+    const int tileCount = _cols * _rows;
+
+    _buildings = level.buildings;
+    _destroyed.assign(_buildings.size(), 0);
+    _buildingTiles.assign(_buildings.size(), std::vector<int>());
+    _tileBuildings.assign(tileCount, std::vector<int>());
+    _cost.assign(tileCount, 1.0f);
+    _wallAt.assign(tileCount, BATTLE_INVALID_INDEX);
+    _fields.assign(_buildings.size(), Field());
+    _fieldCount = 0;
+
+    for (size_t b = 0; b < _buildings.size(); ++b) {
+        if (_buildings[b].hp <= 0) _destroyed[b] = 1;
+        tilesOf(_buildings[b].footprint, _buildingTiles[b]);
+        for (int tile : _buildingTiles[b]) _tileBuildings[tile].push_back(static_cast<int>(b));
+    }
+    for (int tile = 0; tile < tileCount; ++tile) {
+        _cost[tile] = computeTileCost(tile);
+        for (int b : _tileBuildings[tile]) {
+            if (!_destroyed[b] && _buildings[b].type == EnemyType::WALL) {
+                _wallAt[tile] = b;
+                break;
+            }
+        }
+    }
+}
+
+// =========================================================
+// 瓦片工具
+// =========================================================
+
+int BattleFlowFieldCache::tileOf(const BattleVec2& pos) const
+{
+    if (pos.x < 0.0f || pos.y < 0.0f) return BATTLE_INVALID_INDEX;
+    int col = static_cast<int>(pos.x / _tileWidth);
+    int row = static_cast<int>(pos.y / _tileHeight);
+    if (col >= _cols || row >= _rows) return BATTLE_INVALID_INDEX;
+    return row * _cols + col;
+}
+
+BattleVec2 BattleFlowFieldCache::tileCenter(int tile) const
+{
+    int col = tile % _cols;
+    int row = tile / _cols;
+    return BattleVec2((col + 0.5f) * _tileWidth, (row + 0.5f) * _tileHeight);
+}
+
+bool BattleFlowFieldCache::tileOverlaps(int col, int row, const BattleRect& rect) const
+{
+    // 严格相交：仅边缘相接的瓦片不算被占据
+    float x0 = col * _tileWidth;
+    float y0 = row * _tileHeight;
+    return x0 < rect.maxX() && x0 + _tileWidth > rect.minX()
+        && y0 < rect.maxY() && y0 + _tileHeight > rect.minY();
+}
+
+void BattleFlowFieldCache::tilesOf(const BattleRect& rect, std::vector<int>& out) const
+{
+    out.clear();
+    if (_cols == 0 || _rows == 0) return;
+    int minCol = std::max(0, static_cast<int>(std::floor(rect.minX() / _tileWidth)));
+    int maxCol = std::min(_cols - 1, static_cast<int>(std::floor(rect.maxX() / _tileWidth)));
+    int minRow = std::max(0, static_cast<int>(std::floor(rect.minY() / _tileHeight)));
+    int maxRow = std::min(_rows - 1, static_cast<int>(std::floor(rect.maxY() / _tileHeight)));
+    for (int row = minRow; row <= maxRow; ++row) {
+        for (int col = minCol; col <= maxCol; ++col) {
+            if (tileOverlaps(col, row, rect)) out.push_back(row * _cols + col);
+        }
+    }
+}
+
+float BattleFlowFieldCache::computeTileCost(int tile) const
+{
+    float cost = 1.0f;
+    for (int b : _tileBuildings[tile]) {
+        if (_destroyed[b]) continue;
+        if (_buildings[b].type != EnemyType::WALL) return FLOW_INF;
+        // 围墙可通行，但代价随血量增加（相当于需要先把它打穿）
+        cost = std::max(cost, 1.0f + _buildings[b].hp * BattleRules::WALL_PATH_COST_PER_HP);
+    }
+    return cost;
+}
+
+bool BattleFlowFieldCache::canStepDiagonal(int from, int dc, int dr) const
+{
+    // 不允许斜穿被建筑占据的拐角
+    int col = from % _cols;
+    int row = from / _cols;
+    return _cost[row * _cols + col + dc] < FLOW_INF && _cost[(row + dr) * _cols + col] < FLOW_INF;
+}
+
+// =========================================================
+// 流场构建与增量更新
+// =========================================================
+
+void BattleFlowFieldCache::buildField(int target)
+{
+    const int tileCount = _cols * _rows;
+    Field& field = _fields[target];
+    field.assign(tileCount, FLOW_INF);
+
+    std::vector<int>& seeds = _seeds;
+    seeds.assign(_buildingTiles[target].begin(), _buildingTiles[target].end());
+    if (seeds.empty()) {
+        int tile = tileOf(_buildings[target].position);
+        if (tile != BATTLE_INVALID_INDEX) seeds.push_back(tile);
+    }
+    for (int tile : seeds) field[tile] = 0.0f;
+
+    relax(field, seeds);
+    _fieldCount++;
+}
+
+void BattleFlowFieldCache::relax(Field& field, const std::vector<int>& seeds)
+{
+    // 以成员数组作小顶堆（与 std::priority_queue 的出堆顺序相同），容量在流场之间复用
+    std::vector<OpenEntry>& open = _open;
+    const std::greater<OpenEntry> later;
+    open.clear();
+    for (int tile : seeds) {
+        if (field[tile] < FLOW_INF) {
+            open.push_back(OpenEntry(field[tile], tile));
+            std::push_heap(open.begin(), open.end(), later);
+        }
+    }
+
+    while (!open.empty()) {
+        std::pop_heap(open.begin(), open.end(), later);
+        OpenEntry top = open.back();
+        open.pop_back();
+        int tile = top.second;
+        if (top.first > field[tile]) continue;
+
+        // 邻居 -> 当前瓦片：进入当前瓦片的代价（目标瓦片视为代价 1）
+        float enterCost = field[tile] == 0.0f ? 1.0f : _cost[tile];
+        if (enterCost >= FLOW_INF) continue;
+
+        int col = tile % _cols;
+        int row = tile / _cols;
+        for (int k = 0; k < 8; ++k) {
+            int nc = col + NEIGHBOR_DC[k];
+            int nr = row + NEIGHBOR_DR[k];
+            if (nc < 0 || nr < 0 || nc >= _cols || nr >= _rows) continue;
+            int neighbor = nr * _cols + nc;
+
+            bool diagonal = k >= 4;
+            if (diagonal && !canStepDiagonal(neighbor, -NEIGHBOR_DC[k], -NEIGHBOR_DR[k])) continue;
+
+            float candidate = field[tile] + enterCost * (diagonal ? DIAGONAL_STEP : 1.0f);
+            if (candidate < field[neighbor]) {
+                field[neighbor] = candidate;
+                open.push_back(OpenEntry(candidate, neighbor));
+                std::push_heap(open.begin(), open.end(), later);
+            }
+        }
+    }
+}
+
+void BattleFlowFieldCache::onBuildingDestroyed(int building)
+{
+    if (building < 0 || static_cast<size_t>(building) >= _buildings.size() || _destroyed[building]) return;
+    _destroyed[building] = 1;
+
+    // 目标自身的流场不再需要（清空即视为未构建，保留容量供复用的世界再次构建）
+    if (!_fields[building].empty()) {
+        _fields[building].clear();
+        _fieldCount--;
+    }
+
+    // 更新被释放瓦片的代价与围墙归属
+    const std::vector<int>& changed = _buildingTiles[building];
+    for (int tile : changed) {
+        _cost[tile] = computeTileCost(tile);
+        _wallAt[tile] = BATTLE_INVALID_INDEX;
+        for (int b : _tileBuildings[tile]) {
+            if (!_destroyed[b] && _buildings[b].type == EnemyType::WALL) {
+                _wallAt[tile] = b;
+                break;
+            }
+        }
+    }
+    if (changed.empty() || _fieldCount == 0) return;
+
+    // 代价只会降低：以变化瓦片及其邻居（可能新开放了斜向通行）为种子做增量松弛
+    std::vector<int>& seeds = _seeds;
+    seeds.clear();
+    for (int tile : changed) {
+        int col = tile % _cols;
+        int row = tile / _cols;
+        seeds.push_back(tile);
+        for (int k = 0; k < 8; ++k) {
+            int nc = col + NEIGHBOR_DC[k];
+            int nr = row + NEIGHBOR_DR[k];
+            if (nc >= 0 && nr >= 0 && nc < _cols && nr < _rows) seeds.push_back(nr * _cols + nc);
+        }
+    }
+    for (Field& field : _fields) {
+        if (!field.empty()) relax(field, seeds);
+    }
+}
+
+// =========================================================
+// 查询
+// =========================================================
+
+BattleFlowStep BattleFlowFieldCache::nextStep(int target, const BattleVec2& pos)
+{
+    BattleFlowStep step;
+    if (!peekStep(target, pos, step)) {
+        buildField(target);
+        peekStep(target, pos, step);
+    }
+    return step;
+}
+
+bool BattleFlowFieldCache::peekStep(int target, const BattleVec2& pos, BattleFlowStep& step) const
+{
+    step.valid = false;
+    step.wall = BATTLE_INVALID_INDEX;
+    if (target < 0 || static_cast<size_t>(target) >= _buildings.size() || _destroyed[target]) return true;
+
+    int tile = tileOf(pos);
+    if (tile == BATTLE_INVALID_INDEX) return true;
+
+    if (_fields[target].empty()) return false;
+    const Field& field = _fields[target];
+    if (field[tile] == 0.0f) return true;
+
+    int col = tile % _cols;
+    int row = tile / _cols;
+    int best = BATTLE_INVALID_INDEX;
+    float bestValue = FLOW_INF;
+    for (int k = 0; k < 8; ++k) {
+        int nc = col + NEIGHBOR_DC[k];
+        int nr = row + NEIGHBOR_DR[k];
+        if (nc < 0 || nr < 0 || nc >= _cols || nr >= _rows) continue;
+        int neighbor = nr * _cols + nc;
+
+        bool diagonal = k >= 4;
+        if (diagonal && !canStepDiagonal(tile, NEIGHBOR_DC[k], NEIGHBOR_DR[k])) continue;
+
+        float enterCost = field[neighbor] == 0.0f ? 1.0f : _cost[neighbor];
+        float value = field[neighbor] + enterCost * (diagonal ? DIAGONAL_STEP : 1.0f);
+        if (value < bestValue) {
+            bestValue = value;
+            best = neighbor;
+        }
+    }
+    if (best == BATTLE_INVALID_INDEX || bestValue >= FLOW_INF) return true;
+
+    step.valid = true;
+    step.waypoint = tileCenter(best);
+    if (field[best] != 0.0f) step.wall = _wallAt[best];
+    return true;
+}
@@ -0,0 +1,109 @@
+/**
+ * @file       BattleFlowField.h
+ * @brief      陆军寻路使用的共享流场
+ * @details    在 TMX 瓦片网格上为每个被攻击的目标建筑计算一张距离场（多源 Dijkstra，源点为目标占据的瓦片），
+ *             朝同一目标前进的所有士兵共享同一张场：每个士兵每帧只需查看所在瓦片的 8 个邻居，
+ *             朝距离最小的邻居瓦片中心移动。
+ *             瓦片代价：空地为 1；被未摧毁建筑占据的瓦片不可进入；围墙可以进入但代价随围墙血量增加，
+ *             因此士兵会绕开厚墙、必要时选择最薄弱的围墙突破
+ * @version    1.0
+ * @note       距离场按需惰性构建并缓存；建筑被摧毁时只会让瓦片代价降低，
+ *             因此只需从变化瓦片的邻居出发做一次“只减不增”的增量松弛，而不必重建整张场
+ */
+#ifndef BATTLE_FLOW_FIELD_H_
+#define BATTLE_FLOW_FIELD_H_
+
+#include <utility>
+#include <vector>
+#include "BattleTypes.h"
+
+/**
+ * @struct     BattleFlowStep
+ * @brief      流场给出的下一步
+ */
+struct BattleFlowStep {
+    bool valid;              ///< false 表示没有可用路径、位于地图外或已到达目标瓦片，按直线移动
+    BattleVec2 waypoint;     ///< 下一个瓦片的中心（地图节点坐标）
+    int wall;                ///< 下一个瓦片被存活围墙占据时的围墙建筑索引，否则为 BATTLE_INVALID_INDEX
+};
+
+/**
+ * @class      BattleFlowFieldCache
+ * @brief      按目标建筑缓存的流场集合
+ */
+class BattleFlowFieldCache
+{
+public:
+    BattleFlowFieldCache();
+
+    /**
+     * @brief      根据关卡描述构建瓦片代价，清空所有已缓存的流场
+     * @param      level  关卡描述（地图尺寸、瓦片尺寸、建筑）
+     */
+    void build(const BattleLevelDesc& level);
+
+    /**
+     * @brief      建筑被摧毁：更新其占据瓦片的代价，并对已缓存的流场做增量松弛
+     * @param      building  被摧毁的建筑索引（重复调用无效果）
+     */
+    void onBuildingDestroyed(int building);
+
+    /**
+     * @brief      查询朝目标建筑前进的下一步
+     * @details    目标对应的流场不存在时先构建；所在瓦片无法到达目标时返回无效结果
+     * @param      target  目标建筑索引
+     * @param      pos     士兵当前位置
+     * @return     BattleFlowStep  下一步
+     */
+    BattleFlowStep nextStep(int target, const BattleVec2& pos);
+
+    /**
+     * @brief      只读查询下一步（不构建流场，可在多个线程中并发调用）
+     * @param      target  目标建筑索引
+     * @param      pos     士兵当前位置
+     * @param      step    查询结果，与 nextStep 相同
+     * @return     bool    目标的流场尚未构建、需要先调用 nextStep 时返回 false（此时 step 无效）
+     */
+    bool peekStep(int target, const BattleVec2& pos, BattleFlowStep& step) const;
+
+    /// 当前缓存的流场数量
+    int getFieldCount() const { return _fieldCount; }
+
+    /// 瓦片网格列数 / 行数
+    int getColumnCount() const { return _cols; }
+    int getRowCount() const { return _rows; }
+
+private:
+    typedef std::vector<float> Field;
+    typedef std::pair<float, int> OpenEntry;   ///< 松弛队列项：距离、瓦片
+
+    int tileOf(const BattleVec2& pos) const;
+    BattleVec2 tileCenter(int tile) const;
+    bool tileOverlaps(int col, int row, const BattleRect& rect) const;
+    void tilesOf(const BattleRect& rect, std::vector<int>& out) const;
+    float computeTileCost(int tile) const;
+    bool canStepDiagonal(int from, int dc, int dr) const;
+
+    void buildField(int target);
+    void relax(Field& field, const std::vector<int>& seeds);
+
+    int _cols;                                   ///< 瓦片列数
+    int _rows;                                   ///< 瓦片行数
+    float _tileWidth;                            ///< 瓦片宽
+    float _tileHeight;                           ///< 瓦片高
+
+    std::vector<BattleBuildingDesc> _buildings;  ///< 建筑描述（下标为建筑索引）
+    std::vector<uint8_t> _destroyed;             ///< 建筑是否已被摧毁
+    std::vector<std::vector<int>> _buildingTiles;///< 建筑占据的瓦片
+    std::vector<std::vector<int>> _tileBuildings;///< 瓦片上的建筑
+    std::vector<float> _cost;                    ///< 进入瓦片的代价（无穷大表示不可进入）
+    std::vector<int> _wallAt;                    ///< 瓦片上的存活围墙索引
+
+    std::vector<Field> _fields;                  ///< 目标建筑索引 -> 距离场（空表示尚未构建）
+    int _fieldCount;                             ///< 已构建的流场数量
+
+    std::vector<int> _seeds;                     ///< 松弛种子（临时，复用容量）
+    std::vector<OpenEntry> _open;                ///< 松弛用的小顶堆（临时，复用容量）
+};
+
+#endif // BATTLE_FLOW_FIELD_H_
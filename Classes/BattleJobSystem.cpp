@@ -0,0 +1,180 @@
+/**
+ * @file       BattleJobSystem.cpp
+ * @brief      工作窃取任务系统的实现
+ * @version    1.0
+ */
+#include "BattleJobSystem.h"
+#include <algorithm>
+
+namespace {
+
+/// 当前线程所属的任务系统与队列下标（工作线程启动时设置，外部线程为空）
+thread_local const BattleJobSystem* t_owner = nullptr;
+thread_local int t_queue = -1;
+
+} // namespace
+
+BattleJobSystem::BattleJobSystem(int workerCount)
+    : _queued(0)
+    , _nextQueue(0)
+    , _stop(false)
+{
+    if (workerCount < 0) {
+        int hardware = static_cast<int>(std::thread::hardware_concurrency());
+        workerCount = std::max(0, hardware - 1);
+    }
+
+    // 最后一个队列留给外部线程（工作线程为 0 时外部提交直接执行，不会用到）
+    for (int i = 0; i <= workerCount; ++i) _queues.emplace_back(new Queue());
+    _threads.reserve(workerCount);
+    for (int i = 0; i < workerCount; ++i) {
+        _threads.emplace_back(&BattleJobSystem::workerLoop, this, i);
+    }
+}
+
+BattleJobSystem::~BattleJobSystem()
+{
+    {
+        std::lock_guard<std::mutex> lock(_sleepMutex);
+        _stop.store(true);
+    }
+    _wake.notify_all();
+    for (std::thread& thread : _threads) thread.join();
+}
+
+BattleJobSystem* BattleJobSystem::getInstance()
+{
+    static BattleJobSystem instance;
+    return &instance;
+}
+
+// =========================================================
+// 提交与等待
+// =========================================================
+
+int BattleJobSystem::currentQueue() const
+{
+    return t_owner == this ? t_queue : static_cast<int>(_threads.size());
+}
+
+void BattleJobSystem::submit(BattleJobGroup& group, const Job& job)
+{
+    group._pending.fetch_add(1, std::memory_order_relaxed);
+    Task task;
+    task.job = job;
+    task.group = &group;
+
+    if (_threads.empty()) {
+        run(task);
+        return;
+    }
+
+    // 工作线程压入自己的队列；外部线程轮流分发，让每个工作线程一开始就有活可干
+    int queue = currentQueue();
+    if (queue == static_cast<int>(_threads.size())) {
+        queue = static_cast<int>(_nextQueue.fetch_add(1, std::memory_order_relaxed) % _threads.size());
+    }
+    push(queue, task);
+}
+
+void BattleJobSystem::wait(BattleJobGroup& group)
+{
+    const int queue = currentQueue();
+    while (group.isBusy()) {
+        if (!tryRunOne(queue)) std::this_thread::yield();
+    }
+}
+
+void BattleJobSystem::parallelFor(int count, int grain, const RangeJob& fn)
+{
+    if (count <= 0) return;
+    grain = std::max(1, grain);
+    const int maxChunks = getThreadCount() * 4;
+    const int chunks = std::min((count + grain - 1) / grain, maxChunks);
+    if (_threads.empty() || chunks <= 1) {
+        fn(0, count);
+        return;
+    }
+
+    const int chunkSize = (count + chunks - 1) / chunks;
+    BattleJobGroup group;
+    for (int begin = 0; begin < count; begin += chunkSize) {
+        const int end = std::min(count, begin + chunkSize);
+        submit(group, [&fn, begin, end]() { fn(begin, end); });
+    }
+    wait(group);
+}
+
+// =========================================================
+// 队列操作
+// =========================================================
+
+void BattleJobSystem::push(int queue, const Task& task)
+{
+    {
+        std::lock_guard<std::mutex> lock(_queues[queue]->mutex);
+        _queues[queue]->tasks.push_back(task);
+    }
+    _queued.fetch_add(1, std::memory_order_release);
+
+    // 先获取再释放休眠锁，保证不会错过正在进入等待的线程
+    { std::lock_guard<std::mutex> lock(_sleepMutex); }
+    _wake.notify_one();
+}
+
+bool BattleJobSystem::popOwn(int queue, Task& out)
+{
+    Queue& q = *_queues[queue];
+    std::lock_guard<std::mutex> lock(q.mutex);
+    if (q.tasks.empty()) return false;
+    out = q.tasks.back();
+    q.tasks.pop_back();
+    _queued.fetch_sub(1, std::memory_order_relaxed);
+    return true;
+}
+
+bool BattleJobSystem::steal(int thief, Task& out)
+{
+    const int count = static_cast<int>(_queues.size());
+    for (int k = 1; k < count; ++k) {
+        Queue& q = *_queues[(thief + k) % count];
+        std::lock_guard<std::mutex> lock(q.mutex);
+        if (q.tasks.empty()) continue;
+        out = q.tasks.front();
+        q.tasks.pop_front();
+        _queued.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+    return false;
+}
+
+bool BattleJobSystem::tryRunOne(int queue)
+{
+    Task task;
+    if (!popOwn(queue, task) && !steal(queue, task)) return false;
+    run(task);
+    return true;
+}
+
+void BattleJobSystem::run(Task& task)
+{
+    task.job();
+    task.group->_pending.fetch_sub(1, std::memory_order_acq_rel);
+}
+
+// =========================================================
+// 工作线程
+// =========================================================
+
+void BattleJobSystem::workerLoop(int index)
+{
+    t_owner = this;
+    t_queue = index;
+
+    while (!_stop.load()) {
+        if (tryRunOne(index)) continue;
+
+        std::unique_lock<std::mutex> lock(_sleepMutex);
+        _wake.wait(lock, [this]() { return _stop.load() || _queued.load(std::memory_order_acquire) > 0; });
+    }
+}
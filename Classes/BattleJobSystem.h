@@ -0,0 +1,136 @@
+/**
+ * @file       BattleJobSystem.h
+ * @brief      工作窃取（work-stealing）任务系统
+ * @details    每个工作线程持有一个双端任务队列：本线程从队尾压入 / 取出（后进先出，缓存友好），
+ *             空闲线程从其他队列的队首窃取（先进先出，优先拿走较大的剩余工作）。
+ *             外部线程提交的任务轮流分发到各队列；等待任务组完成的线程不会阻塞空转，而是一起执行任务。
+ *             战斗核心用 parallelFor 把单位 / 防御建筑的“思考”阶段切成若干块并行计算，
+ *             再由调用线程按索引顺序应用结果，保证与单线程结果逐位一致
+ * @version    1.0
+ * @note       该文件无引擎依赖，只使用 C++11 标准线程库；任务内不得抛出异常。
+ *             工作线程数为 0 时所有任务都在调用线程上直接执行，行为与单线程完全相同
+ */
+#ifndef BATTLE_JOB_SYSTEM_H_
+#define BATTLE_JOB_SYSTEM_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @class      BattleJobGroup
+ * @brief      一组任务的完成计数
+ * @details    提交任务时加一、任务执行完毕减一；BattleJobSystem::wait 等待计数归零
+ */
+class BattleJobGroup
+{
+public:
+    BattleJobGroup() : _pending(0) {}
+
+    /// 组内是否还有未完成的任务
+    bool isBusy() const { return _pending.load(std::memory_order_acquire) > 0; }
+
+private:
+    friend class BattleJobSystem;
+
+    BattleJobGroup(const BattleJobGroup&);
+    BattleJobGroup& operator=(const BattleJobGroup&);
+
+    std::atomic<int> _pending;   ///< 未完成的任务数
+};
+
+/**
+ * @class      BattleJobSystem
+ * @brief      工作窃取线程池
+ * @details    使用流程：submit(group, job) 提交任意任务后 wait(group)；
+ *             或直接 parallelFor(count, grain, fn) 把 [0, count) 切块并行执行并等待完成
+ */
+class BattleJobSystem
+{
+public:
+    typedef std::function<void()> Job;
+
+    /// 区间任务：处理 [begin, end)
+    typedef std::function<void(int begin, int end)> RangeJob;
+
+    /**
+     * @brief      创建任务系统并启动工作线程
+     * @param      workerCount  工作线程数（不含调用线程）；小于 0 时取硬件线程数 - 1
+     */
+    explicit BattleJobSystem(int workerCount = -1);
+
+    /// 通知所有工作线程退出并等待其结束（未执行的任务被丢弃）
+    ~BattleJobSystem();
+
+    /**
+     * @brief      进程共享的任务系统（首次调用时按硬件线程数创建）
+     */
+    static BattleJobSystem* getInstance();
+
+    /// 工作线程数（不含调用线程）
+    int getWorkerCount() const { return static_cast<int>(_threads.size()); }
+
+    /// 参与计算的线程总数（工作线程 + 调用线程）
+    int getThreadCount() const { return getWorkerCount() + 1; }
+
+    /**
+     * @brief      提交一个任务
+     * @details    工作线程内提交的任务压入本线程队列，其他线程提交的任务轮流分发到各队列
+     */
+    void submit(BattleJobGroup& group, const Job& job);
+
+    /**
+     * @brief      等待任务组完成
+     * @details    等待期间调用线程也会执行（或窃取）队列中的任务
+     */
+    void wait(BattleJobGroup& group);
+
+    /**
+     * @brief      并行执行区间任务并等待完成
+     * @details    [0, count) 按 grain 切块（块数不超过线程数的 4 倍），每块调用一次 fn；
+     *             没有工作线程或只有一块时直接在调用线程上执行 fn(0, count)
+     * @param      count  元素数量
+     * @param      grain  每块最少的元素数量
+     * @param      fn     区间任务
+     */
+    void parallelFor(int count, int grain, const RangeJob& fn);
+
+private:
+    /// 带完成计数的任务
+    struct Task {
+        Job job;
+        BattleJobGroup* group;
+    };
+
+    /// 单个线程的任务队列（互斥锁保护的双端队列）
+    struct Queue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    BattleJobSystem(const BattleJobSystem&);
+    BattleJobSystem& operator=(const BattleJobSystem&);
+
+    void workerLoop(int index);
+    void push(int queue, const Task& task);
+    bool popOwn(int queue, Task& out);
+    bool steal(int thief, Task& out);
+    bool tryRunOne(int queue);
+    void run(Task& task);
+    int currentQueue() const;
+
+    std::vector<std::unique_ptr<Queue>> _queues;   ///< 队列：0..N-1 为工作线程，N 为外部线程共用
+    std::vector<std::thread> _threads;             ///< 工作线程
+    std::atomic<int> _queued;                      ///< 所有队列中尚未取出的任务数
+    std::atomic<unsigned> _nextQueue;              ///< 外部提交的轮转分发位置
+    std::atomic<bool> _stop;                       ///< 退出标志
+    std::mutex _sleepMutex;                        ///< 空闲线程休眠用
+    std::condition_variable _wake;                 ///< 有新任务或退出时唤醒空闲线程
+};
+
+#endif // BATTLE_JOB_SYSTEM_H_
@@ -0,0 +1,388 @@
+/**
+ * @file       BattleLayoutOptimizer.cpp
+ * @brief      防御布局遗传算法优化的实现
+ * @version    1.0
+ */
+#include "BattleLayoutOptimizer.h"
+#include <algorithm>
+#include <cfloat>
+#include <chrono>
+#include <cmath>
+#include "BattleJobSystem.h"
+
+const int BattleLayoutOptimizer::DEFAULT_MAX_GENERATIONS;
+const float BattleLayoutOptimizer::DEFAULT_BUDGET_SECONDS = 5.0f;
+
+namespace {
+
+/// 进攻方获胜时在摧毁百分比之外额外计入的代价（按获胜用时折减，越快获胜代价越高）
+const float VICTORY_PENALTY = 50.0f;
+
+/// 新布局至少要好这么多才算改进（避免浮点误差）
+const float IMPROVEMENT_EPSILON = 0.01f;
+
+/// 锦标赛选择的参赛数
+const int TOURNAMENT_SIZE = 3;
+
+/// 子代由交叉产生的概率（百分比），其余直接复制父代
+const int CROSSOVER_PERCENT = 70;
+
+/// 移动变异中在整张地图上随机选位的概率（百分比），其余在原位置附近移动
+const int GLOBAL_MOVE_PERCENT = 25;
+
+/// 附近移动的最大距离（瓦片）
+const float LOCAL_MOVE_TILES = 4.0f;
+
+/// 一次变异寻找合法位置的尝试次数
+const int PLACE_ATTEMPTS = 12;
+
+/// 每种兵种组合使用的种子数
+const int SEEDS_PER_ARMY = 2;
+
+/// 兵力随基地规模增长：每多少座建筑加一倍基础兵力
+const int BUILDINGS_PER_ARMY_SCALE = 40;
+
+/// 标准进攻的基础兵力（下标为 SoldierType：ORIGINAL, ARROW, BOOM, GIANT, AIRFORCE）
+const int STANDARD_ARMIES[][BATTLE_SOLDIER_TYPE_COUNT] = {
+    { 12, 0, 0, 0, 0 },    // 人海
+    { 0, 8, 0, 2, 0 },     // 巨人 + 弓箭手
+    { 8, 0, 4, 0, 0 },     // 炸弹人开墙
+    { 0, 0, 0, 0, 5 },     // 空军
+    { 4, 4, 2, 2, 2 }      // 混编
+};
+
+/// 第 k 个标准进攻的种子
+uint32_t attackSeed(int k)
+{
+    uint32_t h = 0x2545F491u ^ (static_cast<uint32_t>(k + 1) * 0x9E3779B9u);
+    h ^= h >> 15;
+    h *= 0x2C1B3C6Du;
+    h ^= h >> 12;
+    return h;
+}
+
+} // namespace
+
+/// xorshift32 随机数（只在驱动线程上使用）
+class BattleLayoutOptimizer::Random
+{
+public:
+    explicit Random(uint32_t seed) : _state(seed ? seed : 0x9E3779B9u) {}
+
+    uint32_t next()
+    {
+        _state ^= _state << 13;
+        _state ^= _state >> 17;
+        _state ^= _state << 5;
+        return _state;
+    }
+
+    /// [0, n) 的整数
+    int range(int n) { return n > 0 ? static_cast<int>(next() % static_cast<uint32_t>(n)) : 0; }
+
+    /// [lo, hi) 的浮点数
+    float range(float lo, float hi) { return lo + (hi - lo) * static_cast<float>(next() >> 8) / 16777216.0f; }
+
+private:
+    uint32_t _state;
+};
+
+// =========================================================
+// 1. 标准进攻
+// =========================================================
+
+void BattleLayoutOptimizer::makeStandardAttacks(const BattleLevelDesc& level, std::vector<BattleLayoutAttack>& out)
+{
+    out.clear();
+    const int scale = 1 + static_cast<int>(level.buildings.size()) / BUILDINGS_PER_ARMY_SCALE;
+    const int armyCount = static_cast<int>(sizeof(STANDARD_ARMIES) / sizeof(STANDARD_ARMIES[0]));
+    for (int a = 0; a < armyCount; ++a) {
+        for (int s = 0; s < SEEDS_PER_ARMY; ++s) {
+            BattleLayoutAttack attack;
+            for (int t = 0; t < BATTLE_SOLDIER_TYPE_COUNT; ++t) attack.army[t] = STANDARD_ARMIES[a][t] * scale;
+            attack.seed = attackSeed(a * SEEDS_PER_ARMY + s);
+            out.push_back(attack);
+        }
+    }
+}
+
+// =========================================================
+// 2. 启动与取消
+// =========================================================
+
+BattleLayoutOptimizer::BattleLayoutOptimizer()
+    : _step(16.0f)
+    , _running(false)
+    , _finished(false)
+    , _cancel(false)
+{
+    _result.improved = false;
+    _result.baselineDestruction = 0.0f;
+    _result.bestDestruction = 0.0f;
+    _result.baselineWinRate = 0.0f;
+    _result.bestWinRate = 0.0f;
+    _result.generations = 0;
+    _result.evaluations = 0;
+    _result.elapsedSeconds = 0.0;
+}
+
+BattleLayoutOptimizer::~BattleLayoutOptimizer()
+{
+    cancel();
+}
+
+bool BattleLayoutOptimizer::start(const BattleLevelDesc& level, const std::vector<BattleRect>& collisions,
+    const std::vector<BattleRect>& obstacles, const BattleRect& bounds,
+    const std::vector<BattleLayoutAttack>& attacks, BattleJobSystem* jobs, float budgetSeconds, uint32_t seed)
+{
+    cancel();
+    if (level.buildings.empty() || collisions.size() != level.buildings.size() || attacks.empty()) return false;
+
+    _level = level;
+    _collisions = collisions;
+    _obstacles = obstacles;
+    _bounds = bounds;
+    _attacks = attacks;
+    // 摆放位置按半个瓦片对齐，减少几乎相同的候选
+    _step = std::max(level.tileWidth * 0.5f, 8.0f);
+
+    _finished.store(false);
+    _cancel.store(false);
+    _running.store(true);
+    _driver = std::thread(&BattleLayoutOptimizer::evolve, this, jobs, DEFAULT_MAX_GENERATIONS, budgetSeconds, seed);
+    return true;
+}
+
+void BattleLayoutOptimizer::cancel()
+{
+    _cancel.store(true);
+    if (_driver.joinable()) _driver.join();
+}
+
+// =========================================================
+// 3. 进化主循环
+// =========================================================
+
+void BattleLayoutOptimizer::evolve(BattleJobSystem* jobs, int maxGenerations, float budgetSeconds, uint32_t seed)
+{
+    const auto begin = std::chrono::steady_clock::now();
+    auto elapsed = [&begin]() {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    };
+
+    _workspaces.prepare([this](Workspace& workspace) { workspace.level = _level; });
+
+    const int buildingCount = static_cast<int>(_level.buildings.size());
+    Layout original(buildingCount);
+    for (int b = 0; b < buildingCount; ++b) original[b] = _level.buildings[b].position;
+
+    // 初始种群：原布局 + 原布局变异 1~4 次得到的变体
+    Random random(seed);
+    std::vector<Layout> population(POPULATION_SIZE, original);
+    std::vector<Layout> next(POPULATION_SIZE, original);
+    std::vector<Score> scores(POPULATION_SIZE);
+    std::vector<Score> nextScores(POPULATION_SIZE);
+    for (int k = 1; k < POPULATION_SIZE; ++k) {
+        const int mutations = 1 + k % 4;
+        for (int m = 0; m < mutations; ++m) mutate(population[k], random);
+    }
+    evaluateRange(population, scores, 0, POPULATION_SIZE, jobs);
+    const Score baseline = scores[0];
+    int evaluations = POPULATION_SIZE;
+
+    // 每代：精英直接保留，其余由锦标赛选出的父代交叉 + 变异产生；只评估新产生的子代
+    std::vector<int> order(POPULATION_SIZE);
+    int generations = 0;
+    while (generations < maxGenerations && !_cancel.load() && elapsed() < budgetSeconds) {
+        for (int k = 0; k < POPULATION_SIZE; ++k) order[k] = k;
+        std::stable_sort(order.begin(), order.end(),
+            [&scores](int a, int b) { return scores[a].cost < scores[b].cost; });
+        for (int e = 0; e < ELITE_COUNT; ++e) {
+            next[e] = population[order[e]];
+            nextScores[e] = scores[order[e]];
+        }
+        for (int k = ELITE_COUNT; k < POPULATION_SIZE; ++k) {
+            const int a = tournament(scores, random);
+            if (random.range(100) < CROSSOVER_PERCENT) crossover(population[a], population[tournament(scores, random)], next[k], random);
+            else next[k] = population[a];
+            const int mutations = 1 + random.range(2);
+            for (int m = 0; m < mutations; ++m) mutate(next[k], random);
+        }
+        evaluateRange(next, nextScores, ELITE_COUNT, POPULATION_SIZE, jobs);
+        population.swap(next);
+        scores.swap(nextScores);
+        evaluations += POPULATION_SIZE - ELITE_COUNT;
+        generations++;
+    }
+
+    int best = 0;
+    for (int k = 1; k < POPULATION_SIZE; ++k) {
+        if (scores[k].cost < scores[best].cost) best = k;
+    }
+
+    BattleLayoutResult result;
+    result.improved = scores[best].cost < baseline.cost - IMPROVEMENT_EPSILON;
+    result.positions = result.improved ? population[best] : original;
+    result.baselineDestruction = baseline.destruction;
+    result.baselineWinRate = baseline.winRate;
+    result.bestDestruction = result.improved ? scores[best].destruction : baseline.destruction;
+    result.bestWinRate = result.improved ? scores[best].winRate : baseline.winRate;
+    result.generations = generations;
+    result.evaluations = evaluations;
+    result.elapsedSeconds = elapsed();
+    _result = result;
+
+    _running.store(false);
+    _finished.store(true);
+}
+
+void BattleLayoutOptimizer::evaluateRange(const std::vector<Layout>& layouts, std::vector<Score>& scores, int begin, int end,
+    BattleJobSystem* jobs)
+{
+    auto job = [this, &layouts, &scores, begin](int b, int e) {
+        BattleWorkspacePool<Workspace>::Lease workspace(_workspaces);
+        for (int k = begin + b; k < begin + e; ++k) {
+            if (_cancel.load()) {
+                // 取消后剩余候选记为最差，不会被选为结果
+                scores[k].cost = FLT_MAX;
+                scores[k].destruction = 100.0f;
+                scores[k].winRate = 1.0f;
+                continue;
+            }
+            scores[k] = evaluate(layouts[k], *workspace);
+        }
+    };
+    if (jobs) jobs->parallelFor(end - begin, 1, job);
+    else job(0, end - begin);
+}
+
+BattleLayoutOptimizer::Score BattleLayoutOptimizer::evaluate(const Layout& layout, Workspace& workspace) const
+{
+    // 建筑整体平移：位置与战斗占地按同一偏移移动
+    for (size_t b = 0; b < layout.size(); ++b) {
+        const BattleBuildingDesc& origin = _level.buildings[b];
+        BattleBuildingDesc& desc = workspace.level.buildings[b];
+        desc.position = layout[b];
+        desc.footprint.x = origin.footprint.x + (layout[b].x - origin.position.x);
+        desc.footprint.y = origin.footprint.y + (layout[b].y - origin.position.y);
+    }
+    workspace.prototype.loadLevel(workspace.level);
+
+    float cost = 0.0f;
+    float destruction = 0.0f;
+    int wins = 0;
+    for (const BattleLayoutAttack& attack : _attacks) {
+        BattleRunResult run = BattlePredictor::simulate(workspace.prototype, attack.army, attack.seed, workspace.sim);
+        destruction += static_cast<float>(run.destruction);
+        cost += static_cast<float>(run.destruction);
+        if (run.victory) {
+            // 大多数基地最终都会被攻破，拖慢进攻方同样是防守上的改进
+            const float haste = 1.0f - static_cast<float>(run.ticks) / BattlePredictor::MAX_TICKS_PER_RUN;
+            cost += VICTORY_PENALTY * haste;
+            wins++;
+        }
+    }
+
+    const float runs = static_cast<float>(_attacks.size());
+    Score score;
+    score.cost = cost / runs;
+    score.destruction = destruction / runs;
+    score.winRate = static_cast<float>(wins) / runs;
+    return score;
+}
+
+// =========================================================
+// 4. 摆放规则与遗传算子
+// =========================================================
+
+BattleRect BattleLayoutOptimizer::collisionAt(int building, const BattleVec2& pos) const
+{
+    const BattleRect& rect = _collisions[building];
+    const BattleVec2& origin = _level.buildings[building].position;
+    return BattleRect(rect.x + (pos.x - origin.x), rect.y + (pos.y - origin.y), rect.w, rect.h);
+}
+
+bool BattleLayoutOptimizer::fits(const Layout& layout, int building, const BattleVec2& pos, int ignore) const
+{
+    // 与 GameScene::checkCollision 相同：包围盒相交（含边界接触）即视为碰撞
+    const BattleRect rect = collisionAt(building, pos);
+    if (rect.minX() < _bounds.minX() || rect.maxX() > _bounds.maxX() ||
+        rect.minY() < _bounds.minY() || rect.maxY() > _bounds.maxY()) {
+        return false;
+    }
+    for (const BattleRect& obstacle : _obstacles) {
+        if (rect.intersects(obstacle)) return false;
+    }
+    for (size_t b = 0; b < layout.size(); ++b) {
+        const int other = static_cast<int>(b);
+        if (other == building || other == ignore) continue;
+        if (rect.intersects(collisionAt(other, layout[b]))) return false;
+    }
+    return true;
+}
+
+BattleVec2 BattleLayoutOptimizer::snap(const BattleVec2& pos) const
+{
+    return BattleVec2(std::floor(pos.x / _step + 0.5f) * _step, std::floor(pos.y / _step + 0.5f) * _step);
+}
+
+bool BattleLayoutOptimizer::mutate(Layout& layout, Random& random) const
+{
+    const int count = static_cast<int>(layout.size());
+    const int building = random.range(count);
+
+    // 交换：两座建筑互换中心位置（大小不同时需重新检查两者）
+    if (count > 1 && random.range(3) == 0) {
+        const int other = random.range(count);
+        if (other == building) return false;
+        const BattleVec2 a = layout[building];
+        const BattleVec2 b = layout[other];
+        if (!fits(layout, building, b, other) || !fits(layout, other, a, building)) return false;
+        if (collisionAt(building, b).intersects(collisionAt(other, a))) return false;
+        layout[building] = b;
+        layout[other] = a;
+        return true;
+    }
+
+    // 移动：附近平移或在整张地图上随机选位
+    const float reach = LOCAL_MOVE_TILES * std::max(_level.tileWidth, _step);
+    for (int attempt = 0; attempt < PLACE_ATTEMPTS; ++attempt) {
+        BattleVec2 pos;
+        if (random.range(100) < GLOBAL_MOVE_PERCENT) {
+            pos = BattleVec2(random.range(_bounds.minX(), _bounds.maxX()), random.range(_bounds.minY(), _bounds.maxY()));
+        }
+        else {
+            pos = BattleVec2(layout[building].x + random.range(-reach, reach), layout[building].y + random.range(-reach, reach));
+        }
+        pos = snap(pos);
+        if (fits(layout, building, pos, BATTLE_INVALID_INDEX)) {
+            layout[building] = pos;
+            return true;
+        }
+    }
+    return false;
+}
+
+void BattleLayoutOptimizer::crossover(const Layout& a, const Layout& b, Layout& child, Random& random) const
+{
+    // 从合法的父代 a 出发，逐座建筑尝试继承 b 的位置；每一步都保持合法
+    child = a;
+    const int count = static_cast<int>(child.size());
+    const int first = random.range(count);
+    for (int k = 0; k < count; ++k) {
+        const int building = (first + k) % count;
+        if (random.range(2) == 0) continue;
+        if (b[building].x == child[building].x && b[building].y == child[building].y) continue;
+        if (fits(child, building, b[building], BATTLE_INVALID_INDEX)) child[building] = b[building];
+    }
+}
+
+int BattleLayoutOptimizer::tournament(const std::vector<Score>& scores, Random& random) const
+{
+    int best = random.range(POPULATION_SIZE);
+    for (int k = 1; k < TOURNAMENT_SIZE; ++k) {
+        const int challenger = random.range(POPULATION_SIZE);
+        if (scores[challenger].cost < scores[best].cost) best = challenger;
+    }
+    return best;
+}
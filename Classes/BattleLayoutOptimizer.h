@@ -0,0 +1,165 @@
+/**
+ * @file       BattleLayoutOptimizer.h
+ * @brief      基于无画面战斗评估的防御布局优化（遗传算法）
+ * @details    以村庄中各建筑的位置为基因，种群中的每个候选布局都用一组固定的“标准进攻”做无画面模拟：
+ *             每种进攻的兵力与随机种子固定，候选之间的差别只来自布局本身；进攻方的平均摧毁百分比
+ *             （胜利额外加罚）越低，布局越好。每一代保留最优的若干个布局，其余由锦标赛选出的父代
+ *             交叉、变异得到：变异随机移动一座建筑或交换两座建筑的位置，交叉逐座建筑从另一父代继承位置。
+ *             所有候选都满足与 GameScene::checkCollision 相同的摆放规则：建筑的包围盒两两不相交
+ *             （边界接触也算相交），不与装饰物等固定障碍相交，且不超出地图。
+ *             一代中的候选互不依赖，交给 BattleJobSystem 并行评估；每块任务从工作区池借出一套关卡、
+ *             原型世界与模拟工作区，预热后评估过程几乎不再申请内存
+ * @version    1.0
+ * @note       该文件无引擎依赖；优化在后台驱动线程上进行，调用方通过 isFinished() 轮询结果。
+ *             随机数只在驱动线程上使用、评估是确定的，因此给定种子与代数时结果与线程数无关
+ */
+#ifndef BATTLE_LAYOUT_OPTIMIZER_H_
+#define BATTLE_LAYOUT_OPTIMIZER_H_
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "BattlePredictor.h"
+#include "BattleTypes.h"
+#include "BattleWorkspacePool.h"
+
+class BattleJobSystem;
+
+/**
+ * @struct     BattleLayoutAttack
+ * @brief      一种标准进攻：固定的兵力与投放种子
+ */
+struct BattleLayoutAttack {
+    int army[BATTLE_SOLDIER_TYPE_COUNT];   ///< 各兵种数量（下标为 SoldierType）
+    uint32_t seed;                         ///< 投放方案的随机种子
+};
+
+/**
+ * @struct     BattleLayoutResult
+ * @brief      一次优化的结果
+ */
+struct BattleLayoutResult {
+    std::vector<BattleVec2> positions;   ///< 建议的建筑位置（下标与关卡描述中的建筑一致）
+    bool improved;                       ///< 是否找到比原布局更好的布局（否则 positions 为原位置）
+    float baselineDestruction;           ///< 原布局下标准进攻的平均摧毁百分比
+    float bestDestruction;               ///< 建议布局下标准进攻的平均摧毁百分比
+    float baselineWinRate;               ///< 原布局下进攻方的胜率（0~1）
+    float bestWinRate;                   ///< 建议布局下进攻方的胜率（0~1）
+    int generations;                     ///< 完成的代数
+    int evaluations;                     ///< 评估的布局数
+    double elapsedSeconds;               ///< 实际耗时（秒）
+};
+
+/**
+ * @class      BattleLayoutOptimizer
+ * @brief      在任务系统上并行评估候选布局的遗传算法优化器
+ * @details    使用流程：start(关卡, 占地, 障碍, 地图范围, 进攻, 任务系统) -> 每帧 isFinished() -> getResult()；
+ *             对象析构或再次 start 时会取消并等待尚未完成的优化
+ */
+class BattleLayoutOptimizer
+{
+public:
+    /// 种群大小
+    static const int POPULATION_SIZE = 16;
+
+    /// 每代直接保留的最优布局数
+    static const int ELITE_COUNT = 2;
+
+    /// 默认最多进化的代数
+    static const int DEFAULT_MAX_GENERATIONS = 30;
+
+    /// 默认时间预算（秒）
+    static const float DEFAULT_BUDGET_SECONDS;
+
+    BattleLayoutOptimizer();
+    ~BattleLayoutOptimizer();
+
+    /**
+     * @brief      按基地规模生成一组标准进攻
+     * @details    几种常见的兵种组合（人海、巨人 + 弓箭手、炸弹人突破、空军、混编），
+     *             兵力随建筑数量增加，每种组合使用两个固定种子
+     * @param      level  关卡描述
+     * @param      out    输出的进攻列表
+     */
+    static void makeStandardAttacks(const BattleLevelDesc& level, std::vector<BattleLayoutAttack>& out);
+
+    /**
+     * @brief      开始一次优化（后台执行，立即返回）
+     * @param      level          当前布局的关卡描述（战斗中的位置与占地）
+     * @param      collisions     各建筑在村庄中的碰撞矩形（下标与 level.buildings 一致）
+     * @param      obstacles      不可移动的障碍物矩形
+     * @param      bounds         建筑碰撞矩形必须位于的范围
+     * @param      attacks        标准进攻
+     * @param      jobs           任务系统；为空时在驱动线程上逐个评估
+     * @param      budgetSeconds  时间预算（秒），超出后不再开始新的一代
+     * @param      seed           随机种子
+     * @return     bool  建筑为空、碰撞矩形数量不符或没有进攻时返回 false
+     */
+    bool start(const BattleLevelDesc& level, const std::vector<BattleRect>& collisions,
+        const std::vector<BattleRect>& obstacles, const BattleRect& bounds,
+        const std::vector<BattleLayoutAttack>& attacks, BattleJobSystem* jobs,
+        float budgetSeconds = DEFAULT_BUDGET_SECONDS, uint32_t seed = 1);
+
+    /// 取消正在进行的优化并等待驱动线程退出（已找到的最优布局仍作为结果）
+    void cancel();
+
+    /// 是否有优化正在进行
+    bool isRunning() const { return _running.load(); }
+
+    /// 最近一次优化是否已完成（可读取结果）
+    bool isFinished() const { return _finished.load(); }
+
+    /// 最近一次优化的结果（isFinished() 为 true 后有效）
+    const BattleLayoutResult& getResult() const { return _result; }
+
+private:
+    /// 一个候选布局：各建筑的中心位置
+    typedef std::vector<BattleVec2> Layout;
+
+    /// 候选布局的评估结果
+    struct Score {
+        float cost;          ///< 进攻方收益（越低越好）
+        float destruction;   ///< 平均摧毁百分比
+        float winRate;       ///< 进攻方胜率
+    };
+
+    /// 评估工作区（每块并行任务借出一个）
+    struct Workspace {
+        BattleLevelDesc level;       ///< 按候选布局平移后的关卡
+        BattleWorld prototype;       ///< 载入候选布局的原型世界
+        BattleSimScratch sim;        ///< 单场模拟工作区
+    };
+
+    class Random;
+
+    BattleLayoutOptimizer(const BattleLayoutOptimizer&);
+    BattleLayoutOptimizer& operator=(const BattleLayoutOptimizer&);
+
+    void evolve(BattleJobSystem* jobs, int maxGenerations, float budgetSeconds, uint32_t seed);
+    void evaluateRange(const std::vector<Layout>& layouts, std::vector<Score>& scores, int begin, int end,
+        BattleJobSystem* jobs);
+    Score evaluate(const Layout& layout, Workspace& workspace) const;
+
+    BattleRect collisionAt(int building, const BattleVec2& pos) const;
+    bool fits(const Layout& layout, int building, const BattleVec2& pos, int ignore) const;
+    BattleVec2 snap(const BattleVec2& pos) const;
+    bool mutate(Layout& layout, Random& random) const;
+    void crossover(const Layout& a, const Layout& b, Layout& child, Random& random) const;
+    int tournament(const std::vector<Score>& scores, Random& random) const;
+
+    BattleLevelDesc _level;                          ///< 原布局
+    std::vector<BattleRect> _collisions;             ///< 原布局下各建筑的碰撞矩形
+    std::vector<BattleRect> _obstacles;              ///< 固定障碍
+    BattleRect _bounds;                              ///< 摆放范围
+    std::vector<BattleLayoutAttack> _attacks;        ///< 标准进攻
+    float _step;                                     ///< 摆放位置的对齐步长
+    BattleWorkspacePool<Workspace> _workspaces;      ///< 评估工作区（每块任务借出一个）
+    BattleLayoutResult _result;                      ///< 优化结果
+    std::thread _driver;                             ///< 后台驱动线程
+    std::atomic<bool> _running;                      ///< 是否正在优化
+    std::atomic<bool> _finished;                     ///< 结果是否可读
+    std::atomic<bool> _cancel;                       ///< 取消标志
+};
+
+#endif // BATTLE_LAYOUT_OPTIMIZER_H_
@@ -0,0 +1,112 @@
+/**
+ * @file       BattleOccupancyMap.cpp
+ * @brief      瓦片占据栅格的实现
+ * @version    1.0
+ */
+#include "BattleOccupancyMap.h"
+#include <algorithm>
+
+BattleOccupancyMap::BattleOccupancyMap()
+    : _cols(0)
+    , _rows(0)
+    , _tileWidth(32.0f)
+    , _tileHeight(32.0f)
+{
+}
+
+void BattleOccupancyMap::build(const BattleLevelDesc& level)
+{
+    _tileWidth = level.tileWidth > 0.0f ? level.tileWidth : 32.0f;
+    _tileHeight = level.tileHeight > 0.0f ? level.tileHeight : 32.0f;
+    _cols = std::max(0, static_cast<int>(std::ceil(level.mapWidth / _tileWidth)));
+    _rows = std::max(0, static_cast<int>(std::ceil(level.mapHeight / _tileHeight)));
+    const int tileCount = _cols * _rows;
+
+    _footprint.resize(level.buildings.size());
+    _cleared.assign(level.buildings.size(), 0);
+    _fullCount.assign(tileCount, 0);
+    _partial.assign(tileCount, std::vector<int>());
+    _outside.clear();
+
+    for (size_t b = 0; b < level.buildings.size(); ++b) {
+        _footprint[b] = level.buildings[b].footprint;
+        // 初始即无血量的建筑不阻挡
+        if (level.buildings[b].hp <= 0) {
+            _cleared[b] = 1;
+            continue;
+        }
+        rasterize(static_cast<int>(b), 1);
+    }
+}
+
+void BattleOccupancyMap::clearBuilding(int building)
+{
+    if (building < 0 || static_cast<size_t>(building) >= _cleared.size() || _cleared[building]) return;
+    _cleared[building] = 1;
+    rasterize(building, -1);
+}
+
+int BattleOccupancyMap::tileOf(const BattleVec2& pos) const
+{
+    if (pos.x < 0.0f || pos.y < 0.0f) return BATTLE_INVALID_INDEX;
+    int col = static_cast<int>(pos.x / _tileWidth);
+    int row = static_cast<int>(pos.y / _tileHeight);
+    if (col >= _cols || row >= _rows) return BATTLE_INVALID_INDEX;
+    return row * _cols + col;
+}
+
+void BattleOccupancyMap::rasterize(int building, int delta)
+{
+    const BattleRect& rect = _footprint[building];
+    const float mapW = _cols * _tileWidth;
+    const float mapH = _rows * _tileHeight;
+
+    // 占地超出地图的建筑同时登记到地图外列表，保证地图外的点也能得到正确结果
+    if (rect.minX() < 0.0f || rect.minY() < 0.0f || rect.maxX() >= mapW || rect.maxY() >= mapH) {
+        if (delta > 0) _outside.push_back(building);
+        else _outside.erase(std::find(_outside.begin(), _outside.end(), building));
+    }
+    if (_cols == 0 || _rows == 0) return;
+
+    // 包含测试含边界，因此落在 maxX / maxY 上的点所在的瓦片也要覆盖
+    int minCol = std::max(0, static_cast<int>(std::floor(rect.minX() / _tileWidth)));
+    int maxCol = std::min(_cols - 1, static_cast<int>(std::floor(rect.maxX() / _tileWidth)));
+    int minRow = std::max(0, static_cast<int>(std::floor(rect.minY() / _tileHeight)));
+    int maxRow = std::min(_rows - 1, static_cast<int>(std::floor(rect.maxY() / _tileHeight)));
+
+    for (int row = minRow; row <= maxRow; ++row) {
+        float y0 = row * _tileHeight;
+        bool fullY = rect.minY() <= y0 && y0 + _tileHeight <= rect.maxY();
+        for (int col = minCol; col <= maxCol; ++col) {
+            float x0 = col * _tileWidth;
+            bool fullX = rect.minX() <= x0 && x0 + _tileWidth <= rect.maxX();
+            int tile = row * _cols + col;
+
+            if (fullX && fullY) {
+                _fullCount[tile] = static_cast<uint16_t>(_fullCount[tile] + delta);
+            }
+            else if (delta > 0) {
+                _partial[tile].push_back(building);
+            }
+            else {
+                std::vector<int>& list = _partial[tile];
+                list.erase(std::find(list.begin(), list.end(), building));
+            }
+        }
+    }
+}
+
+bool BattleOccupancyMap::isBlocked(const BattleVec2& pos) const
+{
+    int tile = tileOf(pos);
+    const std::vector<int>* candidates = &_outside;
+    if (tile != BATTLE_INVALID_INDEX) {
+        if (_fullCount[tile] > 0) return true;
+        candidates = &_partial[tile];
+    }
+
+    for (int b : *candidates) {
+        if (_footprint[b].containsPoint(pos.x, pos.y)) return true;
+    }
+    return false;
+}
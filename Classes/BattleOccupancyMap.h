@@ -0,0 +1,64 @@
+/**
+ * @file       BattleOccupancyMap.h
+ * @brief      陆军移动阻挡判定用的瓦片占据栅格
+ * @details    在载入关卡时把每个建筑的占地矩形光栅化到瓦片网格上：
+ *             被建筑完整覆盖的瓦片只记一个覆盖计数，查询时直接返回；
+ *             建筑边缘只被部分覆盖的瓦片额外记录覆盖它的建筑，查询时只需检查这几个矩形。
+ *             因此 isBlocked() 与逐个建筑做包含测试的结果完全一致，但只需 O(1) 次查表
+ * @version    1.0
+ * @note       建筑不会移动，栅格只在载入关卡时构建；建筑被摧毁时由 BattleWorld 调用
+ *             clearBuilding() 清除其占据的格子
+ */
+#ifndef BATTLE_OCCUPANCY_MAP_H_
+#define BATTLE_OCCUPANCY_MAP_H_
+
+#include <vector>
+#include "BattleTypes.h"
+
+/**
+ * @class      BattleOccupancyMap
+ * @brief      按瓦片划分的建筑占据栅格
+ */
+class BattleOccupancyMap
+{
+public:
+    BattleOccupancyMap();
+
+    /**
+     * @brief      根据关卡描述构建占据栅格
+     * @param      level  关卡描述（地图尺寸、瓦片尺寸、建筑）
+     */
+    void build(const BattleLevelDesc& level);
+
+    /**
+     * @brief      清除被摧毁建筑占据的格子（重复调用无效果）
+     * @param      building  建筑索引
+     */
+    void clearBuilding(int building);
+
+    /**
+     * @brief      判定地图节点坐标是否位于某个未摧毁建筑的占地矩形内（含边界）
+     */
+    bool isBlocked(const BattleVec2& pos) const;
+
+    /// 瓦片网格列数 / 行数
+    int getColumnCount() const { return _cols; }
+    int getRowCount() const { return _rows; }
+
+private:
+    int tileOf(const BattleVec2& pos) const;
+    void rasterize(int building, int delta);
+
+    int _cols;                                    ///< 瓦片列数
+    int _rows;                                    ///< 瓦片行数
+    float _tileWidth;                             ///< 瓦片宽
+    float _tileHeight;                            ///< 瓦片高
+
+    std::vector<BattleRect> _footprint;           ///< 建筑占地矩形（下标为建筑索引）
+    std::vector<uint8_t> _cleared;                ///< 建筑是否已被清除
+    std::vector<uint16_t> _fullCount;             ///< 完整覆盖该瓦片的存活建筑数量，非零即阻挡
+    std::vector<std::vector<int>> _partial;       ///< 部分覆盖该瓦片的存活建筑
+    std::vector<int> _outside;                    ///< 占地超出地图范围的存活建筑（地图外的点逐个检查）
+};
+
+#endif // BATTLE_OCCUPANCY_MAP_H_
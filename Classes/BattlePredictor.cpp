@@ -0,0 +1,298 @@
+/**
+ * @file       BattlePredictor.cpp
+ * @brief      蒙特卡洛战斗结果预测的实现
+ * @version    1.0
+ */
+#include "BattlePredictor.h"
+#include <algorithm>
+#include <cfloat>
+#include <chrono>
+#include "BattleJobSystem.h"
+#include "BattleRules.h"
+#include "BattleWorld.h"
+
+const float BattlePredictor::DEFAULT_BUDGET_SECONDS = 1.0f;
+
+namespace {
+
+/// 寻找投放点时随机采样的位置数
+const int ANCHOR_SAMPLES = 48;
+
+/// 从离建筑最近的若干个投放点中挑选进攻方向
+const int ANCHOR_CANDIDATES = 8;
+
+/// 投放点周围的随机抖动（像素）
+const float DEPLOY_JITTER = 48.0f;
+
+/// 建筑包围盒向外扩展的采样边距（像素）
+const float SAMPLE_MARGIN = 240.0f;
+
+/// 兵种的投放先后：肉盾先上，输出与自爆随后，空军最后
+const SoldierType DEPLOY_ORDER[BATTLE_SOLDIER_TYPE_COUNT] = {
+    SoldierType::GIANT, SoldierType::ORIGINAL, SoldierType::ARROW, SoldierType::BOOM, SoldierType::AIRFORCE
+};
+
+/// xorshift32 随机数（每场模拟独立，不共享全局状态）
+struct Random {
+    uint32_t state;
+
+    explicit Random(uint32_t seed) : state(seed ? seed : 0x9E3779B9u) {}
+
+    uint32_t next()
+    {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return state;
+    }
+
+    /// [0, n) 的整数
+    int range(int n) { return n > 0 ? static_cast<int>(next() % static_cast<uint32_t>(n)) : 0; }
+
+    /// [lo, hi) 的浮点数
+    float range(float lo, float hi) { return lo + (hi - lo) * static_cast<float>(next() >> 8) / 16777216.0f; }
+};
+
+/// 第 run 场的种子（与线程、批次无关）
+uint32_t seedOf(uint32_t base, int run)
+{
+    uint32_t h = base ^ (static_cast<uint32_t>(run) * 0x9E3779B9u);
+    h ^= h >> 16;
+    h *= 0x85EBCA6Bu;
+    h ^= h >> 13;
+    return h;
+}
+
+/// 距离最近的存活建筑的距离
+float nearestBuildingDistance(const BattleBuildingStore& buildings, const BattleVec2& pos)
+{
+    float best = FLT_MAX;
+    for (size_t b = 0; b < buildings.size(); ++b) {
+        if (buildings.destroyed[b]) continue;
+        best = std::min(best, pos.distance(BattleVec2(buildings.x[b], buildings.y[b])));
+    }
+    return best;
+}
+
+/**
+ * @brief      生成一套投放方案
+ * @details    1. 在建筑包围盒（外扩边距）内随机采样可投放的位置，按离建筑的距离排序，
+ *                从最近的几个中随机挑选 1~3 个进攻方向；
+ *             2. 按 DEPLOY_ORDER 逐兵种投放，每个单位随机分配到一个方向并加抖动，
+ *                同兵种内每隔 2~5 步投放一个，兵种之间停顿 10~40 步
+ */
+void planDeploys(const BattleWorld& world, const int army[BATTLE_SOLDIER_TYPE_COUNT], Random& random,
+    std::vector<std::pair<float, BattleVec2>>& anchors, std::vector<BattleDeployOrder>& out)
+{
+    out.clear();
+    anchors.clear();
+    const BattleBuildingStore& buildings = world.buildings();
+    if (buildings.size() == 0) return;
+
+    // 采样范围：建筑包围盒外扩，钳制到地图内
+    float minX = FLT_MAX, minY = FLT_MAX, maxX = -FLT_MAX, maxY = -FLT_MAX;
+    for (size_t b = 0; b < buildings.size(); ++b) {
+        minX = std::min(minX, buildings.x[b]);
+        minY = std::min(minY, buildings.y[b]);
+        maxX = std::max(maxX, buildings.x[b]);
+        maxY = std::max(maxY, buildings.y[b]);
+    }
+    minX -= SAMPLE_MARGIN;
+    minY -= SAMPLE_MARGIN;
+    maxX += SAMPLE_MARGIN;
+    maxY += SAMPLE_MARGIN;
+    const BattleLevelDesc& level = world.level();
+    if (level.mapWidth > 0.0f) {
+        minX = std::max(minX, 0.0f);
+        maxX = std::min(maxX, level.mapWidth);
+    }
+    if (level.mapHeight > 0.0f) {
+        minY = std::max(minY, 0.0f);
+        maxY = std::min(maxY, level.mapHeight);
+    }
+
+    for (int k = 0; k < ANCHOR_SAMPLES; ++k) {
+        BattleVec2 pos(random.range(minX, maxX), random.range(minY, maxY));
+        if (!world.canDeployAt(pos)) continue;
+        anchors.push_back(std::make_pair(nearestBuildingDistance(buildings, pos), pos));
+    }
+    if (anchors.empty()) return;
+    std::sort(anchors.begin(), anchors.end(),
+        [](const std::pair<float, BattleVec2>& a, const std::pair<float, BattleVec2>& b) { return a.first < b.first; });
+
+    const int candidates = std::min(static_cast<int>(anchors.size()), ANCHOR_CANDIDATES);
+    const int fronts = 1 + random.range(3);
+    BattleVec2 front[3];
+    for (int f = 0; f < fronts; ++f) front[f] = anchors[random.range(candidates)].second;
+
+    int tick = random.range(15);
+    for (SoldierType type : DEPLOY_ORDER) {
+        const int count = army[static_cast<int>(type)];
+        if (count <= 0) continue;
+        const int interval = 2 + random.range(4);
+        for (int n = 0; n < count; ++n) {
+            const BattleVec2& anchor = front[random.range(fronts)];
+            BattleVec2 pos(anchor.x + random.range(-DEPLOY_JITTER, DEPLOY_JITTER),
+                anchor.y + random.range(-DEPLOY_JITTER, DEPLOY_JITTER));
+            if (!world.canDeployAt(pos)) pos = anchor;
+
+            BattleDeployOrder deploy;
+            deploy.tick = tick;
+            deploy.type = type;
+            deploy.pos = pos;
+            out.push_back(deploy);
+            tick += interval;
+        }
+        tick += 10 + random.range(31);
+    }
+}
+
+} // namespace
+
+// =========================================================
+// 1. 单场模拟
+// =========================================================
+
+BattleRunResult BattlePredictor::simulate(const BattleWorld& prototype, const int army[BATTLE_SOLDIER_TYPE_COUNT], uint32_t seed)
+{
+    BattleSimScratch scratch;
+    return simulate(prototype, army, seed, scratch);
+}
+
+BattleRunResult BattlePredictor::simulate(const BattleWorld& prototype, const int army[BATTLE_SOLDIER_TYPE_COUNT], uint32_t seed,
+    BattleSimScratch& scratch)
+{
+    Random random(seed);
+    std::vector<BattleDeployOrder>& plan = scratch.plan;
+    planDeploys(prototype, army, random, scratch.anchors, plan);
+
+    BattleWorld& world = scratch.world;
+    world = prototype;
+    world.setEventsEnabled(false);
+    world.setJobSystem(nullptr);
+    for (int t = 0; t < BATTLE_SOLDIER_TYPE_COUNT; ++t) world.setReserve(static_cast<SoldierType>(t), army[t]);
+
+    // 没有任何可投放位置时兵力永远不会耗尽，按超时失败处理
+    size_t next = 0;
+    int tick = 0;
+    while (world.getOutcome() == BattleOutcome::RUNNING && tick < MAX_TICKS_PER_RUN) {
+        while (next < plan.size() && plan[next].tick <= tick) {
+            world.deployUnit(plan[next].type, plan[next].pos);
+            ++next;
+        }
+        world.step(BattleRules::SIMULATION_STEP);
+        ++tick;
+    }
+
+    BattleRunResult result;
+    result.victory = world.getOutcome() == BattleOutcome::VICTORY;
+    result.destruction = world.getDestructionPercent();
+    result.ticks = tick;
+    return result;
+}
+
+// =========================================================
+// 2. 批量预测
+// =========================================================
+
+BattlePredictor::BattlePredictor()
+    : _running(false)
+    , _finished(false)
+    , _cancel(false)
+{
+    for (int t = 0; t < BATTLE_SOLDIER_TYPE_COUNT; ++t) _army[t] = 0;
+    summarize(0, 0.0);
+}
+
+BattlePredictor::~BattlePredictor()
+{
+    cancel();
+}
+
+bool BattlePredictor::start(const BattleLevelDesc& level, const int army[BATTLE_SOLDIER_TYPE_COUNT], BattleJobSystem* jobs,
+    int maxRuns, float budgetSeconds, uint32_t seed)
+{
+    cancel();
+
+    int total = 0;
+    for (int t = 0; t < BATTLE_SOLDIER_TYPE_COUNT; ++t) {
+        _army[t] = std::max(0, army[t]);
+        total += _army[t];
+    }
+    if (total == 0 || level.buildings.empty() || maxRuns <= 0) return false;
+
+    _level = level;
+    _finished.store(false);
+    _cancel.store(false);
+    _running.store(true);
+    _driver = std::thread(&BattlePredictor::runBatches, this, jobs, maxRuns, budgetSeconds, seed);
+    return true;
+}
+
+void BattlePredictor::cancel()
+{
+    _cancel.store(true);
+    if (_driver.joinable()) _driver.join();
+}
+
+void BattlePredictor::runBatches(BattleJobSystem* jobs, int maxRuns, float budgetSeconds, uint32_t seed)
+{
+    const auto begin = std::chrono::steady_clock::now();
+    auto elapsed = [&begin]() {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    };
+
+    // 关卡只载入一次（流场等派生结构在原型上构建），每场模拟复制原型
+    BattleWorld prototype;
+    prototype.loadLevel(_level);
+    _runs.assign(maxRuns, BattleRunResult());
+
+    const int threads = jobs ? jobs->getThreadCount() : 1;
+
+    // 每批的场数为线程数的 2 倍，批与批之间检查时间预算与取消标志
+    const int batch = threads * 2;
+    int done = 0;
+    while (done < maxRuns && !_cancel.load() && elapsed() < budgetSeconds) {
+        const int first = done;
+        const int count = std::min(batch, maxRuns - done);
+        auto job = [this, &prototype, first, seed](int b, int e) {
+            BattleWorkspacePool<BattleSimScratch>::Lease scratch(_scratch);
+            for (int k = b; k < e; ++k) _runs[first + k] = simulate(prototype, _army, seedOf(seed, first + k), *scratch);
+        };
+        if (jobs) jobs->parallelFor(count, 1, job);
+        else job(0, count);
+        done += count;
+    }
+
+    summarize(done, elapsed());
+    _running.store(false);
+    _finished.store(true);
+}
+
+void BattlePredictor::summarize(int runs, double elapsed)
+{
+    BattlePrediction result;
+    result.runs = runs;
+    result.wins = 0;
+    result.winRate = 0.0f;
+    result.meanDestruction = 0.0f;
+    result.minDestruction = runs > 0 ? 100 : 0;
+    result.maxDestruction = 0;
+    result.elapsedSeconds = elapsed;
+    result.simulatedSeconds = 0.0;
+
+    long long destruction = 0;
+    for (int k = 0; k < runs; ++k) {
+        const BattleRunResult& run = _runs[k];
+        if (run.victory) result.wins++;
+        destruction += run.destruction;
+        result.minDestruction = std::min(result.minDestruction, run.destruction);
+        result.maxDestruction = std::max(result.maxDestruction, run.destruction);
+        result.simulatedSeconds += run.ticks * static_cast<double>(BattleRules::SIMULATION_STEP);
+    }
+    if (runs > 0) {
+        result.winRate = static_cast<float>(result.wins) / runs;
+        result.meanDestruction = static_cast<float>(destruction) / runs;
+    }
+    _result = result;
+}
@@ -0,0 +1,154 @@
+/**
+ * @file       BattlePredictor.h
+ * @brief      蒙特卡洛战斗结果预测
+ * @details    出战前用当前兵力对选定关卡（PVE 关卡或 PVP 基地）运行数百场无画面模拟：
+ *             每场按独立的随机种子生成一套“像玩家一样”的投放方案（选 1~3 个靠近建筑的投放点，
+ *             巨人先上、其余兵种分批跟进，同一批内每隔几步投放一个），再以固定步长推进到分出胜负或超时。
+ *             各场模拟互不依赖，按批交给 BattleJobSystem 并行执行，直到达到场数上限或时间预算；
+ *             最终给出胜率与平均摧毁百分比
+ * @version    1.0
+ * @note       该文件无引擎依赖；预测在后台驱动线程上进行，调用方通过 isFinished() 轮询结果。
+ *             第 k 场模拟的种子只由基础种子与 k 决定，因此结果与线程数无关，只取决于时间预算内完成的场数
+ */
+#ifndef BATTLE_PREDICTOR_H_
+#define BATTLE_PREDICTOR_H_
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "BattleTypes.h"
+#include "BattleWorld.h"
+#include "BattleWorkspacePool.h"
+
+class BattleJobSystem;
+
+/**
+ * @struct     BattleRunResult
+ * @brief      单场模拟的结果
+ */
+struct BattleRunResult {
+    bool victory;        ///< 是否胜利
+    int destruction;     ///< 摧毁百分比
+    int ticks;           ///< 推进的步数
+};
+
+/**
+ * @struct     BattleDeployOrder
+ * @brief      投放方案中的一次投放
+ */
+struct BattleDeployOrder {
+    int tick;            ///< 投放的步数
+    SoldierType type;    ///< 兵种
+    BattleVec2 pos;      ///< 投放位置
+};
+
+/**
+ * @struct     BattleSimScratch
+ * @brief      单场模拟复用的工作区
+ * @details    世界副本通过赋值（而非构造）从原型得到，各容器保留上一场的容量；
+ *             同一工作区连续运行若干场后，模拟过程中不再申请内存。每块并行任务从工作区池借出一个
+ */
+struct BattleSimScratch {
+    BattleWorld world;                                      ///< 本场模拟的世界
+    std::vector<BattleDeployOrder> plan;                    ///< 投放方案
+    std::vector<std::pair<float, BattleVec2>> anchors;      ///< 投放点采样
+};
+
+/**
+ * @struct     BattlePrediction
+ * @brief      一次预测的汇总结果
+ */
+struct BattlePrediction {
+    int runs;                  ///< 完成的模拟场数
+    int wins;                  ///< 胜利场数
+    float winRate;             ///< 胜率（0~1）
+    float meanDestruction;     ///< 平均摧毁百分比
+    int minDestruction;        ///< 最低摧毁百分比
+    int maxDestruction;        ///< 最高摧毁百分比
+    double elapsedSeconds;     ///< 实际耗时（秒）
+    double simulatedSeconds;   ///< 模拟的战斗总时长（秒）
+};
+
+/**
+ * @class      BattlePredictor
+ * @brief      在任务系统上批量运行无画面模拟的胜率预测器
+ * @details    使用流程：start(关卡, 兵力, 任务系统) -> 每帧 isFinished() -> getResult()；
+ *             对象析构或再次 start 时会取消并等待尚未完成的预测
+ */
+class BattlePredictor
+{
+public:
+    /// 默认最多模拟的场数
+    static const int DEFAULT_MAX_RUNS = 400;
+
+    /// 默认时间预算（秒）
+    static const float DEFAULT_BUDGET_SECONDS;
+
+    /// 单场模拟的最长步数（3 分钟，超时按失败计）
+    static const int MAX_TICKS_PER_RUN = 180 * 30;
+
+    BattlePredictor();
+    ~BattlePredictor();
+
+    /**
+     * @brief      开始一次预测（后台执行，立即返回）
+     * @param      level          关卡描述
+     * @param      army           各兵种数量（下标为 SoldierType）
+     * @param      jobs           任务系统；为空时在驱动线程上逐场执行
+     * @param      maxRuns        最多模拟的场数
+     * @param      budgetSeconds  时间预算（秒），超出后不再开始新的一批
+     * @param      seed           基础随机种子
+     * @return     bool  兵力为空或关卡没有建筑时返回 false
+     */
+    bool start(const BattleLevelDesc& level, const int army[BATTLE_SOLDIER_TYPE_COUNT], BattleJobSystem* jobs,
+        int maxRuns = DEFAULT_MAX_RUNS, float budgetSeconds = DEFAULT_BUDGET_SECONDS, uint32_t seed = 1);
+
+    /// 取消正在进行的预测并等待驱动线程退出（已完成的场数仍计入结果）
+    void cancel();
+
+    /// 是否有预测正在进行
+    bool isRunning() const { return _running.load(); }
+
+    /// 最近一次预测是否已完成（可读取结果）
+    bool isFinished() const { return _finished.load(); }
+
+    /// 最近一次预测的汇总结果（isFinished() 为 true 后有效）
+    const BattlePrediction& getResult() const { return _result; }
+
+    /**
+     * @brief      运行单场模拟
+     * @details    在 prototype（已载入关卡的世界）的副本上按种子生成投放方案并推进到结束或超时
+     * @param      prototype  已载入关卡的世界
+     * @param      army       各兵种数量
+     * @param      seed       本场随机种子
+     */
+    static BattleRunResult simulate(const BattleWorld& prototype, const int army[BATTLE_SOLDIER_TYPE_COUNT], uint32_t seed);
+
+    /**
+     * @brief      在给定工作区上运行单场模拟（结果与上一个重载相同）
+     * @param      scratch    本场使用的工作区（同一时刻只能被一个线程使用）
+     */
+    static BattleRunResult simulate(const BattleWorld& prototype, const int army[BATTLE_SOLDIER_TYPE_COUNT], uint32_t seed,
+        BattleSimScratch& scratch);
+
+private:
+    BattlePredictor(const BattlePredictor&);
+    BattlePredictor& operator=(const BattlePredictor&);
+
+    void runBatches(BattleJobSystem* jobs, int maxRuns, float budgetSeconds, uint32_t seed);
+    void summarize(int runs, double elapsed);
+
+    BattleLevelDesc _level;                      ///< 预测的关卡
+    int _army[BATTLE_SOLDIER_TYPE_COUNT];        ///< 预测的兵力
+    std::vector<BattleRunResult> _runs;          ///< 各场结果（下标为场次）
+    BattleWorkspacePool<BattleSimScratch> _scratch; ///< 单场模拟工作区（每块任务借出一个）
+    BattlePrediction _result;                    ///< 汇总结果
+    std::thread _driver;                         ///< 后台驱动线程
+    std::atomic<bool> _running;                  ///< 是否正在预测
+    std::atomic<bool> _finished;                 ///< 结果是否可读
+    std::atomic<bool> _cancel;                   ///< 取消标志
+};
+
+#endif // BATTLE_PREDICTOR_H_
@@ -0,0 +1,130 @@
+/**
+ * @file       BattleProjectileLayer.cpp
+ * @brief      弹道批量渲染层的实现
+ * @version    1.0
+ * @note       箭支资源为 "weapon/Arrow.png"，炮弹资源为 "weapon/cannonball.png"；
+ *             资源缺失时对应弹道不显示，不影响核心中的伤害结算
+ */
+#include "BattleProjectileLayer.h"
+
+USING_NS_CC;
+
+namespace {
+
+/// 各弹道类型的纹理、缩放与发射点高度偏移（与原 ArrowSoldier / EnemyBuilding 中的表现一致）
+struct ProjectileLook {
+    const char* texture;
+    float scale;
+    float launchHeight;
+};
+
+const ProjectileLook PROJECTILE_LOOKS[] = {
+    { "weapon/Arrow.png",      3.0f, 0.0f },   // ARROW：从士兵位置射出
+    { "weapon/cannonball.png", 0.8f, 50.0f }   // CANNONBALL：从炮口（建筑中心上方）射出
+};
+
+/// 每个批量节点预留的精灵数量
+const int BATCH_INITIAL_CAPACITY = 64;
+
+} // namespace
+
+bool BattleProjectileLayer::init()
+{
+    if (!Node::init()) return false;
+
+    for (int kind = 0; kind < KIND_COUNT; ++kind) {
+        _batches[kind] = SpriteBatchNode::create(PROJECTILE_LOOKS[kind].texture, BATCH_INITIAL_CAPACITY);
+        if (_batches[kind]) this->addChild(_batches[kind], kind);
+    }
+    return true;
+}
+
+Sprite* BattleProjectileLayer::acquireSprite(int kind)
+{
+    if (!_batches[kind]) return nullptr;
+
+    std::vector<Sprite*>& pool = _freeSprites[kind];
+    if (!pool.empty()) {
+        Sprite* sprite = pool.back();
+        pool.pop_back();
+        sprite->setVisible(true);
+        return sprite;
+    }
+
+    // 池中没有空闲精灵时才创建，之后一直由批量节点持有并循环使用
+    Sprite* sprite = Sprite::createWithTexture(_batches[kind]->getTexture());
+    sprite->setScale(PROJECTILE_LOOKS[kind].scale);
+    _batches[kind]->addChild(sprite);
+    return sprite;
+}
+
+void BattleProjectileLayer::releaseSlot(int slot)
+{
+    Sprite* sprite = _slotSprite[slot];
+    if (!sprite) return;
+    sprite->setVisible(false);
+    _freeSprites[_slotKind[slot]].push_back(sprite);
+    _slotSprite[slot] = nullptr;
+}
+
+void BattleProjectileLayer::syncWithWorld(const BattleWorld& world, float renderDelay, const Rect& viewRect)
+{
+    const BattleProjectilePool& pool = world.projectiles();
+    const int capacity = static_cast<int>(pool.getCapacity());
+    if (static_cast<int>(_slotSprite.size()) < capacity) {
+        _slotSprite.resize(capacity, nullptr);
+        _slotKind.resize(capacity, 0);
+        _slotGeneration.resize(capacity, 0);
+    }
+
+    _visibleCount = 0;
+    _culledCount = 0;
+    for (int slot = 0; slot < capacity; ++slot) {
+        const BattleProjectile& p = pool.at(slot);
+        if (!p.active) {
+            releaseSlot(slot);
+            continue;
+        }
+
+        // 槽位已换成新的弹道（可能是另一种类型），先回收旧精灵
+        int kind = static_cast<int>(p.kind);
+        if (_slotSprite[slot] && (_slotGeneration[slot] != p.generation || _slotKind[slot] != kind)) {
+            releaseSlot(slot);
+        }
+
+        const ProjectileLook& look = PROJECTILE_LOOKS[kind];
+        Vec2 from(p.from.x, p.from.y + look.launchHeight);
+        Vec2 to(p.to.x, p.to.y);
+
+        // 飞行进度：已飞行时间扣除渲染延迟，限制在 [0, 1]
+        float progress = 1.0f;
+        if (p.flightTime > 0.0f) {
+            progress = (p.flightTime - p.timeLeft - renderDelay) / p.flightTime;
+            progress = std::max(0.0f, std::min(1.0f, progress));
+        }
+        const Vec2 pos = from + (to - from) * progress;
+
+        // 视野外的弹道回收精灵，飞回视野时按新绑定重新设置朝向
+        if (!viewRect.containsPoint(pos)) {
+            releaseSlot(slot);
+            _culledCount++;
+            continue;
+        }
+
+        Sprite* sprite = _slotSprite[slot];
+        if (!sprite) {
+            sprite = acquireSprite(kind);
+            if (!sprite) continue;
+            _slotSprite[slot] = sprite;
+            _slotKind[slot] = static_cast<uint8_t>(kind);
+            _slotGeneration[slot] = p.generation;
+
+            // 朝向在整个飞行过程中不变，只在绑定时设置一次
+            Vec2 direction = to - from;
+            sprite->setRotation(-CC_RADIANS_TO_DEGREES(atan2f(direction.y, direction.x)));
+        }
+
+        sprite->setPosition(pos);
+        _visibleCount++;
+    }
+}
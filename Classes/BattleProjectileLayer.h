@@ -0,0 +1,64 @@
+/**
+ * @file       BattleProjectileLayer.h
+ * @brief      弹道（箭 / 炮弹）的批量渲染层
+ * @details    弹道的飞行与命中完全由战斗核心的弹道对象池负责，该层只在每帧读取池中的槽位并摆放精灵：
+ *             每种弹道纹理对应一个 SpriteBatchNode，精灵按槽位复用、空闲时隐藏回收，
+ *             战斗过程中不再为每一发弹道创建精灵、动作序列与回调；视野外的弹道不绑定精灵
+ * @version    1.0
+ * @note       该层作为地图的子节点，使用地图节点坐标；弹道位置按渲染延迟在起止点之间插值，
+ *             与士兵的插值时刻保持一致
+ */
+#ifndef BATTLE_PROJECTILE_LAYER_H_
+#define BATTLE_PROJECTILE_LAYER_H_
+
+#include <vector>
+#include "cocos2d.h"
+#include "BattleWorld.h"
+
+/**
+ * @class      BattleProjectileLayer
+ * @brief      按弹道类型分批绘制的弹道精灵层
+ */
+class BattleProjectileLayer : public cocos2d::Node
+{
+public:
+    CREATE_FUNC(BattleProjectileLayer);
+
+    /**
+     * @brief      初始化：为每种弹道纹理创建一个批量节点
+     * @return     bool  初始化成功返回 true
+     */
+    virtual bool init() override;
+
+    /**
+     * @brief      从战斗核心同步弹道精灵
+     * @details    遍历弹道池的全部槽位：飞行中的槽位绑定（或复用）一个精灵并按飞行进度摆放，
+     *             槽位代数变化说明已换成新弹道，需重新设置朝向；空闲槽位与飞出视野的槽位的精灵隐藏并回收
+     * @param      world        战斗核心
+     * @param      renderDelay  渲染时刻落后于最新模拟时刻的时间（秒），即 (1 - alpha) * 步长
+     * @param      viewRect     当前视野（地图节点坐标）
+     */
+    void syncWithWorld(const BattleWorld& world, float renderDelay, const cocos2d::Rect& viewRect);
+
+    /// 当前显示中的弹道精灵数量（调试 / 统计用）
+    int getVisibleCount() const { return _visibleCount; }
+
+    /// 最近一次同步中因位于视野外而未显示的弹道数量（调试 / 统计用）
+    int getCulledCount() const { return _culledCount; }
+
+private:
+    static const int KIND_COUNT = 2;   ///< 弹道类型数量（箭 / 炮弹）
+
+    cocos2d::Sprite* acquireSprite(int kind);
+    void releaseSlot(int slot);
+
+    cocos2d::SpriteBatchNode* _batches[KIND_COUNT] = {};    ///< 每种纹理一个批量节点（纹理缺失时为空）
+    std::vector<cocos2d::Sprite*> _freeSprites[KIND_COUNT]; ///< 各类型空闲精灵
+    std::vector<cocos2d::Sprite*> _slotSprite;              ///< 槽位 -> 当前绑定的精灵
+    std::vector<uint8_t> _slotKind;                         ///< 槽位 -> 绑定精灵的类型
+    std::vector<uint32_t> _slotGeneration;                  ///< 槽位 -> 绑定时的代数
+    int _visibleCount = 0;                                  ///< 显示中的精灵数量
+    int _culledCount = 0;                                   ///< 视野外未显示的弹道数量
+};
+
+#endif // BATTLE_PROJECTILE_LAYER_H_
@@ -0,0 +1,56 @@
+/**
+ * @file       BattleProjectilePool.cpp
+ * @brief      弹道对象池的实现
+ * @version    1.0
+ */
+#include "BattleProjectilePool.h"
+
+void BattleProjectilePool::reset(size_t capacity)
+{
+    _slots.clear();
+    _free.clear();
+    _active.clear();
+    if (capacity == 0) capacity = 1;
+    _active.reserve(capacity);
+    grow(capacity);
+}
+
+void BattleProjectilePool::grow(size_t capacity)
+{
+    size_t oldSize = _slots.size();
+    if (capacity <= oldSize) return;
+    _slots.resize(capacity);
+    _free.reserve(capacity);
+    _active.reserve(capacity);
+
+    // 倒序压栈，低编号槽位先被取出
+    for (size_t slot = capacity; slot > oldSize; --slot) {
+        _free.push_back(static_cast<int>(slot - 1));
+    }
+}
+
+int BattleProjectilePool::spawn(const BattleProjectile& projectile)
+{
+    if (_free.empty()) grow(_slots.size() * 2);
+
+    int slot = _free.back();
+    _free.pop_back();
+
+    BattleProjectile& p = _slots[slot];
+    uint32_t generation = p.generation + 1;
+    p = projectile;
+    p.generation = generation;
+    p.active = true;
+    _active.push_back(slot);
+    return slot;
+}
+
+void BattleProjectilePool::restore(const std::vector<BattleProjectile>& slots, const std::vector<int>& freeSlots,
+    const std::vector<int>& active)
+{
+    _slots = slots;
+    _free = freeSlots;
+    _active = active;
+    _free.reserve(_slots.size());
+    _active.reserve(_slots.size());
+}
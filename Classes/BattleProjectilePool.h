@@ -0,0 +1,117 @@
+/**
+ * @file       BattleProjectilePool.h
+ * @brief      弹道（箭 / 炮弹）的预分配对象池
+ * @details    弹道保存在固定的槽位数组中，发射时从空闲槽位栈取出、命中后归还，战斗过程中不再分配内存；
+ *             飞行中的槽位另有一个按发射顺序排列的活动列表，每步只遍历活动弹道，命中结算顺序与发射顺序一致。
+ *             弹道的目标以核心中的实体索引保存（一场战斗内稳定不复用），命中时再校验目标是否仍然有效，
+ *             不需要持有精灵指针或引用计数
+ * @version    1.0
+ * @note       槽位索引 + 代数（generation）构成弹道句柄：槽位被回收再利用时代数加一，
+ *             表现层据此判断某个槽位上是否已经换成了一枚新的弹道
+ */
+#ifndef BATTLE_PROJECTILE_POOL_H_
+#define BATTLE_PROJECTILE_POOL_H_
+
+#include <vector>
+#include "BattleTypes.h"
+
+/**
+ * @struct     BattleProjectile
+ * @brief      飞行中的弹道（箭 / 炮弹），到达后结算伤害
+ */
+struct BattleProjectile {
+    BattleProjectileKind kind;   ///< 弹道类型（决定目标是建筑还是单位）
+    int shooter;                 ///< 发射者索引（箭为单位索引，炮弹为建筑索引）
+    int target;                  ///< 目标索引
+    int damage;                  ///< 命中伤害（发射时锁定）
+    BattleVec2 from;             ///< 起点（地图节点坐标）
+    BattleVec2 to;               ///< 终点（发射时目标所在位置）
+    float flightTime;            ///< 总飞行时间（秒）
+    float timeLeft;              ///< 剩余飞行时间（秒）
+    uint32_t generation;         ///< 槽位代数，每次复用加一
+    bool active;                 ///< 是否在飞行中
+
+    BattleProjectile()
+        : kind(BattleProjectileKind::ARROW), shooter(BATTLE_INVALID_INDEX), target(BATTLE_INVALID_INDEX)
+        , damage(0), flightTime(0.0f), timeLeft(0.0f), generation(0), active(false) {}
+};
+
+/**
+ * @class      BattleProjectilePool
+ * @brief      弹道槽位池
+ */
+class BattleProjectilePool
+{
+public:
+    /**
+     * @brief      清空并预分配槽位
+     * @param      capacity  初始槽位数量；同时飞行的弹道超过该数量时按倍数扩容（不会丢弃弹道）
+     */
+    void reset(size_t capacity);
+
+    /**
+     * @brief      发射一枚弹道
+     * @param      projectile  弹道参数（generation / active 由池填写）
+     * @return     int         槽位索引
+     */
+    int spawn(const BattleProjectile& projectile);
+
+    /**
+     * @brief      推进全部飞行中的弹道
+     * @details    剩余飞行时间耗尽的弹道按发射顺序交给 onHit 结算，随后回收其槽位
+     * @param      dt     时间步长（秒）
+     * @param      onHit  命中回调，签名为 void(const BattleProjectile&)
+     */
+    template <typename HitFn>
+    void advance(float dt, HitFn onHit)
+    {
+        size_t write = 0;
+        for (size_t r = 0; r < _active.size(); ++r) {
+            int slot = _active[r];
+            BattleProjectile& p = _slots[slot];
+            p.timeLeft -= dt;
+            if (p.timeLeft > 0.0f) {
+                _active[write++] = slot;
+                continue;
+            }
+            onHit(p);
+            p.active = false;
+            _free.push_back(slot);
+        }
+        _active.resize(write);
+    }
+
+    /// 槽位总数（含空闲槽位）
+    size_t getCapacity() const { return _slots.size(); }
+
+    /// 飞行中的弹道数量
+    size_t getActiveCount() const { return _active.size(); }
+
+    /// 按槽位索引访问（表现层遍历全部槽位，按 active / generation 同步精灵）
+    const BattleProjectile& at(int slot) const { return _slots[slot]; }
+
+    /// 飞行中的槽位（按发射顺序）
+    const std::vector<int>& activeSlots() const { return _active; }
+
+    /// 全部槽位（快照用）
+    const std::vector<BattleProjectile>& slots() const { return _slots; }
+
+    /// 空闲槽位栈（快照用，栈顶在末尾）
+    const std::vector<int>& freeSlots() const { return _free; }
+
+    /**
+     * @brief      以快照内容整体替换池状态
+     * @details    槽位、空闲栈与活动列表原样恢复，之后的发射顺序、槽位与代数与截取快照时完全一致
+     */
+    void restore(const std::vector<BattleProjectile>& slots, const std::vector<int>& freeSlots,
+        const std::vector<int>& active);
+
+private:
+    void grow(size_t capacity);
+
+    std::vector<BattleProjectile> _slots;  ///< 全部槽位
+    std::vector<int> _free;                ///< 空闲槽位栈
+    std::vector<int> _active;              ///< 飞行中的槽位（按发射顺序）
+};
+
+#endif // BATTLE_PROJECTILE_POOL_H_
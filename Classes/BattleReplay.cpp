@@ -0,0 +1,284 @@
+/**
+ * @file       BattleReplay.cpp
+ * @brief      战斗录像的实现
+ * @version    1.0
+ */
+#include "BattleReplay.h"
+#include <cstring>
+#include "BattleRules.h"
+#include "BattleWorld.h"
+
+namespace {
+
+/// 文件魔数
+const uint8_t REPLAY_MAGIC[4] = { 'C', 'O', 'C', 'R' };
+
+void writeU8(std::vector<uint8_t>& out, uint8_t v) { out.push_back(v); }
+
+void writeU16(std::vector<uint8_t>& out, uint16_t v)
+{
+    out.push_back(static_cast<uint8_t>(v));
+    out.push_back(static_cast<uint8_t>(v >> 8));
+}
+
+void writeU32(std::vector<uint8_t>& out, uint32_t v)
+{
+    for (int i = 0; i < 4; ++i) out.push_back(static_cast<uint8_t>(v >> (8 * i)));
+}
+
+void writeF32(std::vector<uint8_t>& out, float v)
+{
+    uint32_t bits;
+    std::memcpy(&bits, &v, sizeof(bits));
+    writeU32(out, bits);
+}
+
+/// 带越界检查的顺序读取器
+struct Reader {
+    const uint8_t* data;
+    size_t size;
+    size_t pos;
+    bool ok;
+
+    bool need(size_t n) {
+        if (!ok || size - pos < n) ok = false;
+        return ok;
+    }
+    uint8_t u8() {
+        if (!need(1)) return 0;
+        return data[pos++];
+    }
+    uint16_t u16() {
+        if (!need(2)) return 0;
+        uint16_t v = static_cast<uint16_t>(data[pos] | (data[pos + 1] << 8));
+        pos += 2;
+        return v;
+    }
+    uint32_t u32() {
+        if (!need(4)) return 0;
+        uint32_t v = 0;
+        for (int i = 0; i < 4; ++i) v |= static_cast<uint32_t>(data[pos + i]) << (8 * i);
+        pos += 4;
+        return v;
+    }
+    float f32() {
+        uint32_t bits = u32();
+        float v;
+        std::memcpy(&v, &bits, sizeof(v));
+        return v;
+    }
+};
+
+} // namespace
+
+// =========================================================
+// 1. 录制
+// =========================================================
+
+BattleReplay::BattleReplay()
+    : _source(Source::CAMPAIGN)
+    , _levelIndex(0)
+    , _step(0.0f)
+    , _hashInterval(DEFAULT_HASH_INTERVAL)
+    , _tickCount(0)
+{
+    for (int i = 0; i < BATTLE_SOLDIER_TYPE_COUNT; ++i) _reserve[i] = 0;
+}
+
+void BattleReplay::begin(int levelIndex, const std::string& pvpJson, float step)
+{
+    _source = levelIndex > 0 ? Source::CAMPAIGN : Source::PVP;
+    _levelIndex = levelIndex > 0 ? levelIndex : 0;
+    _pvpJson = levelIndex > 0 ? std::string() : pvpJson;
+    _step = step;
+    _hashInterval = DEFAULT_HASH_INTERVAL;
+    _tickCount = 0;
+    for (int i = 0; i < BATTLE_SOLDIER_TYPE_COUNT; ++i) _reserve[i] = 0;
+    _deploys.clear();
+    _hashes.clear();
+}
+
+void BattleReplay::setReserve(SoldierType type, int count)
+{
+    int index = static_cast<int>(type);
+    if (index < 0 || index >= BATTLE_SOLDIER_TYPE_COUNT) return;
+    _reserve[index] = count > 0 ? count : 0;
+}
+
+int BattleReplay::getReserve(SoldierType type) const
+{
+    int index = static_cast<int>(type);
+    if (index < 0 || index >= BATTLE_SOLDIER_TYPE_COUNT) return 0;
+    return _reserve[index];
+}
+
+void BattleReplay::recordDeploy(int tick, SoldierType type, const BattleVec2& pos)
+{
+    BattleReplayDeploy deploy;
+    deploy.tick = static_cast<uint32_t>(tick);
+    deploy.type = static_cast<uint8_t>(type);
+    deploy.pos = pos;
+    _deploys.push_back(deploy);
+}
+
+void BattleReplay::recordHash(int tick, uint32_t hash)
+{
+    if (tick <= 0 || tick % _hashInterval != 0) return;
+    // 只按顺序追加，重复或跳步的调用直接忽略
+    if (static_cast<size_t>(tick / _hashInterval) != _hashes.size() + 1) return;
+    _hashes.push_back(hash);
+    if (static_cast<uint32_t>(tick) > _tickCount) _tickCount = static_cast<uint32_t>(tick);
+}
+
+void BattleReplay::rewindTo(int tick)
+{
+    if (tick < 0) tick = 0;
+    while (!_deploys.empty() && _deploys.back().tick >= static_cast<uint32_t>(tick)) _deploys.pop_back();
+    const size_t hashCount = static_cast<size_t>(tick) / _hashInterval;
+    if (_hashes.size() > hashCount) _hashes.resize(hashCount);
+    if (_tickCount > static_cast<uint32_t>(tick)) _tickCount = static_cast<uint32_t>(tick);
+}
+
+bool BattleReplay::getHash(int tick, uint32_t& out) const
+{
+    if (tick <= 0 || tick % _hashInterval != 0) return false;
+    size_t index = static_cast<size_t>(tick / _hashInterval) - 1;
+    if (index >= _hashes.size()) return false;
+    out = _hashes[index];
+    return true;
+}
+
+// =========================================================
+// 2. 序列化
+// =========================================================
+
+void BattleReplay::serialize(std::vector<uint8_t>& out) const
+{
+    out.clear();
+    out.reserve(48 + _pvpJson.size() + _deploys.size() * 13 + _hashes.size() * 4);
+
+    out.insert(out.end(), REPLAY_MAGIC, REPLAY_MAGIC + 4);
+    writeU16(out, FORMAT_VERSION);
+    writeU8(out, static_cast<uint8_t>(_source));
+    writeU8(out, static_cast<uint8_t>(BATTLE_SOLDIER_TYPE_COUNT));
+    writeU32(out, static_cast<uint32_t>(_levelIndex));
+    writeU32(out, static_cast<uint32_t>(_pvpJson.size()));
+    out.insert(out.end(), _pvpJson.begin(), _pvpJson.end());
+    for (int i = 0; i < BATTLE_SOLDIER_TYPE_COUNT; ++i) writeU32(out, static_cast<uint32_t>(_reserve[i]));
+    writeF32(out, _step);
+    writeU32(out, _hashInterval);
+    writeU32(out, _tickCount);
+
+    writeU32(out, static_cast<uint32_t>(_deploys.size()));
+    for (const auto& d : _deploys) {
+        writeU32(out, d.tick);
+        writeU8(out, d.type);
+        writeF32(out, d.pos.x);
+        writeF32(out, d.pos.y);
+    }
+
+    writeU32(out, static_cast<uint32_t>(_hashes.size()));
+    for (uint32_t h : _hashes) writeU32(out, h);
+}
+
+bool BattleReplay::deserialize(const uint8_t* data, size_t size)
+{
+    Reader r = { data, data ? size : 0, 0, true };
+    if (!r.need(4) || std::memcmp(data, REPLAY_MAGIC, 4) != 0) return false;
+    r.pos = 4;
+    if (r.u16() != FORMAT_VERSION) return false;
+
+    uint8_t source = r.u8();
+    if (source > static_cast<uint8_t>(Source::PVP)) return false;
+    _source = static_cast<Source>(source);
+    if (r.u8() != BATTLE_SOLDIER_TYPE_COUNT) return false;
+    _levelIndex = static_cast<int>(r.u32());
+
+    uint32_t jsonSize = r.u32();
+    if (!r.need(jsonSize)) return false;
+    _pvpJson.assign(reinterpret_cast<const char*>(data + r.pos), jsonSize);
+    r.pos += jsonSize;
+
+    for (int i = 0; i < BATTLE_SOLDIER_TYPE_COUNT; ++i) _reserve[i] = static_cast<int>(r.u32());
+    _step = r.f32();
+    _hashInterval = r.u32();
+    _tickCount = r.u32();
+    if (!r.ok || _hashInterval == 0 || !(_step > 0.0f)) return false;
+
+    uint32_t deployCount = r.u32();
+    if (!r.need(static_cast<size_t>(deployCount) * 13)) return false;
+    _deploys.resize(deployCount);
+    for (auto& d : _deploys) {
+        d.tick = r.u32();
+        d.type = r.u8();
+        d.pos.x = r.f32();
+        d.pos.y = r.f32();
+    }
+
+    uint32_t hashCount = r.u32();
+    if (!r.need(static_cast<size_t>(hashCount) * 4)) return false;
+    _hashes.resize(hashCount);
+    for (auto& h : _hashes) h = r.u32();
+    return r.ok;
+}
+
+// =========================================================
+// 3. 回放
+// =========================================================
+
+BattleReplayPlayer::BattleReplayPlayer()
+    : _replay(nullptr)
+    , _cursor(0)
+    , _divergedTick(-1)
+{
+}
+
+void BattleReplayPlayer::start(const BattleReplay* replay, int fromTick)
+{
+    _replay = replay;
+    _cursor = 0;
+    _divergedTick = -1;
+    if (!_replay) return;
+
+    // 快照在第 fromTick 步的投放之前截取，因此只跳过更早的投放
+    const std::vector<BattleReplayDeploy>& deploys = _replay->deploys();
+    while (_cursor < deploys.size() && static_cast<int>(deploys[_cursor].tick) < fromTick) _cursor++;
+}
+
+int BattleReplayPlayer::applyDeploys(BattleWorld& world, int tick)
+{
+    if (!_replay) return 0;
+    const std::vector<BattleReplayDeploy>& deploys = _replay->deploys();
+    int deployed = 0;
+    while (_cursor < deploys.size() && static_cast<int>(deploys[_cursor].tick) <= tick) {
+        const BattleReplayDeploy& d = deploys[_cursor++];
+        if (world.deployUnit(static_cast<SoldierType>(d.type), d.pos) != BATTLE_INVALID_INDEX) deployed++;
+    }
+    return deployed;
+}
+
+bool BattleReplayPlayer::verify(const BattleWorld& world, int tick)
+{
+    uint32_t expected;
+    if (!_replay || !_replay->getHash(tick, expected)) return true;
+    if (world.computeStateHash() == expected) return true;
+    if (_divergedTick < 0) _divergedTick = tick;
+    return false;
+}
+
+int BattleReplayPlayer::fastForward(BattleWorld& world, int fromTick, int toTick)
+{
+    int tick = fromTick;
+    while (tick < toTick && world.getOutcome() == BattleOutcome::RUNNING) {
+        applyDeploys(world, tick);
+        world.step(_replay ? _replay->getStep() : BattleRules::SIMULATION_STEP);
+        ++tick;
+        verify(world, tick);
+    }
+    return tick;
+}
+
+bool BattleReplayPlayer::isFinished(int tick) const
+{
+    return !_replay || tick >= _replay->getTickCount();
+}
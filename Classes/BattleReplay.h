@@ -0,0 +1,179 @@
+/**
+ * @file       BattleReplay.h
+ * @brief      战斗录像：紧凑二进制格式、录制与确定性回放
+ * @details    战斗核心以固定步长推进且不依赖随机数与帧率，因此同一关卡、同一兵力、
+ *             同一组“第几步投放了什么兵、投在哪里”就能完全复现整场战斗。录像只保存这些输入：
+ *             关卡来源（PVE 关卡索引或 PVP 敌方 JSON）、各兵种兵力、按步号排列的投放记录；
+ *             另外按固定间隔保存整个战斗状态的哈希，回放时逐一比对，第一次不一致即判定分叉。
+ *             BattleReplayPlayer 负责把录像中的投放按步号交给 BattleWorld，并可直接快进到任意步（seek）
+ * @version    1.0
+ * @note       该文件无引擎依赖；文件读写由表现层完成，这里只负责与字节缓冲区之间的序列化。
+ *             多字节数值统一按小端序写入，浮点按 IEEE-754 位模式保存
+ */
+#ifndef BATTLE_REPLAY_H_
+#define BATTLE_REPLAY_H_
+
+#include <string>
+#include <vector>
+#include "BattleTypes.h"
+
+class BattleWorld;
+
+/**
+ * @struct     BattleReplayDeploy
+ * @brief      一次投放输入
+ * @details    tick 为投放发生时已推进的步数：回放时在推进第 tick + 1 步之前执行
+ */
+struct BattleReplayDeploy {
+    uint32_t tick;       ///< 投放时已推进的步数
+    uint8_t type;        ///< 兵种（SoldierType）
+    BattleVec2 pos;      ///< 投放位置（地图节点坐标）
+};
+
+/**
+ * @class      BattleReplay
+ * @brief      一场战斗的录像数据
+ */
+class BattleReplay
+{
+public:
+    /// 关卡来源
+    enum class Source : uint8_t {
+        CAMPAIGN = 0,   ///< PVE 关卡（Enemy_map%d.tmx）
+        PVP = 1         ///< PVP（敌方布局 JSON）
+    };
+
+    /// 当前文件格式版本（2：伤害改为步末统一结算；3：单位 AI 分级思考与分帧寻靶；4：兵群分离转向；5：炸弹人范围爆炸与加农炮溅射；6：兵营守军。旧录像的状态哈希不再适用）
+    static const uint16_t FORMAT_VERSION = 6;
+
+    /// 默认状态哈希间隔（步）：每步都保存
+    static const uint32_t DEFAULT_HASH_INTERVAL = 1;
+
+    BattleReplay();
+
+    /**
+     * @brief      开始一段新录像（清空之前的输入与哈希）
+     * @param      levelIndex   PVE 关卡索引（PVP 时为 0）
+     * @param      pvpJson      PVP 敌方布局 JSON（PVE 时为空）
+     * @param      step         模拟步长（秒），回放时用于校验
+     */
+    void begin(int levelIndex, const std::string& pvpJson, float step);
+
+    /// 记录某兵种的初始兵力
+    void setReserve(SoldierType type, int count);
+
+    /// 记录一次投放
+    void recordDeploy(int tick, SoldierType type, const BattleVec2& pos);
+
+    /**
+     * @brief      记录第 tick 步推进完成后的状态哈希（按间隔抽样）
+     * @param      tick  已推进的步数（从 1 开始）
+     * @param      hash  BattleWorld::computeStateHash 的结果
+     */
+    void recordHash(int tick, uint32_t hash);
+
+    /// 标记录像结束于第 tick 步
+    void finish(int tick) { _tickCount = static_cast<uint32_t>(tick); }
+
+    /**
+     * @brief      把录像截回第 tick 步（战斗回退到该步的快照时调用）
+     * @details    快照在推进第 tick 步之后、玩家下一次投放之前截取，因此丢弃步号不小于 tick 的投放
+     *             与第 tick 步之后的状态哈希，之后从该步继续录制
+     */
+    void rewindTo(int tick);
+
+    // ==========================================
+    // 查询
+    // ==========================================
+    Source getSource() const { return _source; }
+    int getLevelIndex() const { return _levelIndex; }
+    const std::string& getPvpJson() const { return _pvpJson; }
+    int getReserve(SoldierType type) const;
+    float getStep() const { return _step; }
+    int getTickCount() const { return static_cast<int>(_tickCount); }
+    uint32_t getHashInterval() const { return _hashInterval; }
+    const std::vector<BattleReplayDeploy>& deploys() const { return _deploys; }
+
+    /**
+     * @brief      查询第 tick 步的录制哈希
+     * @param      tick  已推进的步数（从 1 开始）
+     * @param      out   输出哈希
+     * @return     bool  该步有录制哈希返回 true
+     */
+    bool getHash(int tick, uint32_t& out) const;
+
+    // ==========================================
+    // 序列化
+    // ==========================================
+
+    /// 序列化为字节缓冲区
+    void serialize(std::vector<uint8_t>& out) const;
+
+    /**
+     * @brief      从字节缓冲区解析
+     * @return     bool  魔数、版本或长度不合法时返回 false（此时内容未定义）
+     */
+    bool deserialize(const uint8_t* data, size_t size);
+
+private:
+    Source _source;                            ///< 关卡来源
+    int _levelIndex;                           ///< PVE 关卡索引
+    std::string _pvpJson;                      ///< PVP 敌方布局 JSON
+    int _reserve[BATTLE_SOLDIER_TYPE_COUNT];   ///< 各兵种初始兵力
+    float _step;                               ///< 模拟步长
+    uint32_t _hashInterval;                    ///< 状态哈希间隔（步）
+    uint32_t _tickCount;                       ///< 录像总步数
+    std::vector<BattleReplayDeploy> _deploys;  ///< 投放记录（按步号递增）
+    std::vector<uint32_t> _hashes;             ///< 第 (i + 1) * _hashInterval 步的状态哈希
+};
+
+/**
+ * @class      BattleReplayPlayer
+ * @brief      按录像驱动 BattleWorld
+ * @details    使用流程：world.loadLevel() 并按录像设置兵力 -> start(replay) ->
+ *             每推进一步前调用 applyDeploys(world, tick)，推进后调用 verify(world, tick)；
+ *             或直接 fastForward(world, tick) 静默推进到目标步
+ */
+class BattleReplayPlayer
+{
+public:
+    BattleReplayPlayer();
+
+    /**
+     * @brief      绑定录像（录像对象需在回放期间保持有效）
+     * @param      replay    录像
+     * @param      fromTick  起始步：从第 0 步开始回放，或从该步的快照恢复后继续（跳过更早的投放）
+     */
+    void start(const BattleReplay* replay, int fromTick = 0);
+
+    /**
+     * @brief      执行所有在第 tick 步（已推进步数）发生的投放
+     * @return     int  实际投放成功的数量
+     */
+    int applyDeploys(BattleWorld& world, int tick);
+
+    /**
+     * @brief      校验第 tick 步推进完成后的状态哈希
+     * @return     bool  一致或该步无录制哈希返回 true；不一致返回 false 并记录首次分叉步
+     */
+    bool verify(const BattleWorld& world, int tick);
+
+    /**
+     * @brief      从第 fromTick 步静默推进到第 toTick 步（投放与哈希校验照常进行）
+     * @return     int  实际推进到的步数（战斗提前结束时小于 toTick）
+     */
+    int fastForward(BattleWorld& world, int fromTick, int toTick);
+
+    /// 首次分叉的步号；未分叉为 -1
+    int getDivergedTick() const { return _divergedTick; }
+
+    /// 回放是否已到录像末尾
+    bool isFinished(int tick) const;
+
+private:
+    const BattleReplay* _replay;   ///< 录像
+    size_t _cursor;                ///< 下一条待执行的投放记录
+    int _divergedTick;             ///< 首次分叉步
+};
+
+#endif // BATTLE_REPLAY_H_
@@ -0,0 +1,81 @@
+/**
+ * @file       BattleRules.cpp
+ * @brief      战斗规则常量与评分函数的实现
+ * @details    兵种属性表的数值与原 OriginalSoldier / ArrowSoldier / BoomSoldier / GiantSoldier /
+ *             AirforceSoldier 的 setupProperties 保持一致
+ * @version    1.0
+ */
+#include "BattleRules.h"
+#include <algorithm>
+
+namespace BattleRules {
+
+const BattleUnitStats& unitStats(SoldierType type)
+{
+    // 按 SoldierType 顺序排列：maxHp, damage, range, interval, speed, halfSize, flying, attackKind
+    static const BattleUnitStats TABLE[BATTLE_SOLDIER_TYPE_COUNT] = {
+        { 75,  4, 80.0f,  1.0f, 80.0f, 24.0f, false, BattleAttackKind::MELEE   }, // ORIGINAL
+        { 60,  8, 250.0f, 1.0f, 80.0f, 24.0f, false, BattleAttackKind::ARROW   }, // ARROW
+        { 150, 20, 50.0f, 1.0f, 80.0f, 24.0f, false, BattleAttackKind::SUICIDE }, // BOOM
+        { 100, 3, 80.0f,  1.0f, 80.0f, 24.0f, false, BattleAttackKind::MELEE   }, // GIANT
+        { 50,  6, 80.0f,  1.0f, 80.0f, 24.0f, true,  BattleAttackKind::MELEE   }  // AIRFORCE
+    };
+    int index = static_cast<int>(type);
+    if (index < 0 || index >= BATTLE_SOLDIER_TYPE_COUNT) index = 0;
+    return TABLE[index];
+}
+
+float targetBias(SoldierType soldier, EnemyType target)
+{
+    if (soldier == SoldierType::AIRFORCE) {
+        // 空军：无视围墙，优先加农炮，其次防御塔
+        if (target == EnemyType::WALL) return 1000000.0f;
+        if (target == EnemyType::CANNON) return -5000.0f;
+        if (target == EnemyType::TOWER) return -2000.0f;
+        return 0.0f;
+    }
+    if (soldier == SoldierType::GIANT) {
+        // 巨人：讨厌围墙，优先防御塔与加农炮
+        if (target == EnemyType::WALL) return 10000.0f;
+        if (target == EnemyType::CANNON || target == EnemyType::TOWER) return -5000.0f;
+        return 0.0f;
+    }
+    // 其他陆军：讨厌围墙，除非挡路否则不选择
+    if (target == EnemyType::WALL) return 10000.0f;
+    return 0.0f;
+}
+
+bool towerCanHit(EnemyType tower, bool flying)
+{
+    if (tower == EnemyType::TOWER) return !flying;
+    return true;
+}
+
+bool towerPrefersAir(EnemyType tower)
+{
+    return tower == EnemyType::CANNON;
+}
+
+bool fightsUnits(SoldierType soldier)
+{
+    return soldier != SoldierType::GIANT && soldier != SoldierType::BOOM;
+}
+
+bool canHitUnit(SoldierType soldier, bool flying)
+{
+    if (!flying) return true;
+    return soldier == SoldierType::ARROW || soldier == SoldierType::AIRFORCE;
+}
+
+int barracksGarrison(int level)
+{
+    // 1 级 4 个，每升一级多 2 个，最多 20 个
+    return std::min(2 + std::max(level, 1) * 2, 20);
+}
+
+SoldierType defenderType(int releaseIndex)
+{
+    return releaseIndex % 2 == 0 ? SoldierType::ORIGINAL : SoldierType::ARROW;
+}
+
+} // namespace BattleRules
@@ -0,0 +1,173 @@
+/**
+ * @file       BattleRules.h
+ * @brief      战斗规则常量与评分函数
+ * @details    集中存放原先分散在各 Soldier 子类、EnemyBuilding 中的数值与规则：
+ *             兵种属性表、弹道速度、士兵寻靶的类型偏好评分、防御建筑的对空/对地规则，
+ *             供 BattleWorld 与表现层共同引用，保证数值只有一个来源
+ * @version    1.0
+ * @note       该文件无引擎依赖
+ */
+#ifndef BATTLE_RULES_H_
+#define BATTLE_RULES_H_
+
+#include "BattleTypes.h"
+
+namespace BattleRules {
+
+/// 模拟固定步长（秒，30 Hz）；士兵、防御建筑、陷阱与弹道都只按该步长推进
+const float SIMULATION_STEP = 1.0f / 30.0f;
+
+/// 单帧最多推进的模拟步数（4 倍速下约可吸收 0.27 秒的卡顿）
+const int MAX_STEPS_PER_FRAME = 32;
+
+/// 弓箭飞行速度（像素/秒，原 ArrowSoldier::attackTarget）
+const float ARROW_SPEED = 800.0f;
+
+/// 炮弹飞行速度（像素/秒，原 EnemyBuilding::fireMissile）
+const float CANNONBALL_SPEED = 400.0f;
+
+/// 防御建筑攻击间隔（秒）
+const float TOWER_COOLDOWN = 1.0f;
+
+/// 陆军被阻挡时搜索围墙的最大距离（像素，原 Soldier::findNearestWall）
+const float WALL_SEARCH_RADIUS = 100.0f;
+
+/// 攻击范围超过该值视为远程单位，被阻挡但已在射程内时原地攻击
+const float RANGED_THRESHOLD = 150.0f;
+
+/// 单位空间网格的格子边长（像素，4 个瓦片；弓箭塔 250 射程约覆盖 5x5 个格子）
+const float UNIT_GRID_CELL_SIZE = 128.0f;
+
+/// 士兵寻靶建筑索引的格子边长（像素，4 个瓦片）
+const float TARGET_INDEX_CELL_SIZE = 128.0f;
+
+/// 陆军流场中围墙每点血量折算的额外通行代价（以瓦片为单位，40 血的围墙约等于绕行 10 格）
+const float WALL_PATH_COST_PER_HP = 0.25f;
+
+/// 弹道对象池的初始槽位数（同时飞行的箭与炮弹超过该数量时自动扩容）
+const int PROJECTILE_POOL_CAPACITY = 256;
+
+/// 投放判定矩形的半边长（原 trySpawnSoldier 中 20x20 的矩形）
+const float DEPLOY_HALF_EXTENT = 10.0f;
+
+/// 存活单位达到该数量时才把单位 / 防御建筑的思考阶段交给任务系统并行（更少时线程调度开销大于收益）
+const int PARALLEL_MIN_UNITS = 128;
+
+/// 并行思考阶段每个任务块最少处理的实体数
+const int PARALLEL_GRAIN = 32;
+
+/// 每步最多为多少个目标失效的单位重新寻靶，其余顺延到后续步（BattleAiScheduler）
+const int AI_RETARGET_BUDGET = 24;
+
+/// 离目标较远的移动单位每隔多少步完整思考一次，其余步沿上一步方向前进
+const int AI_FAR_THINK_INTERVAL = 4;
+
+/// 单位与目标的距离超出攻击范围该值时视为“较远”（像素，10 个瓦片）
+const float AI_FAR_DISTANCE = 320.0f;
+
+/// 分离转向邻居网格的格子边长（像素，1 个瓦片；须不小于两单位的最大间距，3x3 个格子才能覆盖全部邻居）
+const float SEPARATION_CELL_SIZE = 32.0f;
+
+/// 两单位希望保持的间距 = 两者碰撞盒半边长之和 * 该系数（现有兵种均为 24 像素）
+const float SEPARATION_SPACING_SCALE = 0.5f;
+
+/// 每步消除重叠量的比例（双方各承担一半）
+const float SEPARATION_STIFFNESS = 0.5f;
+
+/// 分离推力造成的最大移动速度（像素/秒，低于士兵移动速度，不会压过寻路方向）
+const float SEPARATION_MAX_SPEED = 60.0f;
+
+/// 每步分离转向最多检查的单位对数，超出的单位顺延到下一步（BattleCrowdSeparation）
+const int SEPARATION_PAIR_BUDGET = 16384;
+
+/// 炸弹人自爆的爆炸半径（像素，2 个瓦片）：占地与爆炸范围相交的建筑都受到自爆伤害
+const float BOOM_BLAST_RADIUS = 64.0f;
+
+/// 加农炮炮弹的溅射半径（像素，1.5 个瓦片）；由表现层写入 BattleLevelDesc::cannonSplashRadius 启用
+const float CANNON_SPLASH_RADIUS = 48.0f;
+
+/// 进攻方单位进入该距离（像素，8 个瓦片）时兵营开始释放守军
+const float BARRACKS_ALERT_RADIUS = 256.0f;
+
+/// 兵营释放守军的间隔（秒）
+const float DEFENDER_RELEASE_INTERVAL = 0.5f;
+
+/// 守军搜索进攻方单位的视野半径（像素）
+const float DEFENDER_SIGHT_RADIUS = 320.0f;
+
+/// 守军离兵营超过该距离且没有敌人时返回兵营（像素）
+const float DEFENDER_LEASH_RADIUS = 96.0f;
+
+/// 守军在最近的多少个敌人中挑选血量最低者集火
+const int DEFENDER_TARGET_K = 4;
+
+/// 进攻方单位与守军交战的最小距离（像素）；远程单位以射程为准
+const float UNIT_AGGRO_RADIUS = 96.0f;
+
+/**
+ * @brief      获取兵种固有属性
+ * @param      type  兵种
+ * @return     const BattleUnitStats&  属性表中的对应项
+ */
+const BattleUnitStats& unitStats(SoldierType type);
+
+/**
+ * @brief      士兵寻靶时对建筑类型的评分偏置（分数越低优先级越高）
+ * @details    原 Soldier::findNewTarget 中的硬编码规则：空军偏好加农炮、巨人偏好防御塔、所有兵种回避围墙；
+ *             最终评分 = 距离 + 偏置
+ * @param      soldier  兵种
+ * @param      target   建筑类型
+ * @return     float    评分偏置
+ */
+float targetBias(SoldierType soldier, EnemyType target);
+
+/**
+ * @brief      判断防御建筑是否会攻击指定类别的单位
+ * @details    加农炮优先攻击空中单位、其次地面单位；弓箭塔只打地面；其余攻击建筑不区分
+ * @param      tower   建筑类型
+ * @param      flying  单位是否为飞行单位
+ * @return     bool    可以攻击返回 true
+ */
+bool towerCanHit(EnemyType tower, bool flying);
+
+/**
+ * @brief      判断防御建筑是否优先攻击空中单位
+ * @param      tower  建筑类型
+ * @return     bool   加农炮返回 true
+ */
+bool towerPrefersAir(EnemyType tower);
+
+/**
+ * @brief      进攻方兵种是否会与守军交战
+ * @details    巨人只攻击防御建筑、炸弹人只找围墙与建筑，二者无视守军
+ * @param      soldier  兵种
+ * @return     bool     会交战返回 true
+ */
+bool fightsUnits(SoldierType soldier);
+
+/**
+ * @brief      判断兵种能否攻击指定类别的单位
+ * @details    弓箭手与空军可以攻击空中单位，其余兵种只能攻击地面单位
+ * @param      soldier  兵种
+ * @param      flying   目标是否为飞行单位
+ * @return     bool     可以攻击返回 true
+ */
+bool canHitUnit(SoldierType soldier, bool flying);
+
+/**
+ * @brief      按等级计算兵营驻守的守军数量
+ * @param      level  兵营等级
+ * @return     int    守军数量
+ */
+int barracksGarrison(int level);
+
+/**
+ * @brief      兵营第 n 个释放的守军的兵种（野蛮人与弓箭手交替）
+ * @param      releaseIndex  已释放的守军数量
+ * @return     SoldierType   兵种
+ */
+SoldierType defenderType(int releaseIndex);
+
+} // namespace BattleRules
+
+#endif // BATTLE_RULES_H_
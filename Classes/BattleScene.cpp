@@ -2,8 +2,9 @@
  * @file       BattleScene.cpp
  * @brief      战斗场景核心类实现文件
  * @details    该文件实现了 BattleScene 头文件声明的所有功能，包括场景生命周期管理、PVE/PVP 关卡加载、
- *             士兵召唤与AI调度、敌方建筑管理、游戏状态判断、UI交互与触摸事件处理等核心逻辑，
- *             是战斗流程的主控实现，协调地图、士兵、敌方建筑、陷阱等模块的交互，支持战斗音乐与弹窗特效
+ *             士兵召唤、战斗核心驱动与表现同步、游戏状态判断、UI交互与触摸事件处理等核心逻辑，
+ *             关卡加载时把地图对象整理为 BattleLevelDesc 交给 BattleWorld，战斗中每帧推进核心并消费其事件，
+ *             协调地图、士兵、敌方建筑、陷阱等精灵的表现，支持战斗音乐与弹窗特效
  * @version    1.0
  * @note       该文件依赖 GameScene、EnemyBuilding 等模块；保留原有业务逻辑，仅修正乱码与补充注释，
  *             弹窗创建未设置节点名称，导致 `hideVictoryPopup` 按名移除失效，可后续优化节点命名
@@ -17,6 +18,10 @@
 #include "SharedData.h"
 #include "json/document.h"
 #include "SaveGame.h"
+#include "BattleRules.h"
+#include "TroopAnimationRegistry.h"
+#include "BattleJobSystem.h"
+#include "BattleCheckpointWriter.h"
 
 USING_NS_CC;
 extern int coin_count;
@@ -29,6 +34,36 @@ extern int gem_limit;
 
 #include "AudioEngine.h"
 
+namespace {
+
+/// 快照环形缓冲：每 30 步（1 秒）截取一次，保留最近 10 秒
+const int SNAPSHOT_INTERVAL_TICKS = 30;
+const int SNAPSHOT_RING_CAPACITY = 10;
+
+/// 续玩存档写盘间隔（步）：进程意外退出时最多丢失 5 秒的战斗
+const int CHECKPOINT_INTERVAL_TICKS = 150;
+
+/// 续玩存档写盘器：帧内定期存档在后台线程写盘，进程内唯一，跨场景保证写入与删除的先后顺序
+BattleCheckpointWriter& checkpointWriter()
+{
+    static BattleCheckpointWriter writer;
+    return writer;
+}
+
+/// 调试回退的步数（3 秒）
+const int REWIND_TICKS = 90;
+
+/// 视野剔除的边距（地图像素）：士兵精灵放大 3 倍、血条在头顶，建筑血条在建筑上方，爆炸特效最大放大 5 倍
+const float UNIT_CULL_MARGIN = 96.0f;
+const float STATIC_CULL_MARGIN = 64.0f;
+const float PROJECTILE_CULL_MARGIN = 32.0f;
+const float VFX_CULL_MARGIN = 160.0f;
+
+/// 触摸位移小于该值（像素）且尚未开始拖动时视为点击，不拖动地图（与 GameScene 一致）
+const float MAP_DRAG_THRESHOLD = 2.0f;
+
+} // namespace
+
 // ==========================================
 // 场景生命周期：进入场景回调
 // ==========================================
@@ -64,8 +99,19 @@ bool BattleScene::init()
     // 基础成员变量初始化，避免空指针异常
     _tileMap = nullptr;
     _base = nullptr;
+    _forbiddenOverlay = nullptr;
+    _speedLabel = nullptr;
+    _destructionLabel = nullptr;
+    _replayLabel = nullptr;
+    _isReplayMode = false;
+    _isResumed = false;
+    _lastCheckpointTick = 0;
+    _shownDestruction = -1;
+    _projectileLayer = nullptr;
+    _vfx = nullptr;
     _isGameOver = false;
     _isGamePaused = false;
+    _isDraggingMap = false;
     return true;
 }
 
@@ -88,6 +134,139 @@ Scene* BattleScene::createScene(int levelIndex, std::string pvpJsonData)
     return scene;
 }
 
+/**
+ * @brief      解析关卡描述（不进入战斗）
+ * @details    创建一个临时场景，按关卡来源调用与 setupBattle 相同的加载函数，取出其关卡描述；
+ *             临时场景不会被运行，随自动释放池一起释放
+ * @param      levelIndex   PVE 关卡索引（大于 0 有效）；为 0 时按 PVP 布局解析
+ * @param      pvpJsonData  PVP 敌方配置 JSON 字符串
+ * @param      out          输出的关卡描述
+ * @return     bool  地图加载失败或没有任何建筑时返回 false
+ */
+bool BattleScene::describeLevel(int levelIndex, const std::string& pvpJsonData, BattleLevelDesc& out)
+{
+    auto scene = BattleScene::create();
+    if (!scene) return false;
+
+    if (levelIndex > 0) {
+        scene->_mapFileName = StringUtils::format("Enemy_map%d.tmx", levelIndex);
+        scene->loadLevelCampaign(levelIndex);
+    }
+    else {
+        scene->_mapFileName = "Grass.tmx";
+        scene->loadLevelPVP(pvpJsonData);
+    }
+    if (!scene->_tileMap || scene->_levelDesc.buildings.empty()) return false;
+
+    out = scene->_levelDesc;
+    return true;
+}
+
+/**
+ * @brief      创建录像回放场景
+ * @details    与 createScene 相同地创建场景，再由 setupReplay 按录像载入关卡并快进到起始步
+ * @param      replay     录像数据
+ * @param      startTick  起始步数
+ * @param      speed      回放倍速
+ * @return     Scene*  回放场景指针
+ */
+Scene* BattleScene::createReplayScene(const BattleReplay& replay, int startTick, float speed)
+{
+    auto scene = BattleScene::create();
+    if (scene) {
+        scene->setupReplay(replay, startTick, speed);
+    }
+    return scene;
+}
+
+/**
+ * @brief      从录像文件创建回放场景
+ * @param      path  录像文件路径
+ * @return     Scene*  文件缺失或格式不合法时返回 nullptr
+ */
+Scene* BattleScene::createReplayScene(const std::string& path)
+{
+    Data data = FileUtils::getInstance()->getDataFromFile(path);
+    if (data.isNull()) return nullptr;
+
+    BattleReplay replay;
+    if (!replay.deserialize(data.getBytes(), static_cast<size_t>(data.getSize()))) {
+        log("Replay file is invalid: %s", path.c_str());
+        return nullptr;
+    }
+    return createReplayScene(replay);
+}
+
+/**
+ * @brief      最近一场战斗的录像文件路径
+ * @return     std::string  可写目录下的 last_battle.replay
+ */
+std::string BattleScene::getLastReplayPath()
+{
+    return FileUtils::getInstance()->getWritablePath() + "last_battle.replay";
+}
+
+/**
+ * @brief      从续玩存档恢复被中断的战斗
+ * @param      path  存档文件路径
+ * @return     Scene*  文件缺失或格式不合法时返回 nullptr
+ */
+Scene* BattleScene::createResumeScene(const std::string& path)
+{
+    Data data = FileUtils::getInstance()->getDataFromFile(path);
+    if (data.isNull()) return nullptr;
+
+    BattleReplay replay;
+    BattleSnapshot snapshot;
+    if (!BattleCheckpoint::read(data.getBytes(), static_cast<size_t>(data.getSize()), replay, snapshot)) {
+        log("Checkpoint file is invalid: %s", path.c_str());
+        return nullptr;
+    }
+    return createResumeScene(replay, snapshot);
+}
+
+/**
+ * @brief      以录像与快照创建恢复后的战斗场景
+ * @param      replay    截止到快照所在步的录像
+ * @param      snapshot  要恢复的快照
+ * @return     Scene*  恢复后的战斗场景
+ */
+Scene* BattleScene::createResumeScene(const BattleReplay& replay, const BattleSnapshot& snapshot)
+{
+    auto scene = BattleScene::create();
+    if (scene) {
+        scene->setupResume(replay, snapshot);
+    }
+    return scene;
+}
+
+/**
+ * @brief      续玩存档路径
+ * @return     std::string  可写目录下的 battle_checkpoint.bin
+ */
+std::string BattleScene::getCheckpointPath()
+{
+    return FileUtils::getInstance()->getWritablePath() + "battle_checkpoint.bin";
+}
+
+/**
+ * @brief      是否存在未结束战斗的续玩存档
+ */
+bool BattleScene::hasCheckpoint()
+{
+    return FileUtils::getInstance()->isFileExist(getCheckpointPath());
+}
+
+/**
+ * @brief      为正在运行的战斗写入续玩存档
+ * @details    切到后台时进程随时可能被系统回收，这里立即截取快照写盘，恢复时从该步继续
+ */
+void BattleScene::saveRunningCheckpoint()
+{
+    auto scene = dynamic_cast<BattleScene*>(Director::getInstance()->getRunningScene());
+    if (scene) scene->saveCheckpoint(true);
+}
+
 /**
  * @brief      战斗场景业务初始化核心方法
  * @details    先做防御性检查避免重复初始化，再根据关卡索引区分 PVE/PVP 模式，
@@ -124,14 +303,37 @@ void BattleScene::setupBattle(int levelIndex, std::string pvpJsonData)
         return;
     }
 
-    // 2. 初始化战斗场景 UI（士兵选择 UI、提示标签等）
+    // 2. 把加载阶段收集的关卡描述交给战斗核心，并从零开始计时
+    _world.loadLevel(_levelDesc);
+    _clock.reset();
+#if (CC_TARGET_PLATFORM == CC_PLATFORM_WIN32) || (CC_TARGET_PLATFORM == CC_PLATFORM_MAC) || (CC_TARGET_PLATFORM == CC_PLATFORM_LINUX)
+    // 桌面平台把单位 / 防御建筑的思考阶段分发到工作线程（结果与单线程逐位一致，录像照常可回放）
+    _world.setJobSystem(BattleJobSystem::getInstance());
+#endif
+    // 正常战斗从这里开始录像（回放模式下 _replay 为正在播放的录像）
+    // 由快照恢复时录像沿用存档中的时间线
+    if (!_isReplayMode && !_isResumed) _replay.begin(levelIndex, pvpJsonData, _clock.getStep());
+    if (!_isReplayMode) _snapshots.configure(SNAPSHOT_RING_CAPACITY, SNAPSHOT_INTERVAL_TICKS);
+
+    // 弹道渲染层挂在地图上，位于建筑与士兵之上
+    _projectileLayer = BattleProjectileLayer::create();
+    _tileMap->addChild(_projectileLayer, 6);
+
+    // 特效层挂在地图上并位于最上层，爆炸动画在此时注册到 AnimationCache
+    _vfx = BattleVfxManager::create();
+    _tileMap->addChild(_vfx, 999);
+
+    // 兵种行走 / 待机 / 攻击动画一次性注册，之后士兵状态切换只重新运行缓存的动作
+    TroopAnimationRegistry::preload();
+    _soldierPool.setScene(this);
+
+    // 3. 初始化战斗场景 UI（士兵选择 UI、提示标签等），同时设置核心中的可投放兵力并预热士兵对象池
     this->createUI();
 
-    // 3. 初始化禁止区域渲染层，用于绘制红色禁止放置区域
-    _forbiddenAreaNode = DrawNode::create();
-    this->addChild(_forbiddenAreaNode, 10);
+    // 4. 把红色禁止放置区域一次性渲染到缓存纹理，放置模式下只切换显示
+    this->createForbiddenOverlay();
 
-    // 4. 绑定触摸监听器，处理玩家触摸交互（士兵选择、放置等）
+    // 5. 绑定触摸监听器，处理玩家触摸交互（士兵选择、放置、拖动地图等），滚轮缩放地图
     auto listener = EventListenerTouchOneByOne::create();
     listener->setSwallowTouches(true);
     listener->onTouchBegan = CC_CALLBACK_2(BattleScene::onTouchBegan, this);
@@ -139,23 +341,43 @@ void BattleScene::setupBattle(int levelIndex, std::string pvpJsonData)
     listener->onTouchEnded = CC_CALLBACK_2(BattleScene::onTouchEnded, this);
     _eventDispatcher->addEventListenerWithSceneGraphPriority(listener, this);
 
-    // 5. 添加返回按钮，支持返回游戏主场景
+    auto mouseListener = EventListenerMouse::create();
+    mouseListener->onMouseScroll = CC_CALLBACK_1(BattleScene::onMouseScroll, this);
+    _eventDispatcher->addEventListenerWithSceneGraphPriority(mouseListener, this);
+
+    // 6. 添加返回按钮，支持返回游戏主场景
     auto backLabel = Label::createWithTTF("Back", "fonts/Marker Felt.ttf", 28);
     auto backItem = MenuItemLabel::create(backLabel, CC_CALLBACK_1(BattleScene::menuBackToGameScene, this));
     backItem->setPosition(Vec2(origin.x + 50, origin.y + visibleSize.height - 30));
-    auto menu = Menu::create(backItem, NULL);
+
+    // 7. 添加倍速按钮（1x / 2x / 4x 循环切换）
+    _speedLabel = Label::createWithTTF("1x", "fonts/Marker Felt.ttf", 28);
+    auto speedItem = MenuItemLabel::create(_speedLabel, CC_CALLBACK_1(BattleScene::menuToggleSpeed, this));
+    speedItem->setPosition(Vec2(origin.x + 130, origin.y + visibleSize.height - 30));
+
+    auto menu = Menu::create(backItem, speedItem, NULL);
     menu->setPosition(Vec2::ZERO);
     this->addChild(menu, 100);
 
-    // 6. 开启帧更新调度，驱动战斗逻辑（士兵 AI、建筑逻辑等）
+#if COCOS2D_DEBUG > 0
+    // 调试：回退 3 秒（从快照环形缓冲恢复）
+    if (!_isReplayMode) {
+        auto rewindItem = MenuItemLabel::create(Label::createWithTTF("Rewind", "fonts/Marker Felt.ttf", 28),
+            [this](Ref*) { this->rewindBattle(REWIND_TICKS); });
+        rewindItem->setPosition(Vec2(origin.x + 220, origin.y + visibleSize.height - 30));
+        menu->addChild(rewindItem);
+    }
+#endif
+
+    // 8. 开启帧更新调度，驱动战斗核心
     this->scheduleUpdate();
 }
 
 /**
  * @brief      场景帧更新函数实现（重写父类方法）
  * @details    每帧调用，先判断游戏是否结束或暂停，若处于结束/暂停状态则直接返回；
- *             再检查游戏结束条件，处理陷阱触发逻辑，更新士兵 AI 与敌方建筑逻辑，
- *             移除死亡士兵，完成战斗场景的帧级调度
+ *             再由固定步长时钟决定本帧推进战斗核心的步数（弹道、陷阱、士兵 AI、防御建筑、胜负判定均在核心内完成），
+ *             然后把核心事件与状态同步到精灵，最后检查核心给出的战斗结果
  * @param      dt  帧间隔时间（秒），用于时间相关逻辑计算
  * @override   cocos2d::Node::update
  */
@@ -164,64 +386,423 @@ void BattleScene::update(float dt)
     // 游戏结束或暂停时，停止执行所有战斗逻辑
     if (_isGameOver || _isGamePaused) return;
 
-    // 检查游戏是否满足胜利/失败条件
-    checkGameEnd();
+    // 1. 由固定步长时钟换算本帧的步数，按固定步长推进战斗核心
+    const int steps = _clock.advance(dt);
+    int tick = _clock.getTickCount() - steps;
+    for (int i = 0; i < steps; ++i) {
+        if (_isReplayMode) {
+            // 回放：到达录像末尾即停止；推进前执行本步的投放
+            if (_replayPlayer.isFinished(tick)) break;
+            _replayPlayer.applyDeploys(_world, tick);
+        }
+        _world.step(_clock.getStep());
+        ++tick;
 
-    // 游戏已结束，直接返回，避免后续逻辑执行
-    if (_isGameOver) return;
+        // 正常战斗按步录制状态哈希并定期截取快照，回放时逐步比对
+        if (_isReplayMode) {
+            _replayPlayer.verify(_world, tick);
+        }
+        else {
+            _replay.recordHash(tick, _world.computeStateHash());
+            _snapshots.tryCapture(_world, tick);
+        }
+    }
 
-    // 处理陷阱触发逻辑，移除已触发的陷阱
-    if (!_traps.empty()) {
-        for (auto it = _traps.begin(); it != _traps.end(); ) {
-            auto trap = *it;
+    // 定期写入续玩存档，进程意外退出后可从最近的存档恢复
+    if (!_isReplayMode && _clock.getTickCount() - _lastCheckpointTick >= CHECKPOINT_INTERVAL_TICKS) {
+        saveCheckpoint(false);
+    }
 
-            // 检查陷阱是否被士兵触发
-            bool triggered = trap->checkTrigger(_soldiers);
+    // 2. 消费核心事件并同步士兵、建筑、陷阱精灵（士兵位置在两步之间插值）
+    syncBattleViews();
+    if (_isReplayMode) updateReplayLabel();
 
-            if (triggered) {
-                // 陷阱触发后，从陷阱列表中移除（避免重复触发）
-                it = _traps.erase(it);
-            }
-            else {
-                ++it;
-            }
+    // 3. 检查核心给出的胜利/失败结果
+    checkGameEnd();
+}
+
+/**
+ * @brief      同步战斗核心到表现层
+ * @details    按事件发生顺序为新投放的单位创建精灵，播放攻击反馈、爆炸等特效，刷新建筑血条与摧毁表现，
+ *             把阵亡士兵的精灵回收到对象池；最后同步所有存活士兵的位置、朝向、状态与血量，
+ *             并由弹道渲染层直接读取核心弹道池摆放箭与炮弹。
+ *             视野外的士兵、弹道与特效不显示也不更新动画，每帧的表现开销只与视野内的内容有关
+ */
+void BattleScene::syncBattleViews()
+{
+    const BattleBuildingStore& buildings = _world.buildings();
+    const int buildingViewCount = static_cast<int>(_buildingViews.size());
+    const int unitViewCount = static_cast<int>(_unitViews.size());
+    if (_vfx) _vfx->setViewRect(_camera.getViewRect(VFX_CULL_MARGIN));
+
+    for (const auto& e : _world.events()) {
+        Soldier* soldier = (e.a >= 0 && e.a < unitViewCount) ? _unitViews[e.a] : nullptr;
+        EnemyBuilding* building = (e.a >= 0 && e.a < buildingViewCount) ? _buildingViews[e.a] : nullptr;
+
+        switch (e.type) {
+            case BattleEventType::UNIT_DEPLOYED:
+                // 玩家投放与录像回放的投放都由事件创建精灵
+                spawnSoldierView(e.a);
+                if (_isReplayMode) refreshSoldierCounts();
+                break;
+            case BattleEventType::UNIT_ATTACKED:
+                if (soldier && soldier->isVisible()) soldier->playAttackEffect();
+                break;
+            case BattleEventType::UNIT_EXPLODED:
+                if (soldier) soldier->playExplodeEffect(_vfx);
+                break;
+            case BattleEventType::BUILDING_DAMAGED:
+                if (building) building->syncHp(buildings.hp[e.a]);
+                break;
+            case BattleEventType::BUILDING_DESTROYED:
+                if (building) building->playDestroyedEffect(_vfx);
+                updateDestructionLabel();
+                break;
+            case BattleEventType::TRAP_EXPLODED:
+                if (e.a >= 0 && e.a < static_cast<int>(_traps.size())) _traps.at(e.a)->playExplosionEffect(_vfx);
+                break;
+            case BattleEventType::SPLASH_EXPLODED:
+                if (_vfx) _vfx->playExplosion(Vec2(e.pos.x, e.pos.y), 1.0f);
+                break;
+            case BattleEventType::UNIT_DIED:
+                // 阵亡士兵从场景与列表中移除并放回对象池，索引位置置空
+                if (soldier) {
+                    _soldierPool.release(soldier);
+                    _soldiers.eraseObject(soldier);
+                    _unitViews[e.a] = nullptr;
+                }
+                break;
+            default:
+                break;
+        }
+    }
+    _world.clearEvents();
+
+    // 建筑与装饰物不会移动，只在相机移动后重新剔除
+    if (_camera.consumeMoved()) cullStaticViews();
+
+    // 同步存活士兵：视野外的士兵隐藏并暂停动画，不逐帧同步，回到视野时一次性追上核心状态
+    const float alpha = _clock.getAlpha();
+    const BattleUnitStore& units = _world.units();
+    const Rect unitView = _camera.getViewRect(UNIT_CULL_MARGIN);
+    for (auto soldier : _soldiers) {
+        const int i = soldier->getUnitIndex();
+        const bool inView = unitView.containsPoint(Vec2(units.x[i], units.y[i]));
+        if (inView != soldier->isVisible()) {
+            soldier->setVisible(inView);
+            if (inView) soldier->resume();
+            else soldier->pause();
         }
+        if (inView) soldier->syncWithWorld(_world, alpha);
     }
 
-    // **士兵 AI 逻辑更新**：遍历士兵列表，更新存活士兵 AI，移除死亡士兵
-    auto soldierIt = _soldiers.begin();
-    while (soldierIt != _soldiers.end())
-    {
-        auto soldier = *soldierIt;
+    // 同步飞行中的弹道（与士兵取同一渲染时刻）
+    if (_projectileLayer) {
+        _projectileLayer->syncWithWorld(_world, (1.0f - alpha) * _clock.getStep(),
+            _camera.getViewRect(PROJECTILE_CULL_MARGIN));
+    }
+}
 
-        // 1. 更新士兵 AI 逻辑（寻靶、移动、攻击等）
-        soldier->update(dt);
+/**
+ * @brief      按相机视野剔除建筑与装饰物
+ * @details    建筑（含已摧毁的灰色建筑）与装饰物的包围盒与视野不相交时隐藏；
+ *             只在相机平移 / 缩放后调用，静止时不做任何判定
+ */
+void BattleScene::cullStaticViews()
+{
+    const Rect view = _camera.getViewRect(STATIC_CULL_MARGIN);
+    for (EnemyBuilding* building : _buildingViews) {
+        if (building) building->setVisible(view.intersectsRect(building->getBoundingBox()));
+    }
+    for (Node* decoration : _decorations) {
+        decoration->setVisible(view.intersectsRect(decoration->getBoundingBox()));
+    }
+}
 
-        // 2. 检查士兵是否死亡（生命值 <= 0）
-        if (soldier->getCurrentHp() <= 0)
-        {
-            // 从场景中移除士兵节点
-            soldier->removeFromParent();
+/**
+ * @brief      倍速按钮回调
+ * @details    倍速在 1x -> 2x -> 4x -> 1x 之间循环（回放模式可到 8x）；模拟仍以固定步长推进，只是每帧推进的步数不同
+ * @param      pSender  按钮触发对象指针（倍速按钮）
+ */
+void BattleScene::menuToggleSpeed(Ref* pSender)
+{
+    const float maxSpeed = _isReplayMode ? 8.0f : 4.0f;
+    float speed = _clock.getSpeed() >= maxSpeed ? 1.0f : _clock.getSpeed() * 2.0f;
+    _clock.setSpeed(speed);
+    _speedLabel->setString(StringUtils::format("%dx", static_cast<int>(speed)));
+}
 
-            // 从士兵列表中移除，避免后续重复更新
-            soldierIt = _soldiers.erase(soldierIt);
-        }
-        else
-        {
-            // 士兵存活，迭代器下移
-            ++soldierIt;
-        }
+// =========================================================
+// 录像：投放精灵、回放驱动与保存
+// =========================================================
+
+/**
+ * @brief      为核心中新投放的单位创建士兵精灵
+ * @details    从对象池取出对应兵种的士兵，重置到核心中的投放位置后挂到地图上；兵营释放的守军同样由此创建
+ * @param      unitIndex  核心单位索引
+ */
+void BattleScene::spawnSoldierView(int unitIndex)
+{
+    const BattleUnitStore& units = _world.units();
+    if (!_tileMap || unitIndex < 0 || unitIndex >= static_cast<int>(units.size())) return;
+
+    auto soldier = _soldierPool.acquire(static_cast<SoldierType>(units.type[unitIndex]));
+    if (soldier) {
+        soldier->resetForDeploy(unitIndex, Vec2(units.x[unitIndex], units.y[unitIndex]));
+        // 兵营释放的守军染成红色以区分敌我（对象池复用的精灵需要恢复原色）
+        soldier->setColor(units.team[unitIndex] ? Color3B(255, 150, 150) : Color3B::WHITE);
+        _tileMap->addChild(soldier, 5);
+        _soldiers.pushBack(soldier);
     }
+    if (static_cast<int>(_unitViews.size()) <= unitIndex) _unitViews.resize(unitIndex + 1, nullptr);
+    _unitViews[unitIndex] = soldier;
+}
 
-    // 更新敌方防御塔逻辑（攻击范围内士兵检测与攻击）
-    for (auto node : _towers) {
-        auto tower = dynamic_cast<EnemyBuilding*>(node);
-        if (tower && !tower->isDestroyed()) {
-            tower->updateTowerLogic(dt, _soldiers);
-        }
+/**
+ * @brief      从核心读取各兵种剩余数量，刷新士兵 UI
+ */
+void BattleScene::refreshSoldierCounts()
+{
+    for (auto item : _soldierUIList) {
+        item->count = _world.getReserve(item->type);
+        item->countLabel->setString(std::to_string(item->count));
     }
 }
 
+/**
+ * @brief      进入回放模式
+ * @details    1. 以录像中的关卡来源与兵力走正常的 setupBattle 流程；
+ *             2. 关闭事件记录，由录像驱动器静默快进到起始步（投放与哈希校验照常进行）；
+ *             3. 按核心状态重建表现，设置倍速，并创建回放控制按钮与进度标签
+ * @param      replay     录像数据
+ * @param      startTick  起始步数
+ * @param      speed      回放倍速
+ */
+void BattleScene::setupReplay(const BattleReplay& replay, int startTick, float speed)
+{
+    _isReplayMode = true;
+    _replay = replay;
+    this->setupBattle(replay.getLevelIndex(), replay.getPvpJson());
+    if (!_tileMap || _tileMap->getParent() == nullptr) return;
+
+    // 快进到起始步：期间不产生事件，表现层最后一次性按状态重建
+    _replayPlayer.start(&_replay);
+    int target = std::max(0, std::min(startTick, _replay.getTickCount()));
+    _world.setEventsEnabled(false);
+    int reached = _replayPlayer.fastForward(_world, 0, target);
+    _world.clearEvents();
+    _world.setEventsEnabled(true);
+
+    _clock.reset(reached);
+    _clock.setSpeed(speed);
+    _speedLabel->setString(StringUtils::format("%dx", static_cast<int>(_clock.getSpeed())));
+    this->rebuildViewsFromWorld();
+
+    // 回放控制：后退 / 前进 10 秒（重新创建回放场景）
+    auto visibleSize = Director::getInstance()->getVisibleSize();
+    Vec2 origin = Director::getInstance()->getVisibleOrigin();
+    const int seekTicks = static_cast<int>(10.0f / _clock.getStep());
+
+    auto rewindItem = MenuItemLabel::create(Label::createWithTTF("<<10s", "fonts/Marker Felt.ttf", 28),
+        [this, seekTicks](Ref*) { this->seekReplay(_clock.getTickCount() - seekTicks); });
+    rewindItem->setPosition(Vec2(origin.x + 220, origin.y + visibleSize.height - 30));
+    auto forwardItem = MenuItemLabel::create(Label::createWithTTF("10s>>", "fonts/Marker Felt.ttf", 28),
+        [this, seekTicks](Ref*) { this->seekReplay(_clock.getTickCount() + seekTicks); });
+    forwardItem->setPosition(Vec2(origin.x + 310, origin.y + visibleSize.height - 30));
+
+    auto menu = Menu::create(rewindItem, forwardItem, NULL);
+    menu->setPosition(Vec2::ZERO);
+    this->addChild(menu, 100);
+
+    _replayLabel = Label::createWithTTF("", "fonts/Marker Felt.ttf", 24);
+    _replayLabel->setPosition(Vec2(origin.x + visibleSize.width / 2, origin.y + visibleSize.height - 30));
+    _replayLabel->enableOutline(Color4B::BLACK, 1);
+    this->addChild(_replayLabel, 30);
+    this->updateReplayLabel();
+}
+
+/**
+ * @brief      按核心当前状态重建表现
+ * @details    快进期间没有事件，这里直接读取核心：摧毁的建筑变灰、受损建筑刷新血条、
+ *             已触发的陷阱留下弹坑、存活单位创建士兵精灵；均不播放爆炸特效
+ */
+void BattleScene::rebuildViewsFromWorld()
+{
+    const BattleBuildingStore& buildings = _world.buildings();
+    for (size_t b = 0; b < _buildingViews.size() && b < buildings.size(); ++b) {
+        EnemyBuilding* view = _buildingViews[b];
+        if (!view) continue;
+        if (buildings.destroyed[b]) view->playDestroyedEffect(nullptr);
+        else if (buildings.hp[b] != view->getCurrentHp()) view->syncHp(buildings.hp[b]);
+    }
+
+    const std::vector<uint8_t>& exploded = _world.trapExploded();
+    for (size_t t = 0; t < exploded.size() && t < static_cast<size_t>(_traps.size()); ++t) {
+        if (exploded[t]) _traps.at(t)->playExplosionEffect(nullptr);
+    }
+
+    const BattleUnitStore& units = _world.units();
+    for (size_t i = 0; i < units.size(); ++i) {
+        if (units.alive[i]) spawnSoldierView(static_cast<int>(i));
+    }
+
+    refreshSoldierCounts();
+    updateDestructionLabel();
+}
+
+/**
+ * @brief      跳转到录像的指定步
+ * @details    核心状态只能向前推进，因此无论前进还是后退都以目标步重新创建回放场景，
+ *             快进只推进模拟、不产生表现，耗时远小于实际播放
+ * @param      tick  目标步数
+ */
+void BattleScene::seekReplay(int tick)
+{
+    if (!_isReplayMode) return;
+    tick = std::max(0, std::min(tick, _replay.getTickCount()));
+    Director::getInstance()->replaceScene(createReplayScene(_replay, tick, _clock.getSpeed()));
+}
+
+/**
+ * @brief      刷新回放进度标签
+ * @details    显示当前时间 / 录像总时长；状态哈希不一致时提示分叉时间，播放完毕时提示结束
+ */
+void BattleScene::updateReplayLabel()
+{
+    if (!_replayLabel) return;
+    const float step = _clock.getStep();
+    const int total = _replay.getTickCount();
+    const int tick = std::min(_clock.getTickCount(), total);
+
+    std::string text = StringUtils::format("Replay %.1fs / %.1fs", tick * step, total * step);
+    if (_replayPlayer.getDivergedTick() >= 0) {
+        text += StringUtils::format("  (diverged at %.1fs)", _replayPlayer.getDivergedTick() * step);
+        _replayLabel->setTextColor(Color4B::RED);
+    }
+    else if (_replayPlayer.isFinished(tick) || _world.getOutcome() != BattleOutcome::RUNNING) {
+        text += "  (end)";
+    }
+    _replayLabel->setString(text);
+}
+
+/**
+ * @brief      保存本局录像
+ * @details    录像序列化为紧凑的二进制格式后写入可写目录，覆盖上一场的录像
+ */
+void BattleScene::saveReplay()
+{
+    std::vector<uint8_t> bytes;
+    _replay.serialize(bytes);
+
+    Data data;
+    data.copy(bytes.data(), static_cast<ssize_t>(bytes.size()));
+    if (!FileUtils::getInstance()->writeDataToFile(data, getLastReplayPath())) {
+        log("Failed to save replay: %s", getLastReplayPath().c_str());
+    }
+}
+
+/**
+ * @brief      观看本局录像回调
+ * @param      pSender  按钮触发对象指针（Replay 按钮）
+ */
+void BattleScene::menuWatchReplay(Ref* pSender)
+{
+    Director::getInstance()->replaceScene(TransitionFade::create(0.5f, createReplayScene(_replay)));
+}
+
+// =========================================================
+// 快照：续玩存档与调试回退
+// =========================================================
+
+/**
+ * @brief      由快照恢复战斗
+ * @details    1. 以录像中的关卡来源与兵力走正常的 setupBattle 流程（录像不重新开始）；
+ *             2. 把快照恢复到核心；快照与关卡不符（例如关卡文件已更新）时退回为按录像快进到同一步；
+ *             3. 时钟拨到快照所在步，按核心状态重建表现，之后作为正常战斗继续
+ * @param      replay    截止到快照所在步的录像
+ * @param      snapshot  要恢复的快照
+ */
+void BattleScene::setupResume(const BattleReplay& replay, const BattleSnapshot& snapshot)
+{
+    _isResumed = true;
+    _replay = replay;
+    this->setupBattle(replay.getLevelIndex(), replay.getPvpJson());
+    if (!_tileMap || _tileMap->getParent() == nullptr) return;
+
+    int tick = snapshot.getTick();
+    if (!_world.restoreSnapshot(snapshot)) {
+        log("Snapshot does not match the level, fast-forwarding the replay instead");
+        BattleReplayPlayer player;
+        player.start(&_replay);
+        _world.setEventsEnabled(false);
+        tick = player.fastForward(_world, 0, _replay.getTickCount());
+        player.applyDeploys(_world, tick);
+        _world.clearEvents();
+        _world.setEventsEnabled(true);
+    }
+
+    _clock.reset(tick);
+    _lastCheckpointTick = tick;
+    this->rebuildViewsFromWorld();
+}
+
+/**
+ * @brief      截取当前状态并写入续玩存档
+ * @details    快照与序列化缓冲区都复用，帧内只截取与打包；写盘交给后台线程，
+ *             切到后台时进程随时可能被回收，此时同步写盘。回放模式与已结束的战斗不写存档
+ * @param      synchronous  是否立即同步写盘
+ */
+void BattleScene::saveCheckpoint(bool synchronous)
+{
+    if (_isReplayMode || _isGameOver || !_tileMap || _world.getOutcome() != BattleOutcome::RUNNING) return;
+
+    const int tick = _clock.getTickCount();
+    _world.captureSnapshot(_checkpointSnapshot, tick);
+    _lastCheckpointTick = tick;
+
+    _checkpointBytes.clear();
+    BattleCheckpoint::write(_replay, _checkpointSnapshot, _checkpointBytes);
+
+    if (!synchronous) {
+        checkpointWriter().post(getCheckpointPath(), _checkpointBytes);
+    }
+    else if (!checkpointWriter().writeNow(getCheckpointPath(), _checkpointBytes)) {
+        log("Failed to save checkpoint: %s", getCheckpointPath().c_str());
+    }
+}
+
+/**
+ * @brief      删除续玩存档
+ */
+void BattleScene::discardCheckpoint()
+{
+    checkpointWriter().discard(getCheckpointPath());
+}
+
+/**
+ * @brief      调试用回退
+ * @details    取不晚于 ticks 步之前的快照，把录像截回该步后以快照重新创建战斗场景；
+ *             环形缓冲中该步及更早的快照带到新场景，可以连续回退
+ * @param      ticks  回退的步数
+ */
+void BattleScene::rewindBattle(int ticks)
+{
+    if (_isReplayMode || _isGameOver) return;
+    const BattleSnapshot* snapshot = _snapshots.findAtOrBefore(_clock.getTickCount() - ticks);
+    if (!snapshot) {
+        showWarning("Nothing to rewind");
+        return;
+    }
+
+    BattleReplay replay = _replay;
+    replay.rewindTo(snapshot->getTick());
+    auto scene = static_cast<BattleScene*>(createResumeScene(replay, *snapshot));
+    if (!scene) return;
+    scene->_snapshots = _snapshots;
+    scene->_snapshots.discardAfter(snapshot->getTick());
+    Director::getInstance()->replaceScene(scene);
+}
+
 /**
  * @brief      返回游戏主场景回调函数
  * @details    先判断游戏是否结束，若结束则隐藏胜利弹窗并重置游戏状态；
@@ -236,6 +817,9 @@ void BattleScene::menuBackToGameScene(Ref* pSender)
         _isGameOver = false;
         _isGamePaused = false;
     }
+    // 主动退出视为放弃本场战斗，不再保留续玩存档
+    if (!_isReplayMode) discardCheckpoint();
+
     // 1. 停止战斗音乐，避免与主场景音乐冲突
     AudioEngine::stopAll();
 
@@ -253,8 +837,8 @@ void BattleScene::menuBackToGameScene(Ref* pSender)
 
 /**
  * @brief      检查游戏结束条件
- * @details    先做防御性检查避免重复判断，再分别校验胜利条件与失败条件：
- *             胜利条件为敌方大本营被摧毁且非围墙防御塔全部被清除；
+ * @details    先做防御性检查避免重复判断，再读取战斗核心给出的结果：
+ *             胜利条件为敌方大本营与所有非围墙建筑均被摧毁；
  *             失败条件为战场无存活士兵且无剩余可召唤士兵；
  *             满足对应条件后触发弹窗展示与战斗停止逻辑
  */
@@ -266,24 +850,19 @@ void BattleScene::checkGameEnd()
     // ==========================================
     // 1. 胜利条件判断（摧毁敌方大本营与所有非围墙防御塔）
     // ==========================================
-    bool victory = true;
+    BattleOutcome outcome = _world.getOutcome();
 
-    // 敌方大本营未被摧毁，不满足胜利条件
-    if (_base && !_base->isDestroyed()) {
-        victory = false;
-    }
+    // 回放模式只显示进度，不结算奖励也不弹窗
+    if (_isReplayMode) return;
 
-    // 遍历防御塔，存在未被摧毁的非围墙建筑，不满足胜利条件
-    if (victory) {
-        for (auto building : _towers) {
-            if (building && !building->isDestroyed() && building->getType() != EnemyType::WALL) {
-                victory = false;
-                break;
-            }
-        }
+    // 战斗结束时保存本局录像，续玩存档不再需要
+    if (outcome != BattleOutcome::RUNNING) {
+        _replay.finish(_clock.getTickCount());
+        saveReplay();
+        discardCheckpoint();
     }
 
-    if (victory) {
+    if (outcome == BattleOutcome::VICTORY) {
         _isGameOver = true;
         _isGamePaused = true;
 
@@ -309,21 +888,7 @@ void BattleScene::checkGameEnd()
     // ==========================================
     // 2. 失败条件判断（无存活士兵且无剩余可召唤士兵）
     // ==========================================
-
-    // 条件A：战场无存活士兵
-    bool noSoldiersOnField = _soldiers.empty();
-
-    // 条件B：无剩余可召唤士兵
-    bool noReservesLeft = true;
-    for (auto item : _soldierUIList) {
-        if (item->count > 0) {
-            noReservesLeft = false;
-            break; // 存在可召唤士兵，不满足条件B
-        }
-    }
-
-    // 同时满足条件A与B，且未满足胜利条件，判定战斗失败
-    if (noSoldiersOnField && noReservesLeft) {
+    if (outcome == BattleOutcome::DEFEAT) {
         _isGameOver = true;
         _isGamePaused = true;
 
@@ -466,8 +1031,13 @@ void BattleScene::showVictoryPopup()
     // 设置按钮位置
     backItem->setPosition(Vec2(0, -bgHeight * 0.35f));
 
+    // 观看本局录像按钮
+    auto replayLabel = Label::createWithTTF("Replay", "fonts/Marker Felt.ttf", 28);
+    auto replayItem = MenuItemLabel::create(replayLabel, CC_CALLBACK_1(BattleScene::menuWatchReplay, this));
+    replayItem->setPosition(Vec2(0, -bgHeight * 0.2f));
+
     // 创建菜单并添加到容器
-    auto menu = Menu::create(backItem, NULL);
+    auto menu = Menu::create(backItem, replayItem, NULL);
     menu->setPosition(Vec2::ZERO);
     container->addChild(menu);
 
@@ -545,8 +1115,13 @@ void BattleScene::showDefeatPopup()
     backItem->runAction(RepeatForever::create(scaleSeq));
     backItem->setPosition(Vec2(0, -bgHeight * 0.25f));
 
+    // 观看本局录像按钮
+    auto replayLabel = Label::createWithTTF("Replay", "fonts/Marker Felt.ttf", 28);
+    auto replayItem = MenuItemLabel::create(replayLabel, CC_CALLBACK_1(BattleScene::menuWatchReplay, this));
+    replayItem->setPosition(Vec2(0, -bgHeight * 0.1f));
+
     // 创建菜单并添加到容器
-    auto menu = Menu::create(backItem, NULL);
+    auto menu = Menu::create(backItem, replayItem, NULL);
     menu->setPosition(Vec2::ZERO);
     container->addChild(menu);
 
@@ -573,7 +1148,7 @@ void BattleScene::hideVictoryPopup()
 /**
  * @brief      加载 PVE 关卡
  * @details    先加载指定索引的 TMX 地图，做保底处理防止地图缺失；
- *             再将地图居中放置，解析地图对象组，创建敌方建筑、陷阱与装饰物，
+ *             再交给相机以原始尺寸居中放置（超出屏幕的部分可拖动查看），解析地图对象组，创建敌方建筑、陷阱与装饰物，
  *             填充禁止区域列表，完成 PVE 关卡的地图与敌方单位初始化
  * @param      levelIndex  PVE 关卡索引（对应 Enemy_map%d.tmx）
  */
@@ -590,20 +1165,24 @@ void BattleScene::loadLevelCampaign(int levelIndex)
         if (!_tileMap) return;
     }
 
-    // 2. 地图居中放置
-    auto visibleSize = Director::getInstance()->getVisibleSize();
-    Vec2 origin = Director::getInstance()->getVisibleOrigin();
+    // 2. 地图以原始尺寸居中放置；比屏幕大的地图由相机限制边界，可拖动与缩放
     float mapWidth = _tileMap->getContentSize().width;
     float mapHeight = _tileMap->getContentSize().height;
-
-    _tileMap->setPosition(Vec2(
-        origin.x + (visibleSize.width - mapWidth) / 2,
-        origin.y + (visibleSize.height - mapHeight) / 2
-    ));
+    _camera.attach(_tileMap, 1.0f, Vec2(mapWidth / 2, mapHeight / 2));
 
     // 地图放在最底层
     this->addChild(_tileMap, -1);
 
+    // 初始化关卡描述（核心坐标系即地图节点坐标系）
+    _levelDesc = BattleLevelDesc();
+    _levelDesc.mapWidth = mapWidth;
+    _levelDesc.mapHeight = mapHeight;
+    _levelDesc.tileWidth = _tileMap->getTileSize().width;
+    _levelDesc.tileHeight = _tileMap->getTileSize().height;
+    _levelDesc.cannonSplashRadius = BattleRules::CANNON_SPLASH_RADIUS;
+    _buildingViews.clear();
+    _decorations.clear();
+
     // 3. 解析地图对象组，创建游戏对象
     auto objectGroup = _tileMap->getObjectGroup("object");
     if (objectGroup) {
@@ -622,11 +1201,9 @@ void BattleScene::loadLevelCampaign(int levelIndex)
                 y += 100;
             }
 
-            // A. 填充禁止区域列表（排除炸弹陷阱）
+            // A. 填充禁止区域列表（排除炸弹陷阱，核心中使用地图节点坐标）
             if (name != "boom") {
-                Vec2 worldPos = _tileMap->convertToWorldSpace(Vec2(x, y));
-                Rect worldRect(worldPos.x, worldPos.y, w, h);
-                _forbiddenRects.push_back(worldRect);
+                _levelDesc.forbiddenRects.push_back(BattleRect(x, y, w, h));
             }
 
             // B. 创建敌方建筑与陷阱
@@ -637,6 +1214,7 @@ void BattleScene::loadLevelCampaign(int levelIndex)
                     _base->setType(EnemyType::BASE);
                     _base->setPosition(x + w / 2, y + h / 2);
                     _tileMap->addChild(_base, 3);
+                    registerBuilding(_base, 0.0f);
                 }
             }
             else if (name == "tower" || name == "cannon") {
@@ -651,6 +1229,7 @@ void BattleScene::loadLevelCampaign(int levelIndex)
                     building->setPosition(x + w / 2, y + h / 2);
                     _tileMap->addChild(building, 3);
                     _towers.pushBack(building);
+                    registerBuilding(building, range);
                 }
             }
             else if (name == "fence") {
@@ -660,6 +1239,7 @@ void BattleScene::loadLevelCampaign(int levelIndex)
                     fence->setPosition(x + w / 2, y + h / 2);
                     _tileMap->addChild(fence, 2);
                     _towers.pushBack(fence);
+                    registerBuilding(fence, 0.0f);
                 }
             }
             else if (name == "boom") {
@@ -667,7 +1247,13 @@ void BattleScene::loadLevelCampaign(int levelIndex)
                 auto trap = MapTrap::create(Rect(x, y, w, h), damage);
                 if (trap) {
                     _tileMap->addChild(trap);
+                    trap->setTrapIndex(static_cast<int>(_levelDesc.traps.size()));
                     _traps.pushBack(trap);
+
+                    BattleTrapDesc trapDesc;
+                    trapDesc.area = BattleRect(x, y, w, h);
+                    trapDesc.damage = damage;
+                    _levelDesc.traps.push_back(trapDesc);
                 }
             }
             // C. 创建纯装饰物（树木等）
@@ -684,6 +1270,7 @@ void BattleScene::loadLevelCampaign(int levelIndex)
                         sprite->setScaleY(dict["height"].asFloat() / sprite->getContentSize().height);
                     }
                     _tileMap->addChild(sprite, 2);
+                    _decorations.push_back(sprite);
                 }
             }
         }
@@ -692,7 +1279,7 @@ void BattleScene::loadLevelCampaign(int levelIndex)
 
 /**
  * @brief      加载 PVP 关卡
- * @details    先加载 Grass.tmx 地图并缩放适配屏幕，解析地图装饰物；
+ * @details    先加载 Grass.tmx 地图并按屏幕高度缩放（宽度超出屏幕的部分可拖动查看），解析地图装饰物；
  *             清空原有敌方单位与禁止区域数据，解析传入的 JSON 配置，
  *             创建敌方建筑并填充禁止区域，完成 PVP 关卡的初始化，
  *             做防御性检查防止无大本营导致秒胜
@@ -709,12 +1296,11 @@ void BattleScene::loadLevelPVP(const std::string& jsonContent)
         return;
     }
 
-    // 地图缩放适配屏幕高度
+    // 地图缩放适配屏幕高度，初始显示左下角，之后由相机拖动与缩放
     float scaleFactor = visibleSize.height / _tileMap->getContentSize().height;
-    _tileMap->setScale(scaleFactor);
-    _tileMap->setAnchorPoint(Vec2::ZERO);
-    _tileMap->setPosition(Vec2::ZERO);
+    _camera.attach(_tileMap, scaleFactor, Vec2::ZERO);
     this->addChild(_tileMap, -1);
+    _decorations.clear();
 
     // 2. 加载地图装饰物（树木等，优化视觉效果，无冗余）
     auto objectGroup = _tileMap->getObjectGroup("Objects");
@@ -740,6 +1326,7 @@ void BattleScene::loadLevelPVP(const std::string& jsonContent)
                         sprite->setScaleY(h / sprite->getContentSize().height);
                     }
                     sprite->setLocalZOrder(10000 - (int)oy);
+                    _decorations.push_back(sprite);
                 }
             }
         }
@@ -747,8 +1334,16 @@ void BattleScene::loadLevelPVP(const std::string& jsonContent)
 
     // --- 清空原有数据，防止残留（必要逻辑，无冗余） ---
     _towers.clear();
-    _forbiddenRects.clear();
     _base = nullptr;
+    _buildingViews.clear();
+
+    // 初始化关卡描述（核心坐标系即地图节点坐标系，未缩放）
+    _levelDesc = BattleLevelDesc();
+    _levelDesc.mapWidth = _tileMap->getContentSize().width;
+    _levelDesc.mapHeight = _tileMap->getContentSize().height;
+    _levelDesc.tileWidth = _tileMap->getTileSize().width;
+    _levelDesc.tileHeight = _tileMap->getTileSize().height;
+    _levelDesc.cannonSplashRadius = BattleRules::CANNON_SPLASH_RADIUS;
 
     // 3. 解析 PVP JSON 配置（必要逻辑，无冗余）
     rapidjson::Document doc;
@@ -829,6 +1424,14 @@ void BattleScene::loadLevelPVP(const std::string& jsonContent)
                 // 大本营单独赋值，不加入_towers
                 _base = eb;
             }
+
+            // 防御塔原先按屏幕（世界）坐标判定射程，地图缩放后换算回地图节点坐标以保持手感
+            registerBuilding(eb, eb->getRange() / scaleFactor);
+
+            // 兵营按等级驻扎守军，进攻方靠近时由核心逐个释放
+            if (targetEnemyType == EnemyType::BARRACKS) {
+                _levelDesc.buildings.back().garrison = BattleRules::barracksGarrison(level);
+            }
         }
     }
 
@@ -841,11 +1444,36 @@ void BattleScene::loadLevelPVP(const std::string& jsonContent)
     }
 }
 
+/**
+ * @brief      登记一个敌方建筑到关卡描述
+ * @details    以精灵在地图节点坐标系下的位置与包围盒（含缩放）作为核心中的位置与占地，
+ *             与原先士兵寻靶、碰撞判定所用的坐标一致；建筑索引即其在描述中的下标
+ * @param      building     敌方建筑精灵（已添加到地图）
+ * @param      rangeInMap   地图节点坐标系下的攻击范围
+ */
+void BattleScene::registerBuilding(EnemyBuilding* building, float rangeInMap)
+{
+    if (!building) return;
+
+    Rect box = building->getBoundingBox();
+    BattleBuildingDesc desc;
+    desc.type = building->getType();
+    desc.position = BattleVec2(building->getPositionX(), building->getPositionY());
+    desc.footprint = BattleRect(box.origin.x, box.origin.y, box.size.width, box.size.height);
+    desc.hp = building->getMaxHp();
+    desc.attack = building->getAttack();
+    desc.range = rangeInMap;
+
+    building->setBuildingIndex(static_cast<int>(_levelDesc.buildings.size()));
+    _levelDesc.buildings.push_back(desc);
+    _buildingViews.push_back(building);
+}
+
 /**
  * @brief      创建战斗场景 UI
  * @details    初始化士兵选择 UI 状态，定义士兵 UI 配置列表，
  *             从 DataManager 获取士兵数量，创建士兵图标与数量标签，
- *             布局士兵 UI 并创建提示标签，完成战斗场景 UI 的初始化
+ *             布局士兵 UI 并创建提示标签与摧毁百分比标签，完成战斗场景 UI 的初始化
  */
 void BattleScene::createUI()
 {
@@ -878,8 +1506,14 @@ void BattleScene::createUI()
 
     int index = 0;
     for (const auto& cfg : configs) {
-        // 从 DataManager 获取士兵可召唤数量
-        int count = DataManager::getInstance()->getTroopCount(cfg.dataName);
+        // 从 DataManager 获取士兵可召唤数量，并同步为核心中的可投放兵力
+        // 回放与恢复模式下兵力来自录像，正常战斗同时把兵力写入录像
+        const bool fromReplay = _isReplayMode || _isResumed;
+        int count = fromReplay ? _replay.getReserve(cfg.type) : DataManager::getInstance()->getTroopCount(cfg.dataName);
+        _world.setReserve(cfg.type, count);
+        if (!fromReplay) _replay.setReserve(cfg.type, count);
+        // 按可投放数量预热士兵对象池，投放时不再创建精灵
+        _soldierPool.prewarm(cfg.type, count);
 
         // 仅显示数量大于0的士兵 UI
         if (count > 0) {
@@ -918,6 +1552,27 @@ void BattleScene::createUI()
     _msgLabel->setTextColor(Color4B::RED);
     _msgLabel->setOpacity(0);
     this->addChild(_msgLabel, 30);
+
+    // 创建摧毁百分比标签（右上角），只在建筑被摧毁时刷新
+    _destructionLabel = Label::createWithTTF("", "fonts/Marker Felt.ttf", 28);
+    _destructionLabel->setAnchorPoint(Vec2(1.0f, 0.5f));
+    _destructionLabel->setPosition(Vec2(visibleSize.width - 20, visibleSize.height - 30));
+    _destructionLabel->enableOutline(Color4B::BLACK, 1);
+    this->addChild(_destructionLabel, 30);
+    updateDestructionLabel();
+}
+
+/**
+ * @brief      刷新摧毁百分比标签
+ * @details    百分比直接读取战斗核心的存活计数（O(1)），数值未变化时不重建文字
+ */
+void BattleScene::updateDestructionLabel()
+{
+    if (!_destructionLabel) return;
+    int percent = _world.getDestructionPercent();
+    if (percent == _shownDestruction) return;
+    _shownDestruction = percent;
+    _destructionLabel->setString(StringUtils::format("Destruction: %d%%", percent));
 }
 
 /**
@@ -925,7 +1580,7 @@ void BattleScene::createUI()
  * @details    处理士兵图标点击逻辑：若已选中当前士兵则取消选择；
  *             若选中其他士兵则重置原有选中状态；检查士兵数量，
  *             数量不足时显示警告；数量充足时设置选中状态，添加按钮动画，
- *             绘制禁止区域，进入士兵放置模式
+ *             显示缓存的禁止区域纹理，进入士兵放置模式
  * @param      item  被点击的士兵 UI 项指针
  */
 void BattleScene::onSoldierIconClicked(SoldierUIItem* item)
@@ -939,7 +1594,7 @@ void BattleScene::onSoldierIconClicked(SoldierUIItem* item)
         item->icon->stopAllActions();
         item->icon->setScale(3.0f);
         item->icon->setColor(Color3B::WHITE);
-        _forbiddenAreaNode->clear();
+        _forbiddenOverlay->setVisible(false);
         this->unschedule(CC_SCHEDULE_SELECTOR(BattleScene::spawnScheduler));
         return;
     }
@@ -956,7 +1611,7 @@ void BattleScene::onSoldierIconClicked(SoldierUIItem* item)
         showWarning("No more soldiers of this type!");
         _isPlacingMode = false;
         _currentSelectedItem = nullptr;
-        _forbiddenAreaNode->clear();
+        _forbiddenOverlay->setVisible(false);
         return;
     }
 
@@ -974,28 +1629,62 @@ void BattleScene::onSoldierIconClicked(SoldierUIItem* item)
     item->icon->runAction(action);
     item->icon->setColor(Color3B::YELLOW);
 
-    // 绘制红色禁止区域
-    _forbiddenAreaNode->clear();
-    for (const auto& rect : _forbiddenRects) {
-        _forbiddenAreaNode->drawSolidRect(
-            rect.origin,
-            Vec2(rect.getMaxX(), rect.getMaxY()),
+    // 显示红色禁止区域（缓存纹理，不再逐个重绘）
+    _forbiddenOverlay->setVisible(true);
+}
+
+/**
+ * @brief      创建禁止区域缓存纹理
+ * @details    在地图节点坐标系下把所有禁止区域绘制为半透明红色矩形，一次性渲染到 RenderTexture，
+ *             作为地图的子节点随地图缩放与平移；之后选择 / 取消士兵时只切换其可见性。
+ *             纹理边长超过 2048 时按比例降低分辨率再放大显示，大地图也不会占用过多显存
+ */
+void BattleScene::createForbiddenOverlay()
+{
+    const Size mapSize = _tileMap->getContentSize();
+    const float maxSide = std::max(mapSize.width, mapSize.height);
+    const float scale = maxSide > 2048.0f ? 2048.0f / maxSide : 1.0f;
+
+    auto drawNode = DrawNode::create();
+    for (const auto& rect : _levelDesc.forbiddenRects) {
+        drawNode->drawSolidRect(
+            Vec2(rect.minX() * scale, rect.minY() * scale),
+            Vec2(rect.maxX() * scale, rect.maxY() * scale),
             Color4F(1.0f, 0.0f, 0.0f, 0.3f)
         );
     }
+
+    _forbiddenOverlay = RenderTexture::create(
+        static_cast<int>(std::ceil(mapSize.width * scale)),
+        static_cast<int>(std::ceil(mapSize.height * scale)));
+    _forbiddenOverlay->beginWithClear(0.0f, 0.0f, 0.0f, 0.0f);
+    drawNode->visit(Director::getInstance()->getRenderer(), Mat4::IDENTITY, 0);
+    _forbiddenOverlay->end();
+
+    // RenderTexture 的精灵以节点原点为中心，放到地图中心并还原缩放
+    _forbiddenOverlay->setScale(1.0f / scale);
+    _forbiddenOverlay->setPosition(mapSize.width / 2, mapSize.height / 2);
+    _forbiddenOverlay->setVisible(false);
+    // 位于所有建筑与装饰物（ZOrder 最大约 10000）之上
+    _tileMap->addChild(_forbiddenOverlay, 20000);
 }
 
 /**
  * @brief      触摸开始回调函数
  * @details    先判断是否点击士兵图标，若点击则触发士兵选择逻辑；
  *             若处于士兵放置模式，则记录触摸状态与坐标，尝试召唤士兵，
- *             开启召唤调度器，处理触摸交互逻辑
+ *             开启召唤调度器；其余触摸（含回放模式）用于拖动地图
  * @param      touch  触摸对象指针
  * @param      event  事件对象指针
  * @return     bool  消费触摸事件返回 true；不消费返回 false
  */
 bool BattleScene::onTouchBegan(Touch* touch, Event* event)
 {
+    _isDraggingMap = false;
+
+    // 回放模式下投放完全由录像驱动，触摸只用于拖动地图
+    if (_isReplayMode) return true;
+
     Vec2 touchLoc = touch->getLocation();
 
     // 1. 判断是否点击士兵图标
@@ -1019,13 +1708,14 @@ bool BattleScene::onTouchBegan(Touch* touch, Event* event)
         return true;
     }
 
-    return false;
+    // 3. 其余触摸用于拖动地图
+    return true;
 }
 
 /**
  * @brief      触摸移动回调函数
  * @details    若处于士兵放置模式且正在触摸地图，更新当前触摸坐标，
- *             用于士兵放置位置的实时更新
+ *             用于士兵放置位置的实时更新；否则按触摸位移拖动地图
  * @param      touch  触摸对象指针
  * @param      event  事件对象指针
  */
@@ -1033,22 +1723,42 @@ void BattleScene::onTouchMoved(Touch* touch, Event* event)
 {
     if (_isPlacingMode && _isTouchingMap) {
         _currentTouchPos = touch->getLocation();
+        return;
     }
+
+    // 位移极小且尚未开始拖动时视为点击
+    Vec2 delta = touch->getDelta();
+    if (!_isDraggingMap && delta.getLength() < MAP_DRAG_THRESHOLD) return;
+    _isDraggingMap = true;
+    _camera.panBy(delta);
 }
 
 /**
  * @brief      触摸结束回调函数
- * @details    重置触摸状态，停止士兵召唤调度器，结束批量召唤逻辑
+ * @details    重置触摸与拖动状态，停止士兵召唤调度器，结束批量召唤逻辑
  * @param      touch  触摸对象指针
  * @param      event  事件对象指针
  */
 void BattleScene::onTouchEnded(Touch* touch, Event* event)
 {
     _isTouchingMap = false;
+    _isDraggingMap = false;
     // 停止士兵召唤调度器
     this->unschedule(CC_SCHEDULE_SELECTOR(BattleScene::spawnScheduler));
 }
 
+/**
+ * @brief      鼠标滚轮回调函数
+ * @details    每格滚轮按 BattleCamera::ZOOM_STEP 缩放地图（与 GameScene 的滚轮缩放一致），
+ *             缩放后相机修正地图位置，视野变化由下一帧的剔除处理
+ * @param      event  鼠标事件对象指针
+ */
+void BattleScene::onMouseScroll(Event* event)
+{
+    EventMouse* e = static_cast<EventMouse*>(event);
+    _camera.zoomBy(e->getScrollY() > 0 ? 1.0f : -1.0f);
+}
+
 /**
  * @brief      士兵召唤调度器
  * @details    按调度间隔调用，若处于士兵放置模式且正在触摸地图，
@@ -1064,8 +1774,8 @@ void BattleScene::spawnScheduler(float dt)
 
 /**
  * @brief      尝试召唤士兵
- * @details    先做防御性检查（选中状态、士兵数量），再判断放置位置是否被阻挡；
- *             若放置有效，则创建士兵并添加到场景，更新士兵数量与 UI，
+ * @details    先做防御性检查（选中状态、士兵数量），再由战斗核心判断放置位置并投放单位；
+ *             投放成功后写入录像（士兵精灵由 UNIT_DEPLOYED 事件创建），从核心读取剩余数量更新 UI，
  *             若士兵数量耗尽，则退出放置模式，恢复 UI 状态
  * @param      worldPos  士兵放置的世界坐标
  */
@@ -1079,32 +1789,22 @@ void BattleScene::trySpawnSoldier(Vec2 worldPos)
         return;
     }
 
-    // 2. 放置位置阻挡判断
-    bool isBlocked = false;
-    Rect soldierRect(worldPos.x - 10, worldPos.y - 10, 20, 20);
-    for (const auto& rect : _forbiddenRects) {
-        if (rect.intersectsRect(soldierRect)) {
-            isBlocked = true;
-            break;
-        }
-    }
-
-    if (isBlocked) {
+    // 2. 放置位置阻挡判断（转换为地图节点坐标，由核心判定）
+    Vec2 nodePos = _tileMap->convertToNodeSpace(worldPos);
+    BattleVec2 battlePos(nodePos.x, nodePos.y);
+    if (!_world.canDeployAt(battlePos)) {
         showWarning("Cannot place here!");
         return;
     }
 
-    // 3. 召唤士兵（转换为地图节点坐标）
-    Vec2 nodePos = _tileMap->convertToNodeSpace(worldPos);
-    auto soldier = Soldier::create(this, _currentSelectedType);
-    soldier->setPosition(nodePos);
-    _tileMap->addChild(soldier, 5);
-    _soldiers.pushBack(soldier);
-
-    // 4. 减少士兵可召唤数量
-    _currentSelectedItem->count--;
+    // 3. 在核心中投放单位并写入录像（投放发生在第 tick 步之后、下一步之前）；
+    //    士兵精灵由随后的 UNIT_DEPLOYED 事件从对象池取出
+    int unitIndex = _world.deployUnit(_currentSelectedType, battlePos);
+    if (unitIndex == BATTLE_INVALID_INDEX) return;
+    _replay.recordDeploy(_clock.getTickCount(), _currentSelectedType, battlePos);
 
-    // 5. 更新士兵数量 UI 显示
+    // 5. 从核心读取剩余可召唤数量，更新 UI 显示
+    _currentSelectedItem->count = _world.getReserve(_currentSelectedType);
     _currentSelectedItem->countLabel->setString(std::to_string(_currentSelectedItem->count));
 
     // 6. 士兵数量耗尽，退出放置模式
@@ -1116,7 +1816,7 @@ void BattleScene::trySpawnSoldier(Vec2 worldPos)
         _isPlacingMode = false;
         _currentSelectedItem->icon->stopAllActions();
         _currentSelectedItem->icon->setScale(3.0f);
-        _forbiddenAreaNode->clear();
+        _forbiddenOverlay->setVisible(false);
         _currentSelectedItem = nullptr;
     }
 }
@@ -1141,35 +1841,13 @@ void BattleScene::showWarning(const std::string& msg)
 
 /**
  * @brief      判断指定世界坐标是否被阻挡
- * @details    先判断是否与敌方大本营碰撞，再遍历敌方防御塔，
- *             判断是否与未被摧毁的建筑碰撞，返回阻挡状态，
- *             供士兵寻路与放置时使用
+ * @details    将世界坐标转换为地图节点坐标，交给战斗核心判断是否与未被摧毁的建筑（含大本营）碰撞
  * @param      worldPos  待判断的世界坐标
  * @return     bool  被阻挡返回 true；可通行返回 false
  */
 bool BattleScene::isPositionBlocked(Vec2 worldPos)
 {
-    // 1. 判断是否与敌方大本营碰撞
-    if (_base && !_base->isDestroyed()) {
-        Rect baseRect = _base->getBoundingBox();
-        Vec2 baseWorldPos = _tileMap->convertToWorldSpace(baseRect.origin);
-        Rect worldRect(baseWorldPos.x, baseWorldPos.y, baseRect.size.width, baseRect.size.height);
-
-        if (worldRect.containsPoint(worldPos)) return true;
-    }
-
-    // 2. 判断是否与敌方防御塔碰撞
-    for (auto building : _towers) {
-        if (building && !building->isDestroyed()) {
-            Rect rect = building->getBoundingBox();
-            Vec2 buildingWorldPos = _tileMap->convertToWorldSpace(rect.origin);
-            Rect worldRect(buildingWorldPos.x, buildingWorldPos.y, rect.size.width, rect.size.height);
-
-            if (worldRect.containsPoint(worldPos)) {
-                return true;
-            }
-        }
-    }
-
-    return false;
-}
\ No newline at end of file
+    if (!_tileMap) return false;
+    Vec2 nodePos = _tileMap->convertToNodeSpace(worldPos);
+    return _world.isPositionBlocked(BattleVec2(nodePos.x, nodePos.y));
+}
@@ -2,12 +2,13 @@
  * @file       BattleScene.h
  * @brief      战斗场景核心类头文件
  * @details    该文件声明了战斗场景（BattleScene）的核心接口与成员，继承自Cocos2d-x的Scene类，
- *             封装了PVE/PVP双模式战斗逻辑、关卡加载、士兵AI调度、建筑管理、UI交互、触摸事件等核心功能，
- *             是整个战斗流程的主控类，负责协调士兵、敌方建筑、地图等模块的交互
+ *             封装了PVE/PVP双模式关卡加载、战斗核心驱动、表现同步、UI交互、触摸事件等核心功能，
+ *             战斗规则全部由无引擎依赖的 BattleWorld 负责，场景只把关卡描述交给核心、转发玩家投放操作，
+ *             并在每帧根据核心状态与事件同步士兵、敌方建筑、陷阱等精灵
  * @author     （可补充作者信息）
  * @date       （可补充创建日期）
  * @version    1.0
- * @note       该类依赖MapTrap、EnemyBuilding、Soldier等模块；支持扩展新关卡与战斗模式，
+ * @note       该类依赖BattleWorld、MapTrap、EnemyBuilding、Soldier等模块；支持扩展新关卡与战斗模式，
  *             私有方法按功能分组，便于维护与扩展；原代码中冗余的类名限定已移除，修复注释乱码问题
  */
 #ifndef BATTLE_SCENE_H_
@@ -17,6 +18,14 @@
 #include "cocos2d.h"
 #include "EnemyBuilding.h"
 #include "Soldier.h" // 引入士兵基类头文件
+#include "BattleWorld.h" // 引入战斗核心
+#include "BattleClock.h" // 引入固定步长时钟
+#include "BattleProjectileLayer.h" // 引入弹道批量渲染层
+#include "BattleVfxManager.h" // 引入战斗特效管理器
+#include "SoldierPool.h" // 引入士兵对象池
+#include "BattleReplay.h" // 引入战斗录像（录制与回放）
+#include "BattleSnapshot.h" // 引入战斗快照（回退与续玩存档）
+#include "BattleCamera.h" // 引入战斗地图相机（平移、缩放与视野剔除）
 
  /**
   * @struct     SoldierUIItem
@@ -66,6 +75,74 @@ public:
      */
     static cocos2d::Scene* createScene(int levelIndex, std::string pvpJsonData = "");
 
+    /**
+     * @brief      创建录像回放场景
+     * @details    按录像中的关卡来源与兵力载入战斗，静默快进到 startTick 后由录像驱动投放，
+     *             回放期间不接受玩家投放；拖动进度（seek）即以新的起始步重新创建回放场景
+     * @param      replay     录像数据（场景内保存一份副本）
+     * @param      startTick  起始步数（0 表示从头播放）
+     * @param      speed      回放倍速（1x ~ 8x）
+     * @return     cocos2d::Scene*  创建成功返回场景指针；地图加载失败时仍返回场景（显示错误提示）
+     */
+    static cocos2d::Scene* createReplayScene(const BattleReplay& replay, int startTick = 0, float speed = 1.0f);
+
+    /**
+     * @brief      从录像文件创建回放场景
+     * @param      path  录像文件路径（通常为 getLastReplayPath()）
+     * @return     cocos2d::Scene*  文件不存在或格式不合法时返回 nullptr
+     */
+    static cocos2d::Scene* createReplayScene(const std::string& path);
+
+    /**
+     * @brief      最近一场战斗的录像文件路径（可写目录下的 last_battle.replay）
+     */
+    static std::string getLastReplayPath();
+
+    /**
+     * @brief      从续玩存档恢复被中断的战斗
+     * @details    按存档中的录像载入关卡与兵力，再把快照恢复到战斗核心并按核心状态重建表现，
+     *             之后作为正常战斗继续进行（录像接着存档中的时间线继续录制）
+     * @param      path  存档文件路径（通常为 getCheckpointPath()）
+     * @return     cocos2d::Scene*  文件不存在或格式不合法时返回 nullptr
+     */
+    static cocos2d::Scene* createResumeScene(const std::string& path);
+
+    /**
+     * @brief      以录像与快照创建恢复后的战斗场景（续玩与调试回退共用）
+     * @param      replay    截止到快照所在步的录像
+     * @param      snapshot  要恢复的快照
+     * @return     cocos2d::Scene*  恢复后的战斗场景
+     */
+    static cocos2d::Scene* createResumeScene(const BattleReplay& replay, const BattleSnapshot& snapshot);
+
+    /**
+     * @brief      续玩存档路径（可写目录下的 battle_checkpoint.bin）
+     */
+    static std::string getCheckpointPath();
+
+    /**
+     * @brief      是否存在未结束战斗的续玩存档
+     */
+    static bool hasCheckpoint();
+
+    /**
+     * @brief      为正在运行的战斗写入续玩存档
+     * @details    当前运行场景是进行中的正常战斗时立即截取快照并写盘，否则不做任何事；
+     *             由 AppDelegate::applicationDidEnterBackground 调用
+     */
+    static void saveRunningCheckpoint();
+
+    /**
+     * @brief      只解析关卡、不进入战斗，得到战斗核心所需的关卡描述
+     * @details    在一个不运行的临时场景上走与 setupBattle 相同的地图加载流程（建筑占地取自精灵包围盒），
+     *             供出战前的胜率预测等无画面模拟使用；须在主线程调用
+     * @param      levelIndex   PVE 关卡索引（大于 0 有效）；为 0 时按 PVP 布局解析
+     * @param      pvpJsonData  PVP 敌方配置 JSON 字符串
+     * @param      out          输出的关卡描述
+     * @return     bool  地图加载失败或没有任何建筑时返回 false
+     */
+    static bool describeLevel(int levelIndex, const std::string& pvpJsonData, BattleLevelDesc& out);
+
     /**
      * @brief      Cocos2d-x宏定义，自动生成创建实例的相关代码
      * @details    封装了对象创建、初始化与自动内存管理的逻辑，简化场景实例的创建流程
@@ -91,7 +168,8 @@ public:
 
     /**
      * @brief      场景帧更新函数（重写父类方法）
-     * @details    每帧调用，负责驱动士兵AI、敌方建筑、游戏状态等模块的更新，是战斗逻辑的核心调度入口
+     * @details    每帧调用，推进战斗核心一步，再把核心状态与事件同步到士兵、敌方建筑、陷阱等精灵，
+     *             最后根据核心的战斗结果触发胜利/失败流程，是战斗逻辑的核心调度入口
      * @param      dt  帧间隔时间（秒），用于时间相关逻辑计算（如冷却计时、移动距离）
      * @override   cocos2d::Node::update
      */
@@ -101,15 +179,15 @@ public:
     // 公共业务接口（供外部模块调用）
     // ==========================================
     /**
-     * @brief      获取敌方防御塔列表（供士兵AI调用）
-     * @details    返回场景中所有敌方防御塔的引用，用于士兵寻靶逻辑，获取有效攻击目标
+     * @brief      获取敌方防御塔列表
+     * @details    返回场景中所有敌方防御塔（非大本营建筑）精灵的引用
      * @return     cocos2d::Vector<EnemyBuilding*>&  敌方防御塔向量引用
      */
     cocos2d::Vector<EnemyBuilding*>& getTowers() { return _towers; }
 
     /**
-     * @brief      获取敌方大本营（供士兵AI调用）
-     * @details    返回场景中敌方大本营的指针，是士兵的核心攻击目标，摧毁后判定战斗胜利
+     * @brief      获取敌方大本营
+     * @details    返回场景中敌方大本营精灵的指针，是士兵的核心攻击目标
      * @return     EnemyBuilding*  敌方大本营指针；无有效大本营时返回nullptr
      */
     EnemyBuilding* getBase() { return _base; }
@@ -124,8 +202,20 @@ public:
     void setupBattle(int levelIndex, std::string pvpJsonData);
 
     /**
-     * @brief      判定指定世界坐标是否被阻挡（供士兵寻路调用）
-     * @details    校验传入的世界坐标是否在禁止移动区域内，用于士兵陆军的寻路阻挡判断，避免穿透地形/建筑
+     * @brief      获取战斗核心（只读）
+     * @return     const BattleWorld&  当前战斗的模拟核心
+     */
+    const BattleWorld& getBattleWorld() const { return _world; }
+
+    /**
+     * @brief      获取战斗特效管理器（性能分析可读取当前特效数量）
+     * @return     BattleVfxManager*  特效管理器；地图加载失败时为 nullptr
+     */
+    BattleVfxManager* getVfxManager() const { return _vfx; }
+
+    /**
+     * @brief      判定指定世界坐标是否被阻挡
+     * @details    将世界坐标转换为地图节点坐标后交给战斗核心判定，是否被未摧毁的建筑占据
      * @param      worldPos  世界坐标点
      * @return     bool  被阻挡返回true；可通行返回false
      */
@@ -138,20 +228,46 @@ private:
     // 地图相关成员
     cocos2d::TMXTiledMap* _tileMap;                ///< TMX地图节点（承载战斗场景地图资源）
     std::string _mapFileName;                      ///< 地图文件名（存储当前加载的地图名称，用于后续重加载）
-    std::vector<cocos2d::Rect> _forbiddenRects;    ///< 禁止移动区域矩形列表（用于陆军寻路阻挡判断）
     cocos2d::Vector<MapTrap*> _traps;              ///< 地图陷阱列表（承载场景中的陷阱组件）
+    std::vector<cocos2d::Node*> _decorations;      ///< 地图装饰物精灵（树木等，由地图节点持有，视野外隐藏）
+    BattleCamera _camera;                          ///< 地图相机（拖动平移、滚轮缩放，给出视野矩形）
+    bool _isDraggingMap;                           ///< 地图拖动标记（true=本次触摸正在拖动地图）
 
     // 战斗核心成员
     BattleMode _currentMode;                       ///< 当前战斗模式（PVE/PVP）
     cocos2d::Vector<EnemyBuilding*> _towers;       ///< 敌方防御塔列表（含加农炮、弓箭塔等防御建筑）
     EnemyBuilding* _base;                          ///< 敌方大本营指针（核心攻击目标）
-    cocos2d::Vector<Soldier*> _soldiers;           ///< 己方士兵列表（存储所有已召唤的士兵实例）
+    cocos2d::Vector<Soldier*> _soldiers;           ///< 己方士兵列表（存储所有存活士兵的精灵）
+    BattleWorld _world;                            ///< 战斗模拟核心（全部战斗规则与状态）
+    BattleClock _clock;                            ///< 固定步长时钟（30 Hz，支持 1x/2x/4x 倍速）
+    BattleLevelDesc _levelDesc;                    ///< 关卡加载时收集的布局描述，加载完成后交给核心
+    std::vector<EnemyBuilding*> _buildingViews;    ///< 核心建筑索引 -> 建筑精灵
+    std::vector<Soldier*> _unitViews;              ///< 核心单位索引 -> 士兵精灵（阵亡后置空）
+    BattleProjectileLayer* _projectileLayer;       ///< 弹道批量渲染层（箭与炮弹按纹理分批绘制）
+    BattleVfxManager* _vfx;                        ///< 战斗特效管理器（共享爆炸动画、复用特效精灵）
+    SoldierPool _soldierPool;                      ///< 士兵对象池（载入时按兵力预热，投放取出、阵亡回收）
+
+    // 录像相关成员
+    BattleReplay _replay;                          ///< 本局录像（正常战斗时录制，回放模式下为播放的录像）
+    BattleReplayPlayer _replayPlayer;              ///< 录像驱动器（回放模式下按步号投放并校验状态哈希）
+    bool _isReplayMode;                            ///< 是否处于回放模式
+    cocos2d::Label* _replayLabel;                  ///< 回放进度标签（当前时间 / 总时长、分叉提示）
+
+    // 快照相关成员
+    BattleSnapshotRing _snapshots;                 ///< 快照环形缓冲（每秒截取一次，调试回退用）
+    BattleSnapshot _checkpointSnapshot;            ///< 写续玩存档时截取的快照（复用缓冲区）
+    std::vector<uint8_t> _checkpointBytes;         ///< 序列化后的续玩存档（与后台写盘器交换复用）
+    int _lastCheckpointTick;                       ///< 上一次写续玩存档时的步数
+    bool _isResumed;                               ///< 是否由快照恢复（兵力来自录像，不重新开始录像）
 
     // UI相关成员
     std::vector<SoldierUIItem*> _soldierUIList;    ///< 士兵UI项列表（构建士兵选择界面）
     bool _isPlacingMode;                           ///< 士兵放置模式标记（true=可放置士兵，false=不可放置）
-    cocos2d::DrawNode* _forbiddenAreaNode;         ///< 禁止区域绘制节点（用于渲染红色禁止移动区域）
+    cocos2d::RenderTexture* _forbiddenOverlay;     ///< 禁止区域缓存纹理（载入关卡时渲染一次，放置模式下显示）
     cocos2d::Label* _msgLabel;                     ///< 提示信息标签（显示警告、提示等文本信息）
+    cocos2d::Label* _speedLabel;                   ///< 倍速按钮标签（显示当前倍速）
+    cocos2d::Label* _destructionLabel;             ///< 摧毁百分比标签（建筑被摧毁时刷新）
+    int _shownDestruction;                         ///< 标签当前显示的百分比（未变化时不刷新文字）
     SoldierType _currentSelectedType;              ///< 当前选中的士兵类型（用于召唤对应士兵）
     SoldierUIItem* _currentSelectedItem;           ///< 当前选中的士兵UI项（关联UI组件与士兵数据）
 
@@ -184,6 +300,29 @@ private:
      */
     void loadLevelPVP(const std::string& json);
 
+    /**
+     * @brief      登记一个敌方建筑到关卡描述
+     * @details    以精灵在地图节点坐标系下的位置与包围盒作为核心中的位置与占地，
+     *             并记录建筑索引与精灵的对应关系
+     * @param      building     敌方建筑精灵（已添加到地图）
+     * @param      rangeInMap   地图节点坐标系下的攻击范围
+     */
+    void registerBuilding(EnemyBuilding* building, float rangeInMap);
+
+    // 表现同步方法
+    /**
+     * @brief      同步战斗核心到表现层
+     * @details    按发生顺序消费核心事件（攻击反馈、爆炸、建筑受损/摧毁、单位阵亡），
+     *             随后同步所有存活士兵的位置、朝向、状态与血量，以及飞行中的弹道
+     */
+    void syncBattleViews();
+
+    /**
+     * @brief      按相机视野剔除建筑与装饰物
+     * @details    建筑与装饰物不会移动，只在相机平移 / 缩放后重新判定一次可见性
+     */
+    void cullStaticViews();
+
     // UI创建与回调方法
     /**
      * @brief      创建战斗场景UI
@@ -191,6 +330,12 @@ private:
      */
     void createUI();
 
+    /**
+     * @brief      刷新摧毁百分比标签
+     * @details    读取战斗核心按类别维护的存活计数，不遍历建筑列表
+     */
+    void updateDestructionLabel();
+
     /**
      * @brief      士兵图标点击回调
      * @details    当点击士兵选择UI图标时触发，切换当前选中的士兵类型，进入士兵放置模式
@@ -198,6 +343,93 @@ private:
      */
     void onSoldierIconClicked(SoldierUIItem* item);
 
+    /**
+     * @brief      倍速按钮回调
+     * @details    在 1x / 2x / 4x（回放模式可到 8x）之间循环切换战斗时钟的倍速，只改变每帧推进的步数，不影响战斗结果
+     * @param      pSender  按钮触发对象指针
+     */
+    void menuToggleSpeed(cocos2d::Ref* pSender);
+
+    // 录像方法
+    /**
+     * @brief      为核心中新投放的单位创建士兵精灵
+     * @details    由 UNIT_DEPLOYED 事件驱动，正常战斗与录像回放共用；精灵从对象池取出并挂到地图上
+     * @param      unitIndex  核心单位索引
+     */
+    void spawnSoldierView(int unitIndex);
+
+    /**
+     * @brief      从核心读取各兵种剩余数量，刷新士兵 UI
+     */
+    void refreshSoldierCounts();
+
+    /**
+     * @brief      进入回放模式
+     * @details    载入录像对应的关卡与兵力，静默快进到 startTick，再按核心状态重建建筑、陷阱与士兵的表现，
+     *             并创建回放控制按钮（后退 / 前进 10 秒）与进度标签
+     */
+    void setupReplay(const BattleReplay& replay, int startTick, float speed);
+
+    /**
+     * @brief      按核心当前状态重建表现（快进后调用，不播放特效）
+     */
+    void rebuildViewsFromWorld();
+
+    /**
+     * @brief      跳转到录像的指定步（以新的起始步重新创建回放场景）
+     * @param      tick  目标步数（自动限制在录像范围内）
+     */
+    void seekReplay(int tick);
+
+    /**
+     * @brief      刷新回放进度标签
+     */
+    void updateReplayLabel();
+
+    /**
+     * @brief      保存本局录像到 getLastReplayPath()
+     */
+    void saveReplay();
+
+    // 快照方法
+    /**
+     * @brief      由快照恢复战斗
+     * @details    以录像中的关卡来源与兵力走正常的 setupBattle 流程，再把快照恢复到核心、
+     *             时钟拨到快照所在步，并按核心状态重建表现
+     */
+    void setupResume(const BattleReplay& replay, const BattleSnapshot& snapshot);
+
+    /**
+     * @brief      截取当前状态并写入续玩存档
+     * @param      synchronous  true 时立即写盘（切到后台时），false 时交给后台线程写盘（帧内定期存档）
+     */
+    void saveCheckpoint(bool synchronous);
+
+    /**
+     * @brief      删除续玩存档（战斗结束或主动退出时调用）
+     */
+    void discardCheckpoint();
+
+    /**
+     * @brief      调试用回退：恢复到环形缓冲中不晚于 ticks 步之前的快照
+     * @details    录像截回快照所在步，以快照重新创建战斗场景（已摧毁的建筑与爆炸的陷阱无法就地复原），
+     *             环形缓冲中更早的快照一并带到新场景，可以连续回退
+     * @param      ticks  回退的步数
+     */
+    void rewindBattle(int ticks);
+
+    /**
+     * @brief      观看本局录像回调（胜利 / 失败弹窗中的 Replay 按钮）
+     * @param      pSender  按钮触发对象指针
+     */
+    void menuWatchReplay(cocos2d::Ref* pSender);
+
+    /**
+     * @brief      创建禁止区域缓存纹理
+     * @details    载入关卡后把全部禁止区域一次性渲染为红色半透明纹理，之后只切换显示 / 隐藏
+     */
+    void createForbiddenOverlay();
+
     // 士兵召唤方法
     /**
      * @brief      尝试召唤士兵
@@ -224,7 +456,7 @@ private:
     // 游戏状态判断方法
     /**
      * @brief      检查游戏是否结束
-     * @details    每帧校验游戏胜利/失败条件（大本营是否被摧毁、所有敌方建筑是否被清除），触发对应结束逻辑
+     * @details    每帧读取战斗核心给出的战斗结果，胜利或失败时停止战斗并触发对应结束逻辑
      */
     void checkGameEnd();
 
@@ -258,7 +490,7 @@ private:
 
     /**
      * @brief      触摸移动回调
-     * @details    当玩家在屏幕上移动触摸点时触发，更新当前触摸坐标，用于士兵放置位置预览
+     * @details    放置模式下更新当前触摸坐标，用于士兵放置位置预览；否则拖动地图
      * @param      touch  触摸对象指针
      * @param      event  事件对象指针
      */
@@ -272,6 +504,13 @@ private:
      */
     void onTouchEnded(cocos2d::Touch* touch, cocos2d::Event* event);
 
+    /**
+     * @brief      鼠标滚轮回调
+     * @details    以屏幕中心为基准缩放地图，最小缩放为整张地图完整显示
+     * @param      event  鼠标事件对象指针
+     */
+    void onMouseScroll(cocos2d::Event* event);
+
     // 菜单回调方法
     /**
      * @brief      返回游戏主场景回调
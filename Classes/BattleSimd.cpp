@@ -0,0 +1,237 @@
+/**
+ * @file       BattleSimd.cpp
+ * @brief      向量化距离 / 范围判定内核的实现
+ * @version    1.0
+ */
+#include "BattleSimd.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#if !defined(BATTLE_SIMD_DISABLE) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define BATTLE_SIMD_SSE2 1
+#include <emmintrin.h>
+#elif !defined(BATTLE_SIMD_DISABLE) && defined(__aarch64__) && defined(__ARM_NEON)
+#define BATTLE_SIMD_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace {
+
+/// 标量参考规则：值更小，或值相等且编号更小时替换当前结果
+inline void consider(float value, int id, float& bestValue, int& best)
+{
+    if (value < bestValue || (value == bestValue && best != BATTLE_INVALID_INDEX && id < best)) {
+        bestValue = value;
+        best = id;
+    }
+}
+
+// =========================================================
+// 4 通道向量操作（每个后端提供同一组函数）
+// =========================================================
+
+#if defined(BATTLE_SIMD_SSE2)
+
+typedef __m128 Lane4;
+
+inline Lane4 load4(const float* p) { return _mm_loadu_ps(p); }
+inline void store4(float* p, Lane4 v) { _mm_storeu_ps(p, v); }
+inline Lane4 splat(float v) { return _mm_set1_ps(v); }
+inline Lane4 sub4(Lane4 a, Lane4 b) { return _mm_sub_ps(a, b); }
+inline Lane4 add4(Lane4 a, Lane4 b) { return _mm_add_ps(a, b); }
+inline Lane4 mul4(Lane4 a, Lane4 b) { return _mm_mul_ps(a, b); }
+inline Lane4 sqrt4(Lane4 a) { return _mm_sqrt_ps(a); }
+
+/// a <= b 的通道位掩码（第 k 位对应第 k 个通道）
+inline int maskLessEqual(Lane4 a, Lane4 b) { return _mm_movemask_ps(_mm_cmple_ps(a, b)); }
+
+/// lo <= v <= hi 的通道位掩码
+inline int maskBetween(Lane4 v, Lane4 lo, Lane4 hi)
+{
+    return _mm_movemask_ps(_mm_and_ps(_mm_cmpge_ps(v, lo), _mm_cmple_ps(v, hi)));
+}
+
+#elif defined(BATTLE_SIMD_NEON)
+
+typedef float32x4_t Lane4;
+
+inline Lane4 load4(const float* p) { return vld1q_f32(p); }
+inline void store4(float* p, Lane4 v) { vst1q_f32(p, v); }
+inline Lane4 splat(float v) { return vdupq_n_f32(v); }
+inline Lane4 sub4(Lane4 a, Lane4 b) { return vsubq_f32(a, b); }
+inline Lane4 add4(Lane4 a, Lane4 b) { return vaddq_f32(a, b); }
+// 乘与加分开执行（不使用融合乘加），与 SSE2 / 标量的舍入保持一致
+inline Lane4 mul4(Lane4 a, Lane4 b) { return vmulq_f32(a, b); }
+inline Lane4 sqrt4(Lane4 a) { return vsqrtq_f32(a); }
+
+inline int movemask(uint32x4_t m)
+{
+    static const int32_t shifts[4] = { 0, 1, 2, 3 };
+    return static_cast<int>(vaddvq_u32(vshlq_u32(vshrq_n_u32(m, 31), vld1q_s32(shifts))));
+}
+
+inline int maskLessEqual(Lane4 a, Lane4 b) { return movemask(vcleq_f32(a, b)); }
+
+inline int maskBetween(Lane4 v, Lane4 lo, Lane4 hi)
+{
+    return movemask(vandq_u32(vcgeq_f32(v, lo), vcleq_f32(v, hi)));
+}
+
+#endif
+
+#if defined(BATTLE_SIMD_SSE2) || defined(BATTLE_SIMD_NEON)
+
+/**
+ * @brief      取第 i 个 4 通道块的起始指针；不足 4 个时复制到 pad 并以 NaN 补齐（NaN 的比较恒为假）
+ */
+inline const float* block(const float* data, int i, int end, float* pad)
+{
+    if (end - i >= 4) return data + i;
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+    for (int k = 0; k < 4; ++k) pad[k] = i + k < end ? data[i + k] : nan;
+    return pad;
+}
+
+/**
+ * @brief      nearestSq / nearestScored 的共同实现
+ * @details    向量比较只筛掉值大于当前最优的通道；其余通道按下标顺序走标量规则，
+ *             与逐个比较的遍历顺序和替换规则完全相同
+ */
+void nearestLanes(float px, float py, const float* xs, const float* ys, const int* ids, int count,
+    bool scored, float bias, float& bestValue, int& best)
+{
+    const Lane4 qx = splat(px);
+    const Lane4 qy = splat(py);
+    const Lane4 offset = splat(bias);
+    float padX[4], padY[4], values[4];
+
+    for (int i = 0; i < count; i += 4) {
+        Lane4 dx = sub4(load4(block(xs, i, count, padX)), qx);
+        Lane4 dy = sub4(load4(block(ys, i, count, padY)), qy);
+        Lane4 value = add4(mul4(dx, dx), mul4(dy, dy));
+        if (scored) value = add4(sqrt4(value), offset);
+
+        int mask = maskLessEqual(value, splat(bestValue));
+        if (mask == 0) continue;
+
+        store4(values, value);
+        const int lanes = std::min(4, count - i);
+        for (int k = 0; k < lanes; ++k) {
+            if (mask & (1 << k)) consider(values[k], ids[i + k], bestValue, best);
+        }
+    }
+}
+
+#endif
+
+} // namespace
+
+namespace BattleSimd {
+
+// =========================================================
+// 1. 标量参考实现
+// =========================================================
+
+namespace Scalar {
+
+void nearestSq(float px, float py, const float* xs, const float* ys, const int* ids, int count,
+    float& bestDistSq, int& best)
+{
+    for (int i = 0; i < count; ++i) {
+        float dx = xs[i] - px;
+        float dy = ys[i] - py;
+        consider(dx * dx + dy * dy, ids[i], bestDistSq, best);
+    }
+}
+
+void nearestScored(float px, float py, const float* xs, const float* ys, const int* ids, int count,
+    float bias, float& bestScore, int& best)
+{
+    for (int i = 0; i < count; ++i) {
+        float dx = xs[i] - px;
+        float dy = ys[i] - py;
+        consider(std::sqrt(dx * dx + dy * dy) + bias, ids[i], bestScore, best);
+    }
+}
+
+int firstInRect(const BattleRect& rect, const float* xs, const float* ys, int begin, int end)
+{
+    for (int i = begin; i < end; ++i) {
+        if (rect.containsPoint(xs[i], ys[i])) return i;
+    }
+    return end;
+}
+
+} // namespace Scalar
+
+// =========================================================
+// 2. 向量内核（没有可用指令集时转发到标量实现）
+// =========================================================
+
+const char* getBackendName()
+{
+#if defined(BATTLE_SIMD_SSE2)
+    return "SSE2";
+#elif defined(BATTLE_SIMD_NEON)
+    return "NEON";
+#else
+    return "Scalar";
+#endif
+}
+
+#if defined(BATTLE_SIMD_SSE2) || defined(BATTLE_SIMD_NEON)
+
+void nearestSq(float px, float py, const float* xs, const float* ys, const int* ids, int count,
+    float& bestDistSq, int& best)
+{
+    nearestLanes(px, py, xs, ys, ids, count, false, 0.0f, bestDistSq, best);
+}
+
+void nearestScored(float px, float py, const float* xs, const float* ys, const int* ids, int count,
+    float bias, float& bestScore, int& best)
+{
+    nearestLanes(px, py, xs, ys, ids, count, true, bias, bestScore, best);
+}
+
+int firstInRect(const BattleRect& rect, const float* xs, const float* ys, int begin, int end)
+{
+    const Lane4 minX = splat(rect.minX());
+    const Lane4 maxX = splat(rect.maxX());
+    const Lane4 minY = splat(rect.minY());
+    const Lane4 maxY = splat(rect.maxY());
+    float padX[4], padY[4];
+
+    for (int i = begin; i < end; i += 4) {
+        int mask = maskBetween(load4(block(xs, i, end, padX)), minX, maxX)
+            & maskBetween(load4(block(ys, i, end, padY)), minY, maxY);
+        if (mask == 0) continue;
+        for (int k = 0; k < 4; ++k) {
+            if (mask & (1 << k)) return i + k;
+        }
+    }
+    return end;
+}
+
+#else
+
+void nearestSq(float px, float py, const float* xs, const float* ys, const int* ids, int count,
+    float& bestDistSq, int& best)
+{
+    Scalar::nearestSq(px, py, xs, ys, ids, count, bestDistSq, best);
+}
+
+void nearestScored(float px, float py, const float* xs, const float* ys, const int* ids, int count,
+    float bias, float& bestScore, int& best)
+{
+    Scalar::nearestScored(px, py, xs, ys, ids, count, bias, bestScore, best);
+}
+
+int firstInRect(const BattleRect& rect, const float* xs, const float* ys, int begin, int end)
+{
+    return Scalar::firstInRect(rect, xs, ys, begin, end);
+}
+
+#endif
+
+} // namespace BattleSimd
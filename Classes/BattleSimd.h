@@ -0,0 +1,106 @@
+/**
+ * @file       BattleSimd.h
+ * @brief      寻靶热点循环使用的向量化距离 / 范围判定内核
+ * @details    防御建筑索敌、士兵寻靶、围墙搜索与陷阱触发的内层循环都是“一个查询点 × 一批坐标”的
+ *             距离比较或包含判定。坐标按 X / Y 分开打包为连续的 float 数组后，可以一次比较 4 个坐标：
+ *             x86 使用 SSE2，AArch64 使用 NEON，其他平台（或定义 BATTLE_SIMD_DISABLE 时）回退到标量实现。
+ *             每个内核都在 BattleSimd::Scalar 中保留逐个比较的参考实现，向量版只用向量指令排除不可能
+ *             更优的候选，命中的通道再按参考实现的规则（值更小，或相等且编号更小）逐个决出，因此结果逐位一致
+ * @version    1.0
+ * @note       该文件无引擎依赖；不足 4 个的尾部坐标以 NaN（比较恒为假）补齐后仍走向量路径，
+ *             保证同一构建中所有坐标使用相同的浮点运算序列
+ */
+#ifndef BATTLE_SIMD_H_
+#define BATTLE_SIMD_H_
+
+#include <vector>
+#include "BattleTypes.h"
+
+/**
+ * @struct     BattlePointList
+ * @brief      带编号的打包坐标列表（编号 / X / Y 三个平行数组）
+ * @details    空间网格与建筑索引的桶使用该结构，内核直接读取 x.data() / y.data()
+ */
+struct BattlePointList {
+    std::vector<int> ids;    ///< 实体编号
+    std::vector<float> x;    ///< 坐标 X
+    std::vector<float> y;    ///< 坐标 Y
+
+    int size() const { return static_cast<int>(ids.size()); }
+    bool empty() const { return ids.empty(); }
+
+    void clear()
+    {
+        ids.clear();
+        x.clear();
+        y.clear();
+    }
+
+    void push(int id, float px, float py)
+    {
+        ids.push_back(id);
+        x.push_back(px);
+        y.push_back(py);
+    }
+
+    /// 与末尾交换后弹出（不保持顺序，O(1)）
+    void swapRemove(int slot)
+    {
+        ids[slot] = ids.back();
+        x[slot] = x.back();
+        y[slot] = y.back();
+        ids.pop_back();
+        x.pop_back();
+        y.pop_back();
+    }
+};
+
+namespace BattleSimd {
+
+/// 当前构建使用的指令集（"SSE2" / "NEON" / "Scalar"）
+const char* getBackendName();
+
+/**
+ * @brief      按平方距离寻找最近的坐标
+ * @details    平方距离 d 满足 d < bestDistSq，或 d == bestDistSq 且 best 有效、编号小于 best 时替换当前结果；
+ *             bestDistSq 初值即为查询半径的平方（不含边界），可跨多个桶连续调用
+ * @param      px / py     查询点
+ * @param      xs / ys     坐标数组
+ * @param      ids         与坐标对应的编号
+ * @param      count       坐标数量
+ * @param      bestDistSq  当前最优平方距离（输入输出）
+ * @param      best        当前最优编号（输入输出，无结果时为 BATTLE_INVALID_INDEX）
+ */
+void nearestSq(float px, float py, const float* xs, const float* ys, const int* ids, int count,
+    float& bestDistSq, int& best);
+
+/**
+ * @brief      按评分（距离 + 偏置）寻找最优坐标
+ * @details    评分 = sqrt(平方距离) + bias，替换规则与 nearestSq 相同
+ */
+void nearestScored(float px, float py, const float* xs, const float* ys, const int* ids, int count,
+    float bias, float& bestScore, int& best);
+
+/**
+ * @brief      寻找 [begin, end) 中第一个落在矩形内（闭区间）的坐标
+ * @return     int  坐标下标；不存在时返回 end
+ */
+int firstInRect(const BattleRect& rect, const float* xs, const float* ys, int begin, int end);
+
+/**
+ * @namespace  BattleSimd::Scalar
+ * @brief      逐个比较的标量参考实现（语义与同名向量内核完全相同）
+ */
+namespace Scalar {
+
+void nearestSq(float px, float py, const float* xs, const float* ys, const int* ids, int count,
+    float& bestDistSq, int& best);
+void nearestScored(float px, float py, const float* xs, const float* ys, const int* ids, int count,
+    float bias, float& bestScore, int& best);
+int firstInRect(const BattleRect& rect, const float* xs, const float* ys, int begin, int end);
+
+} // namespace Scalar
+
+} // namespace BattleSimd
+
+#endif // BATTLE_SIMD_H_
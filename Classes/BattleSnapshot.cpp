@@ -0,0 +1,182 @@
+/**
+ * @file       BattleSnapshot.cpp
+ * @brief      战斗状态快照、快照环形缓冲与续玩存档的实现
+ * @version    1.0
+ */
+#include "BattleSnapshot.h"
+#include <cstring>
+#include "BattleProjectilePool.h"
+#include "BattleReplay.h"
+#include "BattleWorld.h"
+
+namespace {
+
+/// 每个单位在快照中占用的字节数（BattleUnitStore 全部字段）
+const size_t UNIT_BYTES = 6 * sizeof(uint8_t)   // type / flying / state / facingLeft / alive / team
+    + 9 * sizeof(float)                         // x / y / prevX / prevY / attackRange / attackInterval / attackTimer / moveSpeed / halfSize
+    + 6 * sizeof(int);                          // hp / maxHp / attackDamage / target / foe / home
+
+/// 每座建筑在快照中占用的字节数（hp / attack / attackTimer / destroyed / garrison / alerted）
+const size_t BUILDING_BYTES = 3 * sizeof(int) + sizeof(float) + 2 * sizeof(uint8_t);
+
+/// 续玩存档魔数
+const uint8_t CHECKPOINT_MAGIC[4] = { 'C', 'O', 'C', 'P' };
+
+void writeU32(std::vector<uint8_t>& out, uint32_t v)
+{
+    for (int i = 0; i < 4; ++i) out.push_back(static_cast<uint8_t>(v >> (8 * i)));
+}
+
+uint32_t readU32(const uint8_t* p)
+{
+    uint32_t v = 0;
+    for (int i = 0; i < 4; ++i) v |= static_cast<uint32_t>(p[i]) << (8 * i);
+    return v;
+}
+
+} // namespace
+
+// =========================================================
+// 1. 快照
+// =========================================================
+
+BattleSnapshot::BattleSnapshot()
+{
+    std::memset(&_header, 0, sizeof(_header));
+}
+
+size_t BattleSnapshot::payloadSize(const BattleSnapshotHeader& header)
+{
+    return header.unitCount * UNIT_BYTES
+        + header.buildingCount * BUILDING_BYTES
+        + header.trapCount * sizeof(uint8_t)
+        + header.projectileSlotCount * sizeof(BattleProjectile)
+        + (header.projectileFreeCount + header.projectileActiveCount) * sizeof(int);
+}
+
+void BattleSnapshot::serialize(std::vector<uint8_t>& out) const
+{
+    const uint8_t* header = reinterpret_cast<const uint8_t*>(&_header);
+    out.insert(out.end(), header, header + sizeof(_header));
+    out.insert(out.end(), _payload.begin(), _payload.end());
+}
+
+bool BattleSnapshot::deserialize(const uint8_t* data, size_t size)
+{
+    invalidate();
+    if (!data || size < sizeof(_header)) return false;
+
+    BattleSnapshotHeader header;
+    std::memcpy(&header, data, sizeof(header));
+    if (header.magic != MAGIC || header.version != FORMAT_VERSION) return false;
+    // 槽位数量必须容纳空闲栈与活动列表，避免恢复出越界的槽位索引
+    if (header.projectileFreeCount + header.projectileActiveCount > header.projectileSlotCount) return false;
+    if (size - sizeof(header) != payloadSize(header)) return false;
+
+    _payload.assign(data + sizeof(header), data + size);
+    _header = header;
+    return true;
+}
+
+// =========================================================
+// 2. 快照环形缓冲
+// =========================================================
+
+BattleSnapshotRing::BattleSnapshotRing()
+    : _interval(1)
+    , _head(0)
+    , _count(0)
+{
+}
+
+void BattleSnapshotRing::configure(int capacity, int interval)
+{
+    _slots.resize(capacity > 0 ? static_cast<size_t>(capacity) : 1);
+    _interval = interval > 0 ? interval : 1;
+    clear();
+}
+
+void BattleSnapshotRing::clear()
+{
+    for (BattleSnapshot& slot : _slots) slot.invalidate();
+    _head = 0;
+    _count = 0;
+}
+
+bool BattleSnapshotRing::tryCapture(const BattleWorld& world, int tick)
+{
+    if (_slots.empty() || tick % _interval != 0) return false;
+    // 同一步重复调用（例如回退后重新推进到同一步）只保留一份
+    const BattleSnapshot* last = latest();
+    if (last && last->getTick() >= tick) return false;
+    capture(world, tick);
+    return true;
+}
+
+void BattleSnapshotRing::capture(const BattleWorld& world, int tick)
+{
+    if (_slots.empty()) configure(1, _interval);
+    world.captureSnapshot(_slots[_head], tick);
+    _head = (_head + 1) % static_cast<int>(_slots.size());
+    if (_count < static_cast<int>(_slots.size())) _count++;
+}
+
+const BattleSnapshot* BattleSnapshotRing::latest() const
+{
+    if (_count == 0) return nullptr;
+    const int size = static_cast<int>(_slots.size());
+    return &_slots[(_head - 1 + size) % size];
+}
+
+const BattleSnapshot* BattleSnapshotRing::findAtOrBefore(int tick) const
+{
+    // 从最新往最旧找，快照的步号沿写入顺序递增
+    const int size = static_cast<int>(_slots.size());
+    for (int k = 1; k <= _count; ++k) {
+        const BattleSnapshot& snapshot = _slots[(_head - k + size) % size];
+        if (snapshot.getTick() <= tick) return &snapshot;
+    }
+    return nullptr;
+}
+
+void BattleSnapshotRing::discardAfter(int tick)
+{
+    const int size = static_cast<int>(_slots.size());
+    while (_count > 0) {
+        int last = (_head - 1 + size) % size;
+        if (_slots[last].getTick() <= tick) break;
+        _slots[last].invalidate();
+        _head = last;
+        _count--;
+    }
+}
+
+// =========================================================
+// 3. 续玩存档
+// =========================================================
+
+namespace BattleCheckpoint {
+
+void write(const BattleReplay& replay, const BattleSnapshot& snapshot, std::vector<uint8_t>& out)
+{
+    std::vector<uint8_t> replayBytes;
+    replay.serialize(replayBytes);
+
+    out.insert(out.end(), CHECKPOINT_MAGIC, CHECKPOINT_MAGIC + 4);
+    writeU32(out, static_cast<uint32_t>(replayBytes.size()));
+    out.insert(out.end(), replayBytes.begin(), replayBytes.end());
+    snapshot.serialize(out);
+}
+
+bool read(const uint8_t* data, size_t size, BattleReplay& replay, BattleSnapshot& snapshot)
+{
+    if (!data || size < 8 || std::memcmp(data, CHECKPOINT_MAGIC, 4) != 0) return false;
+    const size_t replaySize = readU32(data + 4);
+    if (size - 8 < replaySize) return false;
+    if (!replay.deserialize(data + 8, replaySize)) return false;
+    if (!snapshot.deserialize(data + 8 + replaySize, size - 8 - replaySize)) return false;
+    // 快照必须落在录像的时间线上
+    return snapshot.getTick() == replay.getTickCount();
+}
+
+} // namespace BattleCheckpoint
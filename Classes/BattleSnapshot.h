@@ -0,0 +1,185 @@
+/**
+ * @file       BattleSnapshot.h
+ * @brief      战斗状态快照、快照环形缓冲与续玩存档
+ * @details    快照把 BattleWorld 中随战斗变化的全部状态（单位的全部字段、建筑血量/攻击/计时/摧毁标志、
+ *             陷阱爆炸标志、弹道池的槽位/空闲栈/活动列表、剩余兵力、战斗结果与模拟时间）按数组逐段 memcpy
+ *             到一块连续的字节缓冲区中；关卡布局、寻靶索引、流场、占据栅格等派生结构不进入快照，
+ *             恢复时由关卡描述重建后再按快照中的摧毁标志更新。
+ *             BattleSnapshotRing 每隔固定步数把快照写入预分配的环形缓冲（复用槽位的缓冲区，稳定后不再分配内存），
+ *             用于调试用的即时回退；BattleCheckpoint 把录像与最近一次快照打包成续玩存档，
+ *             进程被切到后台或意外退出后可以从存档直接恢复战斗
+ * @version    1.0
+ * @note       该文件无引擎依赖；快照缓冲区使用本机字节序与内存布局，只用于同一设备上的回退与续玩，
+ *             不作为跨平台的交换格式（跨设备分享请使用 BattleReplay）
+ */
+#ifndef BATTLE_SNAPSHOT_H_
+#define BATTLE_SNAPSHOT_H_
+
+#include <vector>
+#include "BattleTypes.h"
+
+class BattleReplay;
+class BattleWorld;
+
+/**
+ * @struct     BattleSnapshotHeader
+ * @brief      快照头：步号、标量状态与各段数组的长度
+ */
+struct BattleSnapshotHeader {
+    uint32_t magic;                             ///< 魔数 "COCS"
+    uint32_t version;                           ///< 快照格式版本
+    uint32_t tick;                              ///< 截取时已推进的步数
+    float elapsed;                              ///< 模拟总时间（秒）
+    uint32_t steps;                             ///< 世界已推进的步数（AI 错峰相位）
+    uint32_t separationCursor;                  ///< 兵群分离下一步开始处理的单位索引
+    int32_t reserve[BATTLE_SOLDIER_TYPE_COUNT]; ///< 各兵种剩余可投放数量
+    uint32_t outcome;                           ///< 战斗结果（BattleOutcome）
+    uint32_t unitCount;                         ///< 单位数量
+    uint32_t buildingCount;                     ///< 建筑数量（需与关卡一致）
+    uint32_t trapCount;                         ///< 陷阱数量（需与关卡一致）
+    uint32_t projectileSlotCount;               ///< 弹道池槽位数量
+    uint32_t projectileFreeCount;               ///< 弹道池空闲栈长度
+    uint32_t projectileActiveCount;             ///< 飞行中的弹道数量
+};
+
+/**
+ * @class      BattleSnapshot
+ * @brief      某一步的完整战斗状态（扁平字节缓冲区）
+ * @details    由 BattleWorld::captureSnapshot 写入、BattleWorld::restoreSnapshot 读取；
+ *             同一个对象反复截取时复用已有缓冲区
+ */
+class BattleSnapshot
+{
+public:
+    /// 快照魔数
+    static const uint32_t MAGIC = 0x53434F43u; // "COCS"
+
+    /// 当前快照格式版本（2：快照头增加世界步数；3：增加兵群分离游标；4：增加守军与兵营状态）
+    static const uint32_t FORMAT_VERSION = 4;
+
+    BattleSnapshot();
+
+    /// 是否包含有效快照
+    bool isValid() const { return _header.magic == MAGIC; }
+
+    /// 使快照失效（缓冲区保留，供下次截取复用）
+    void invalidate() { _header.magic = 0; }
+
+    /// 截取时已推进的步数
+    int getTick() const { return static_cast<int>(_header.tick); }
+
+    /// 截取时的模拟总时间（秒）
+    float getElapsedTime() const { return _header.elapsed; }
+
+    /// 快照中的单位数量
+    int getUnitCount() const { return static_cast<int>(_header.unitCount); }
+
+    /// 快照头
+    const BattleSnapshotHeader& header() const { return _header; }
+
+    /// 数组段（按 BattleWorld::captureSnapshot 的写入顺序排列）
+    const std::vector<uint8_t>& payload() const { return _payload; }
+
+    /// 快照占用的字节数（头 + 数组段）
+    size_t getByteSize() const { return sizeof(_header) + _payload.size(); }
+
+    /**
+     * @brief      按快照头中的数组长度计算数组段的字节数
+     */
+    static size_t payloadSize(const BattleSnapshotHeader& header);
+
+    /**
+     * @brief      追加序列化到字节缓冲区（快照头 + 数组段）
+     */
+    void serialize(std::vector<uint8_t>& out) const;
+
+    /**
+     * @brief      从字节缓冲区读取快照
+     * @return     bool  魔数、版本或长度不合法时返回 false，此时快照被置为无效
+     */
+    bool deserialize(const uint8_t* data, size_t size);
+
+private:
+    friend class BattleWorld;
+
+    BattleSnapshotHeader _header;   ///< 快照头
+    std::vector<uint8_t> _payload;  ///< 各数组段依次拼接的字节
+};
+
+/**
+ * @class      BattleSnapshotRing
+ * @brief      固定容量的快照环形缓冲
+ * @details    使用流程：configure(capacity, interval) -> 每推进一步后 tryCapture(world, tick)，
+ *             步号为 interval 的整数倍时覆盖最旧的槽位；回退时用 findAtOrBefore(tick) 取出快照恢复，
+ *             再调用 discardAfter(tick) 丢弃回退点之后的快照
+ */
+class BattleSnapshotRing
+{
+public:
+    BattleSnapshotRing();
+
+    /**
+     * @brief      设置容量与截取间隔，并清空已有快照
+     * @param      capacity  保存的快照数量
+     * @param      interval  截取间隔（步）
+     */
+    void configure(int capacity, int interval);
+
+    /// 清空全部快照（保留缓冲区）
+    void clear();
+
+    /**
+     * @brief      步号为截取间隔的整数倍时截取一份快照
+     * @return     bool  本次是否截取
+     */
+    bool tryCapture(const BattleWorld& world, int tick);
+
+    /// 无条件截取一份快照，覆盖最旧的槽位
+    void capture(const BattleWorld& world, int tick);
+
+    /**
+     * @brief      查找步号不大于 tick 的最新快照
+     * @return     const BattleSnapshot*  不存在时返回 nullptr
+     */
+    const BattleSnapshot* findAtOrBefore(int tick) const;
+
+    /// 最新的快照；没有快照时返回 nullptr
+    const BattleSnapshot* latest() const;
+
+    /// 丢弃步号大于 tick 的快照（回退后这些快照已不在新的时间线上）
+    void discardAfter(int tick);
+
+    /// 当前保存的快照数量
+    int getCount() const { return _count; }
+
+    /// 截取间隔（步）
+    int getInterval() const { return _interval; }
+
+private:
+    std::vector<BattleSnapshot> _slots;   ///< 快照槽位（按环形顺序复用）
+    int _interval;                        ///< 截取间隔（步）
+    int _head;                            ///< 下一次写入的槽位
+    int _count;                           ///< 有效快照数量
+};
+
+/**
+ * @namespace  BattleCheckpoint
+ * @brief      续玩存档：录像 + 最近一次快照
+ * @details    录像保证恢复后的战斗仍能从头完整回放，快照让恢复不必从第 0 步重新模拟
+ */
+namespace BattleCheckpoint {
+
+/**
+ * @brief      把录像与快照打包为续玩存档
+ */
+void write(const BattleReplay& replay, const BattleSnapshot& snapshot, std::vector<uint8_t>& out);
+
+/**
+ * @brief      读取续玩存档
+ * @return     bool  魔数、长度或任一部分不合法时返回 false
+ */
+bool read(const uint8_t* data, size_t size, BattleReplay& replay, BattleSnapshot& snapshot);
+
+} // namespace BattleCheckpoint
+
+#endif // BATTLE_SNAPSHOT_H_
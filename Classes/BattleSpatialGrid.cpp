@@ -0,0 +1,183 @@
+/**
+ * @file       BattleSpatialGrid.cpp
+ * @brief      均匀空间哈希网格的实现
+ * @version    1.0
+ */
+#include "BattleSpatialGrid.h"
+#include <algorithm>
+
+BattleSpatialGrid::BattleSpatialGrid()
+    : _cellSize(1.0f)
+    , _cols(1)
+    , _rows(1)
+{
+    _buckets.resize(LAYER_COUNT);
+}
+
+void BattleSpatialGrid::reset(float width, float height, float cellSize)
+{
+    _cellSize = cellSize > 1.0f ? cellSize : 1.0f;
+    _cols = std::max(1, static_cast<int>(std::ceil(width / _cellSize)));
+    _rows = std::max(1, static_cast<int>(std::ceil(height / _cellSize)));
+
+    _buckets.assign(static_cast<size_t>(_cols) * _rows * LAYER_COUNT, BattlePointList());
+    _entryBucket.clear();
+    _entrySlot.clear();
+    _entryLayer.clear();
+}
+
+int BattleSpatialGrid::columnOf(float x) const
+{
+    int col = static_cast<int>(std::floor(x / _cellSize));
+    return std::min(std::max(col, 0), _cols - 1);
+}
+
+int BattleSpatialGrid::rowOf(float y) const
+{
+    int row = static_cast<int>(std::floor(y / _cellSize));
+    return std::min(std::max(row, 0), _rows - 1);
+}
+
+int BattleSpatialGrid::bucketOf(const BattleVec2& pos, int layer) const
+{
+    return (rowOf(pos.y) * _cols + columnOf(pos.x)) * LAYER_COUNT + layer;
+}
+
+void BattleSpatialGrid::insert(int id, const BattleVec2& pos, Layer layer)
+{
+    if (id < 0) return;
+    if (static_cast<size_t>(id) >= _entryBucket.size()) {
+        _entryBucket.resize(id + 1, BATTLE_INVALID_INDEX);
+        _entrySlot.resize(id + 1, 0);
+        _entryLayer.resize(id + 1, 0);
+    }
+    if (_entryBucket[id] != BATTLE_INVALID_INDEX) unlink(id);
+
+    _entryLayer[id] = static_cast<uint8_t>(layer);
+    link(id, bucketOf(pos, layer), pos);
+}
+
+void BattleSpatialGrid::update(int id, const BattleVec2& pos)
+{
+    if (!contains(id)) return;
+    int target = bucketOf(pos, _entryLayer[id]);
+    if (target == _entryBucket[id]) {
+        BattlePointList& bucket = _buckets[target];
+        bucket.x[_entrySlot[id]] = pos.x;
+        bucket.y[_entrySlot[id]] = pos.y;
+        return;
+    }
+
+    unlink(id);
+    link(id, target, pos);
+}
+
+void BattleSpatialGrid::remove(int id)
+{
+    if (contains(id)) unlink(id);
+}
+
+bool BattleSpatialGrid::contains(int id) const
+{
+    return id >= 0 && static_cast<size_t>(id) < _entryBucket.size() && _entryBucket[id] != BATTLE_INVALID_INDEX;
+}
+
+BattleGridCellRange BattleSpatialGrid::cellsInRadius(const BattleVec2& center, float radius) const
+{
+    BattleGridCellRange range;
+    range.minCol = columnOf(center.x - radius);
+    range.maxCol = columnOf(center.x + radius);
+    range.minRow = rowOf(center.y - radius);
+    range.maxRow = rowOf(center.y + radius);
+    return range;
+}
+
+int BattleSpatialGrid::findKNearest(const BattleVec2& center, float radius, int layers, int k,
+    int* outIds, float* outDistSq) const
+{
+    k = std::min(k, static_cast<int>(MAX_NEAREST));
+    if (k <= 0 || radius < 0.0f) return 0;
+
+    int ids[MAX_NEAREST];
+    float dists[MAX_NEAREST];
+    int found = 0;
+    const float radiusSq = radius * radius;
+    const int col0 = columnOf(center.x);
+    const int row0 = rowOf(center.y);
+    const int maxRing = std::max(std::max(col0, _cols - 1 - col0), std::max(row0, _rows - 1 - row0));
+
+    for (int ring = 0; ring <= maxRing; ++ring) {
+        // 第 ring 圈的格子与查询点至少相隔 ring - 1 个格子
+        const float gap = ring > 0 ? (ring - 1) * _cellSize : 0.0f;
+        if (gap * gap > radiusSq || (found == k && gap * gap > dists[k - 1])) break;
+
+        for (int row = row0 - ring; row <= row0 + ring; ++row) {
+            if (row < 0 || row >= _rows) continue;
+            const bool edgeRow = row == row0 - ring || row == row0 + ring;
+            for (int col = col0 - ring; col <= col0 + ring; col += edgeRow ? 1 : ring * 2) {
+                if (col >= 0 && col < _cols) {
+                    for (int layer = 0; layer < LAYER_COUNT; ++layer) {
+                        if (!(layers & (1 << layer))) continue;
+                        const BattlePointList& bucket = _buckets[(row * _cols + col) * LAYER_COUNT + layer];
+                        for (int s = 0; s < bucket.size(); ++s) {
+                            const float dx = bucket.x[s] - center.x;
+                            const float dy = bucket.y[s] - center.y;
+                            const float d = dx * dx + dy * dy;
+                            const int id = bucket.ids[s];
+                            if (d > radiusSq) continue;
+                            if (found == k && (d > dists[k - 1] || (d == dists[k - 1] && id > ids[k - 1]))) continue;
+
+                            // 插入排序：按 (距离, 索引) 升序
+                            int pos = found < k ? found++ : k - 1;
+                            while (pos > 0 && (dists[pos - 1] > d || (dists[pos - 1] == d && ids[pos - 1] > id))) {
+                                dists[pos] = dists[pos - 1];
+                                ids[pos] = ids[pos - 1];
+                                --pos;
+                            }
+                            dists[pos] = d;
+                            ids[pos] = id;
+                        }
+                    }
+                }
+                if (ring == 0) break;
+            }
+        }
+    }
+
+    for (int n = 0; n < found; ++n) {
+        outIds[n] = ids[n];
+        if (outDistSq) outDistSq[n] = dists[n];
+    }
+    return found;
+}
+
+BattleGridCellRange BattleSpatialGrid::cellsInRect(const BattleRect& rect) const
+{
+    BattleGridCellRange range;
+    range.minCol = columnOf(rect.minX());
+    range.maxCol = columnOf(rect.maxX());
+    range.minRow = rowOf(rect.minY());
+    range.maxRow = rowOf(rect.maxY());
+    return range;
+}
+
+void BattleSpatialGrid::link(int id, int bucketIndex, const BattleVec2& pos)
+{
+    BattlePointList& bucket = _buckets[bucketIndex];
+    _entryBucket[id] = bucketIndex;
+    _entrySlot[id] = bucket.size();
+    bucket.push(id, pos.x, pos.y);
+}
+
+void BattleSpatialGrid::unlink(int id)
+{
+    BattlePointList& bucket = _buckets[_entryBucket[id]];
+    int slot = _entrySlot[id];
+    int last = bucket.ids.back();
+
+    // 与末尾交换后弹出，保持 O(1)
+    _entrySlot[last] = slot;
+    bucket.swapRemove(slot);
+
+    _entryBucket[id] = BATTLE_INVALID_INDEX;
+}
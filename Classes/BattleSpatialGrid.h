@@ -0,0 +1,138 @@
+/**
+ * @file       BattleSpatialGrid.h
+ * @brief      战斗核心使用的均匀空间哈希网格
+ * @details    把地图节点坐标系按固定边长切分为网格，每个格子按层（地面 / 空中）各维护一个实体索引桶。
+ *             实体移动时只在跨格时迁移桶，查询时只遍历与查询圆的包围盒相交的格子，
+ *             把“每座防御塔遍历全部士兵”的 O(塔数 × 士兵数) 索敌降为只访问射程附近的少量格子。
+ *             桶内除实体索引外还打包保存实体坐标，索敌可以直接对桶调用 BattleSimd 的向量内核
+ * @version    1.0
+ * @note       该类无引擎依赖；超出地图范围的坐标会被钳制到边缘格子，因此地图外的实体同样可以被查询到
+ */
+#ifndef BATTLE_SPATIAL_GRID_H_
+#define BATTLE_SPATIAL_GRID_H_
+
+#include <vector>
+#include "BattleTypes.h"
+#include "BattleSimd.h"
+
+/**
+ * @struct     BattleGridCellRange
+ * @brief      网格查询覆盖的格子范围（闭区间）
+ */
+struct BattleGridCellRange {
+    int minCol;
+    int minRow;
+    int maxCol;
+    int maxRow;
+};
+
+/**
+ * @class      BattleSpatialGrid
+ * @brief      按层分桶的均匀空间哈希网格
+ * @details    实体以非负整数索引标识（与 BattleUnitStore 下标一致），每个实体同一时刻只位于一个桶中；
+ *             桶内移除采用“与末尾交换”的方式，插入、迁移、移除均为 O(1)
+ */
+class BattleSpatialGrid
+{
+public:
+    /// 实体所在的层：防御建筑的对空/对地规则直接对应到层
+    enum Layer {
+        GROUND = 0,     ///< 地面单位
+        AIR = 1,        ///< 空中单位
+        LAYER_COUNT = 2
+    };
+
+    BattleSpatialGrid();
+
+    /**
+     * @brief      重建网格并清空所有实体
+     * @param      width     覆盖区域宽度（像素）
+     * @param      height    覆盖区域高度（像素）
+     * @param      cellSize  格子边长（像素）
+     */
+    void reset(float width, float height, float cellSize);
+
+    /**
+     * @brief      插入实体（已存在时等价于先移除再插入）
+     * @param      id     实体索引
+     * @param      pos    实体位置
+     * @param      layer  实体所在层
+     */
+    void insert(int id, const BattleVec2& pos, Layer layer);
+
+    /**
+     * @brief      实体移动后更新其所在格子与桶内坐标，仅在跨格时迁移桶
+     * @param      id   实体索引（未插入时忽略）
+     * @param      pos  实体新位置
+     */
+    void update(int id, const BattleVec2& pos);
+
+    /**
+     * @brief      移除实体（未插入时忽略）
+     */
+    void remove(int id);
+
+    /// 实体当前是否在网格中
+    bool contains(int id) const;
+
+    /**
+     * @brief      计算与圆（中心 + 半径）的包围盒相交的格子范围
+     * @param      center  圆心
+     * @param      radius  半径
+     * @return     BattleGridCellRange  已钳制到网格内的格子范围
+     */
+    BattleGridCellRange cellsInRadius(const BattleVec2& center, float radius) const;
+
+    /**
+     * @brief      计算与矩形相交的格子范围
+     * @param      rect  矩形
+     * @return     BattleGridCellRange  已钳制到网格内的格子范围
+     */
+    BattleGridCellRange cellsInRect(const BattleRect& rect) const;
+
+    /**
+     * @brief      按距离由近到远查找至多 k 个实体
+     * @details    从查询点所在格子开始逐圈向外扩展，一圈格子的最近可能距离超过查询半径或当前第 k 近的距离时停止，
+     *             只访问查询点附近的少量格子；距离相同按索引取小，结果与桶内顺序无关
+     * @param      center     查询点
+     * @param      radius     最大距离（含边界）
+     * @param      layers     参与查询的层（1 << Layer 的组合）
+     * @param      k          最多返回的数量（超过 MAX_NEAREST 时按 MAX_NEAREST 处理）
+     * @param      outIds     输出的实体索引（按距离升序，容量不少于 k）
+     * @param      outDistSq  输出的平方距离（可为空）
+     * @return     int        实际找到的数量
+     */
+    int findKNearest(const BattleVec2& center, float radius, int layers, int k, int* outIds, float* outDistSq) const;
+
+    /// findKNearest 单次最多返回的数量
+    static const int MAX_NEAREST = 16;
+
+    /**
+     * @brief      获取某个格子某一层的实体桶（实体索引 + 打包坐标）
+     */
+    const BattlePointList& bucket(int col, int row, Layer layer) const
+    {
+        return _buckets[(row * _cols + col) * LAYER_COUNT + layer];
+    }
+
+    int getColumnCount() const { return _cols; }
+    int getRowCount() const { return _rows; }
+    float getCellSize() const { return _cellSize; }
+
+private:
+    int columnOf(float x) const;
+    int rowOf(float y) const;
+    int bucketOf(const BattleVec2& pos, int layer) const;
+    void link(int id, int bucketIndex, const BattleVec2& pos);
+    void unlink(int id);
+
+    float _cellSize;                           ///< 格子边长
+    int _cols;                                 ///< 列数
+    int _rows;                                 ///< 行数
+    std::vector<BattlePointList> _buckets;     ///< 桶：(格子 * LAYER_COUNT + 层)
+    std::vector<int> _entryBucket;             ///< 实体所在桶（-1 表示不在网格中）
+    std::vector<int> _entrySlot;               ///< 实体在桶中的下标
+    std::vector<uint8_t> _entryLayer;          ///< 实体所在层
+};
+
+#endif // BATTLE_SPATIAL_GRID_H_
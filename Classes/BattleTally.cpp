@@ -0,0 +1,70 @@
+/**
+ * @file       BattleTally.cpp
+ * @brief      战斗存活计数的实现
+ * @version    1.0
+ */
+#include "BattleTally.h"
+
+BattleTally::BattleTally()
+{
+    reset();
+}
+
+void BattleTally::reset()
+{
+    for (int i = 0; i <= BATTLE_ENEMY_TYPE_COUNT; ++i) {
+        _aliveBuildings[i] = 0;
+        _totalBuildings[i] = 0;
+    }
+    for (int i = 0; i < BATTLE_SOLDIER_TYPE_COUNT; ++i) _aliveUnits[i] = 0;
+    _aliveNonWall = 0;
+    _totalNonWall = 0;
+    _aliveUnitTotal = 0;
+}
+
+void BattleTally::addBuilding(EnemyType type, bool destroyed)
+{
+    const int bucket = bucketOf(type);
+    const bool counted = type != EnemyType::WALL;
+    _totalBuildings[bucket]++;
+    if (counted) _totalNonWall++;
+    if (destroyed) return;
+
+    _aliveBuildings[bucket]++;
+    if (counted) _aliveNonWall++;
+}
+
+void BattleTally::onBuildingDestroyed(EnemyType type)
+{
+    _aliveBuildings[bucketOf(type)]--;
+    if (type != EnemyType::WALL) _aliveNonWall--;
+}
+
+void BattleTally::onUnitDeployed(SoldierType type)
+{
+    int index = static_cast<int>(type);
+    if (index < 0 || index >= BATTLE_SOLDIER_TYPE_COUNT) return;
+    _aliveUnits[index]++;
+    _aliveUnitTotal++;
+}
+
+void BattleTally::onUnitDied(SoldierType type)
+{
+    int index = static_cast<int>(type);
+    if (index < 0 || index >= BATTLE_SOLDIER_TYPE_COUNT) return;
+    _aliveUnits[index]--;
+    _aliveUnitTotal--;
+}
+
+int BattleTally::getAliveUnitCount(SoldierType type) const
+{
+    int index = static_cast<int>(type);
+    if (index < 0 || index >= BATTLE_SOLDIER_TYPE_COUNT) return 0;
+    return _aliveUnits[index];
+}
+
+int BattleTally::getDestructionPercent() const
+{
+    if (_totalNonWall <= 0) return 100;
+    return (_totalNonWall - _aliveNonWall) * 100 / _totalNonWall;
+}
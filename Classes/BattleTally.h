@@ -0,0 +1,82 @@
+/**
+ * @file       BattleTally.h
+ * @brief      战斗存活计数（按建筑类型 / 兵种分类）
+ * @details    载入关卡时统计各类建筑总数，之后只在建筑摧毁、士兵投放与阵亡时做 O(1) 增减；
+ *             胜负判定（非围墙建筑是否全部摧毁、战场是否还有士兵）与摧毁百分比都直接读取计数，
+ *             不再每一步遍历全部建筑与单位
+ * @version    1.0
+ * @note       摧毁百分比按非围墙建筑数量计算（围墙不计入，与胜利条件一致），向下取整
+ */
+#ifndef BATTLE_TALLY_H_
+#define BATTLE_TALLY_H_
+
+#include "BattleTypes.h"
+
+/**
+ * @class      BattleTally
+ * @brief      按类别维护的存活计数
+ */
+class BattleTally
+{
+public:
+    BattleTally();
+
+    /// 清空全部计数（载入关卡时调用）
+    void reset();
+
+    /**
+     * @brief      登记一座建筑
+     * @param      type       建筑类型
+     * @param      destroyed  载入时是否已被摧毁（无血量）
+     */
+    void addBuilding(EnemyType type, bool destroyed);
+
+    /// 建筑被摧毁
+    void onBuildingDestroyed(EnemyType type);
+
+    /// 士兵投放
+    void onUnitDeployed(SoldierType type);
+
+    /// 士兵阵亡
+    void onUnitDied(SoldierType type);
+
+    /// 指定类型的存活建筑数量
+    int getAliveBuildingCount(EnemyType type) const { return _aliveBuildings[bucketOf(type)]; }
+
+    /// 指定类型的建筑总数
+    int getTotalBuildingCount(EnemyType type) const { return _totalBuildings[bucketOf(type)]; }
+
+    /// 存活的非围墙建筑数量（为 0 即满足胜利条件）
+    int getAliveNonWallCount() const { return _aliveNonWall; }
+
+    /// 非围墙建筑总数
+    int getTotalNonWallCount() const { return _totalNonWall; }
+
+    /// 战场上存活的士兵数量
+    int getAliveUnitCount() const { return _aliveUnitTotal; }
+
+    /// 指定兵种存活的士兵数量
+    int getAliveUnitCount(SoldierType type) const;
+
+    /**
+     * @brief      摧毁百分比 [0, 100]
+     * @return     int  已摧毁的非围墙建筑占比（向下取整）；没有非围墙建筑时为 100
+     */
+    int getDestructionPercent() const;
+
+private:
+    /// 建筑类型 -> 计数桶（未知类型统一放在最后一个桶）
+    static int bucketOf(EnemyType type) {
+        int index = static_cast<int>(type);
+        return (index >= 0 && index < BATTLE_ENEMY_TYPE_COUNT) ? index : BATTLE_ENEMY_TYPE_COUNT;
+    }
+
+    int _aliveBuildings[BATTLE_ENEMY_TYPE_COUNT + 1];  ///< 各类型存活建筑数量
+    int _totalBuildings[BATTLE_ENEMY_TYPE_COUNT + 1];  ///< 各类型建筑总数
+    int _aliveNonWall;                                 ///< 存活的非围墙建筑数量
+    int _totalNonWall;                                 ///< 非围墙建筑总数
+    int _aliveUnits[BATTLE_SOLDIER_TYPE_COUNT];        ///< 各兵种存活士兵数量
+    int _aliveUnitTotal;                               ///< 存活士兵总数
+};
+
+#endif // BATTLE_TALLY_H_
@@ -0,0 +1,188 @@
+/**
+ * @file       BattleTargetIndex.cpp
+ * @brief      士兵寻靶建筑索引的实现
+ * @version    1.0
+ */
+#include "BattleTargetIndex.h"
+#include "BattleRules.h"
+#include <algorithm>
+#include <cfloat>
+
+BattleTargetIndex::BattleTargetIndex()
+    : _cellSize(1.0f)
+    , _cols(1)
+    , _rows(1)
+    , _totalAlive(0)
+    , _reachX(0.0f)
+    , _reachY(0.0f)
+{
+    for (int t = 0; t < BATTLE_ENEMY_TYPE_COUNT; ++t) _aliveCount[t] = 0;
+    for (int s = 0; s < BATTLE_SOLDIER_TYPE_COUNT; ++s) {
+        for (int t = 0; t < BATTLE_ENEMY_TYPE_COUNT; ++t) _typeOrder[s][t] = t;
+    }
+}
+
+void BattleTargetIndex::build(const std::vector<BattleBuildingDesc>& buildings, float width, float height, float cellSize)
+{
+    _cellSize = cellSize > 1.0f ? cellSize : 1.0f;
+    _cols = std::max(1, static_cast<int>(std::ceil(width / _cellSize)));
+    _rows = std::max(1, static_cast<int>(std::ceil(height / _cellSize)));
+    const int cellCount = _cols * _rows;
+
+    _cells.assign(static_cast<size_t>(cellCount) * BATTLE_ENEMY_TYPE_COUNT, BattlePointList());
+    _type.assign(buildings.size(), 0);
+    _cellOf.assign(buildings.size(), BATTLE_INVALID_INDEX);
+    for (int t = 0; t < BATTLE_ENEMY_TYPE_COUNT; ++t) _aliveCount[t] = 0;
+    _totalAlive = 0;
+    _reachX = 0.0f;
+    _reachY = 0.0f;
+
+    for (size_t b = 0; b < buildings.size(); ++b) {
+        const BattleBuildingDesc& desc = buildings[b];
+        int type = static_cast<int>(desc.type);
+        _type[b] = static_cast<uint8_t>(type);
+        // 初始即无血量的建筑与未知类型不参与寻靶
+        if (desc.hp <= 0 || type < 0 || type >= BATTLE_ENEMY_TYPE_COUNT) continue;
+
+        int cell = rowOf(desc.position.y) * _cols + columnOf(desc.position.x);
+        _cellOf[b] = cell;
+        _cells[static_cast<size_t>(type) * cellCount + cell].push(static_cast<int>(b), desc.position.x, desc.position.y);
+        _aliveCount[type]++;
+        _totalAlive++;
+
+        const BattleRect& f = desc.footprint;
+        _reachX = std::max(_reachX, std::max(desc.position.x - f.minX(), f.maxX() - desc.position.x));
+        _reachY = std::max(_reachY, std::max(desc.position.y - f.minY(), f.maxY() - desc.position.y));
+    }
+
+    // 按偏置排序类型，偏置相同保持枚举顺序
+    for (int s = 0; s < BATTLE_SOLDIER_TYPE_COUNT; ++s) {
+        int* order = _typeOrder[s];
+        for (int t = 0; t < BATTLE_ENEMY_TYPE_COUNT; ++t) order[t] = t;
+        std::stable_sort(order, order + BATTLE_ENEMY_TYPE_COUNT, [s](int a, int b) {
+            return BattleRules::targetBias(static_cast<SoldierType>(s), static_cast<EnemyType>(a))
+                < BattleRules::targetBias(static_cast<SoldierType>(s), static_cast<EnemyType>(b));
+        });
+    }
+}
+
+void BattleTargetIndex::remove(int building)
+{
+    if (building < 0 || static_cast<size_t>(building) >= _cellOf.size()) return;
+    int cell = _cellOf[building];
+    if (cell == BATTLE_INVALID_INDEX) return;
+
+    int type = _type[building];
+    // 评分相同时按编号决出，结果与桶内顺序无关，可以直接与末尾交换
+    BattlePointList& bucket = _cells[static_cast<size_t>(type) * _cols * _rows + cell];
+    bucket.swapRemove(static_cast<int>(std::find(bucket.ids.begin(), bucket.ids.end(), building) - bucket.ids.begin()));
+    _cellOf[building] = BATTLE_INVALID_INDEX;
+    _aliveCount[type]--;
+    _totalAlive--;
+}
+
+int BattleTargetIndex::getAliveCount(EnemyType type) const
+{
+    int t = static_cast<int>(type);
+    if (t < 0 || t >= BATTLE_ENEMY_TYPE_COUNT) return 0;
+    return _aliveCount[t];
+}
+
+int BattleTargetIndex::columnOf(float x) const
+{
+    int col = static_cast<int>(std::floor(x / _cellSize));
+    return std::min(std::max(col, 0), _cols - 1);
+}
+
+int BattleTargetIndex::rowOf(float y) const
+{
+    int row = static_cast<int>(std::floor(y / _cellSize));
+    return std::min(std::max(row, 0), _rows - 1);
+}
+
+int BattleTargetIndex::findBestTarget(SoldierType soldier, const BattleVec2& pos) const
+{
+    int s = static_cast<int>(soldier);
+    if (s < 0 || s >= BATTLE_SOLDIER_TYPE_COUNT) s = 0;
+
+    float bestScore = FLT_MAX;
+    int best = BATTLE_INVALID_INDEX;
+    for (int k = 0; k < BATTLE_ENEMY_TYPE_COUNT; ++k) {
+        int type = _typeOrder[s][k];
+        if (_aliveCount[type] == 0) continue;
+
+        // 类型按偏置升序：距离非负，偏置已超过最优分则后续类型都不可能更优
+        float bias = BattleRules::targetBias(soldier, static_cast<EnemyType>(type));
+        if (bias > bestScore) break;
+        searchType(type, pos, bias, bestScore, best);
+    }
+    return best;
+}
+
+int BattleTargetIndex::findNearest(EnemyType type, const BattleVec2& pos, float maxDistance) const
+{
+    int t = static_cast<int>(type);
+    if (t < 0 || t >= BATTLE_ENEMY_TYPE_COUNT || _aliveCount[t] == 0) return BATTLE_INVALID_INDEX;
+
+    float bestScore = maxDistance;
+    int best = BATTLE_INVALID_INDEX;
+    searchType(t, pos, 0.0f, bestScore, best);
+    return best;
+}
+
+void BattleTargetIndex::searchType(int type, const BattleVec2& pos, float bias, float& bestScore, int& best) const
+{
+    const int cellCount = _cols * _rows;
+    const BattlePointList* buckets = &_cells[static_cast<size_t>(type) * cellCount];
+    const int pc = columnOf(pos.x);
+    const int pr = rowOf(pos.y);
+    const int maxRing = std::max(std::max(pc, _cols - 1 - pc), std::max(pr, _rows - 1 - pr));
+
+    auto visit = [&](int col, int row) {
+        const BattlePointList& bucket = buckets[row * _cols + col];
+        if (bucket.empty()) return;
+        BattleSimd::nearestScored(pos.x, pos.y, bucket.x.data(), bucket.y.data(), bucket.ids.data(), bucket.size(),
+            bias, bestScore, best);
+    };
+
+    for (int ring = 0; ring <= maxRing; ++ring) {
+        // 第 ring 圈格子内任意点到查询点的距离至少为 (ring - 1) 个格子边长
+        float lowerBound = (ring > 0 ? (ring - 1) * _cellSize : 0.0f) + bias;
+        if (lowerBound > bestScore) break;
+
+        int minRow = std::max(pr - ring, 0);
+        int maxRow = std::min(pr + ring, _rows - 1);
+        for (int row = minRow; row <= maxRow; ++row) {
+            if (row == pr - ring || row == pr + ring) {
+                // 上下两条边：整行
+                int minCol = std::max(pc - ring, 0);
+                int maxCol = std::min(pc + ring, _cols - 1);
+                for (int col = minCol; col <= maxCol; ++col) visit(col, row);
+            }
+            else {
+                // 中间行：只有左右两端
+                if (pc - ring >= 0) visit(pc - ring, row);
+                if (ring > 0 && pc + ring < _cols) visit(pc + ring, row);
+            }
+        }
+    }
+}
+
+void BattleTargetIndex::collectNear(const BattleRect& rect, std::vector<int>& out) const
+{
+    out.clear();
+    const int cellCount = _cols * _rows;
+    const int minCol = columnOf(rect.minX() - _reachX);
+    const int maxCol = columnOf(rect.maxX() + _reachX);
+    const int minRow = rowOf(rect.minY() - _reachY);
+    const int maxRow = rowOf(rect.maxY() + _reachY);
+    for (int t = 0; t < BATTLE_ENEMY_TYPE_COUNT; ++t) {
+        if (_aliveCount[t] == 0) continue;
+        for (int row = minRow; row <= maxRow; ++row) {
+            for (int col = minCol; col <= maxCol; ++col) {
+                const BattlePointList& bucket = _cells[static_cast<size_t>(t) * cellCount + row * _cols + col];
+                out.insert(out.end(), bucket.ids.begin(), bucket.ids.end());
+            }
+        }
+    }
+}
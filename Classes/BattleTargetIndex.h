@@ -0,0 +1,102 @@
+/**
+ * @file       BattleTargetIndex.h
+ * @brief      士兵寻靶用的建筑索引
+ * @details    把存活的敌方建筑按 EnemyType 分桶，每个类型桶内再按均匀网格划分。
+ *             士兵寻靶的评分为“距离 + 类型偏置”，偏置只取决于（兵种, 建筑类型），
+ *             因此最优目标必然是某个类型桶内距离最近的建筑：按偏置从小到大遍历类型，
+ *             桶内由近到远逐圈搜索格子，一旦下界超过当前最优分即可剪枝，不再需要扫描全部建筑；
+ *             格子内的建筑坐标打包存放，由 BattleSimd::nearestScored 一次比较 4 座建筑
+ * @version    1.0
+ * @note       建筑不会移动，索引只在载入关卡时构建一次；建筑被摧毁时由 BattleWorld 的摧毁事件
+ *             调用 remove() 将其移出，不需要每帧轮询建筑状态
+ */
+#ifndef BATTLE_TARGET_INDEX_H_
+#define BATTLE_TARGET_INDEX_H_
+
+#include <vector>
+#include "BattleTypes.h"
+#include "BattleSimd.h"
+
+/**
+ * @class      BattleTargetIndex
+ * @brief      按建筑类型分桶的静态空间索引
+ * @details    查询结果与线性扫描完全一致：评分相同时返回建筑索引较小者
+ */
+class BattleTargetIndex
+{
+public:
+    BattleTargetIndex();
+
+    /**
+     * @brief      根据关卡建筑构建索引
+     * @param      buildings  关卡中的全部建筑（下标即建筑索引）
+     * @param      width      覆盖区域宽度（像素）
+     * @param      height     覆盖区域高度（像素）
+     * @param      cellSize   格子边长（像素）
+     */
+    void build(const std::vector<BattleBuildingDesc>& buildings, float width, float height, float cellSize);
+
+    /**
+     * @brief      将建筑移出索引（建筑被摧毁时调用，重复调用无效果）
+     * @param      building  建筑索引
+     */
+    void remove(int building);
+
+    /// 某类型存活建筑数量
+    int getAliveCount(EnemyType type) const;
+
+    /// 全部存活建筑数量
+    int getTotalAliveCount() const { return _totalAlive; }
+
+    /**
+     * @brief      为指定兵种在指定位置寻找评分最低（最优）的建筑
+     * @details    评分 = 距离 + BattleRules::targetBias(兵种, 建筑类型)
+     * @param      soldier  兵种
+     * @param      pos      士兵位置
+     * @return     int      建筑索引；没有存活建筑时返回 BATTLE_INVALID_INDEX
+     */
+    int findBestTarget(SoldierType soldier, const BattleVec2& pos) const;
+
+    /**
+     * @brief      寻找指定类型中距离最近且严格小于 maxDistance 的建筑
+     * @param      type         建筑类型
+     * @param      pos          查询位置
+     * @param      maxDistance  最大距离（不含）
+     * @return     int          建筑索引；不存在时返回 BATTLE_INVALID_INDEX
+     */
+    int findNearest(EnemyType type, const BattleVec2& pos, float maxDistance) const;
+
+    /**
+     * @brief      收集占地可能与矩形相交的存活建筑（范围效果的候选）
+     * @details    只遍历矩形按最大占地外扩后覆盖的格子，调用方再按占地矩形精确判定
+     * @param      rect  查询矩形
+     * @param      out   输出的建筑索引（先清空，顺序不定）
+     */
+    void collectNear(const BattleRect& rect, std::vector<int>& out) const;
+
+private:
+    int columnOf(float x) const;
+    int rowOf(float y) const;
+
+    /**
+     * @brief      在一个类型桶内按圈搜索，更新最优评分与结果
+     * @details    候选评分 = 距离 + bias；评分更低或评分相同但索引更小时替换当前结果
+     */
+    void searchType(int type, const BattleVec2& pos, float bias, float& bestScore, int& best) const;
+
+    float _cellSize;                                  ///< 格子边长
+    int _cols;                                        ///< 列数
+    int _rows;                                        ///< 行数
+    std::vector<BattlePointList> _cells;              ///< 桶：(类型 * 格子数 + 格子)
+    std::vector<uint8_t> _type;                       ///< 建筑类型
+    std::vector<int> _cellOf;                         ///< 建筑所在格子（-1 表示已移出）
+    int _aliveCount[BATTLE_ENEMY_TYPE_COUNT];         ///< 各类型存活数量
+    int _totalAlive;                                  ///< 存活总数
+    float _reachX;                                    ///< 建筑占地超出其中心的最大水平距离
+    float _reachY;                                    ///< 建筑占地超出其中心的最大垂直距离
+
+    /// 每个兵种按偏置从小到大排列的建筑类型，偏置大的类型更容易被剪枝
+    int _typeOrder[BATTLE_SOLDIER_TYPE_COUNT][BATTLE_ENEMY_TYPE_COUNT];
+};
+
+#endif // BATTLE_TARGET_INDEX_H_
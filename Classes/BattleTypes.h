@@ -0,0 +1,219 @@
+/**
+ * @file       BattleTypes.h
+ * @brief      战斗核心（无引擎依赖）的基础数据类型定义
+ * @details    该文件声明了战斗模拟核心使用的纯数据类型：二维向量、矩形、单位状态、兵种属性、
+ *             关卡描述（建筑/陷阱/禁放区域）以及模拟事件。所有类型均为 POD 或近似 POD，
+ *             不依赖 Cocos2d-x 的 GL / Director / Node，可在无窗口的 Linux 环境下直接编译运行
+ * @version    1.0
+ * @note       坐标统一使用 TMX 地图节点坐标系（原点在地图左下角，单位为像素），
+ *             与 Soldier / EnemyBuilding 精灵挂在 _tileMap 下时的 getPosition() 一致
+ */
+#ifndef BATTLE_TYPES_H_
+#define BATTLE_TYPES_H_
+
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "SharedData.h"
+
+/// 兵种数量（与 SoldierType 枚举一一对应）
+const int BATTLE_SOLDIER_TYPE_COUNT = 5;
+
+/// 敌方建筑类型数量（不含 UNKNOWN）
+const int BATTLE_ENEMY_TYPE_COUNT = static_cast<int>(EnemyType::UNKNOWN);
+
+/// 无效实体索引（无目标、未绑定等情况）
+const int BATTLE_INVALID_INDEX = -1;
+
+/**
+ * @struct     BattleVec2
+ * @brief      战斗核心使用的二维向量
+ * @details    功能上等价于 cocos2d::Vec2 的子集，仅包含模拟所需的运算，避免核心依赖引擎数学库
+ */
+struct BattleVec2 {
+    float x;
+    float y;
+
+    BattleVec2() : x(0.0f), y(0.0f) {}
+    BattleVec2(float px, float py) : x(px), y(py) {}
+
+    BattleVec2 operator+(const BattleVec2& o) const { return BattleVec2(x + o.x, y + o.y); }
+    BattleVec2 operator-(const BattleVec2& o) const { return BattleVec2(x - o.x, y - o.y); }
+    BattleVec2 operator*(float s) const { return BattleVec2(x * s, y * s); }
+
+    float lengthSq() const { return x * x + y * y; }
+    float length() const { return std::sqrt(lengthSq()); }
+    float distance(const BattleVec2& o) const { return (*this - o).length(); }
+    float distanceSq(const BattleVec2& o) const { return (*this - o).lengthSq(); }
+
+    /// 归一化（零向量保持为零，与 Vec2::getNormalized 行为一致）
+    BattleVec2 normalized() const {
+        float len = length();
+        if (len == 0.0f) return BattleVec2();
+        return BattleVec2(x / len, y / len);
+    }
+};
+
+/**
+ * @struct     BattleRect
+ * @brief      战斗核心使用的轴对齐矩形（左下角原点 + 宽高）
+ * @details    包含判定与相交判定均为闭区间，与 cocos2d::Rect 的 containsPoint / intersectsRect 语义保持一致
+ */
+struct BattleRect {
+    float x;
+    float y;
+    float w;
+    float h;
+
+    BattleRect() : x(0.0f), y(0.0f), w(0.0f), h(0.0f) {}
+    BattleRect(float px, float py, float pw, float ph) : x(px), y(py), w(pw), h(ph) {}
+
+    float minX() const { return x; }
+    float minY() const { return y; }
+    float maxX() const { return x + w; }
+    float maxY() const { return y + h; }
+    BattleVec2 center() const { return BattleVec2(x + w * 0.5f, y + h * 0.5f); }
+
+    bool containsPoint(float px, float py) const {
+        return px >= minX() && px <= maxX() && py >= minY() && py <= maxY();
+    }
+    bool intersects(const BattleRect& o) const {
+        return !(maxX() < o.minX() || o.maxX() < minX() || maxY() < o.minY() || o.maxY() < minY());
+    }
+};
+
+/**
+ * @enum       BattleUnitState
+ * @brief      单位状态（对应原 Soldier::State）
+ */
+enum class BattleUnitState : uint8_t {
+    IDLE = 0,      ///< 闲置：无目标
+    MOVING,        ///< 移动：有目标但未进入攻击范围
+    ATTACKING      ///< 攻击：已进入攻击范围
+};
+
+/**
+ * @enum       BattleTeam
+ * @brief      单位所属阵营
+ */
+enum class BattleTeam : uint8_t {
+    ATTACKER = 0,  ///< 进攻方：玩家投放的士兵
+    DEFENDER       ///< 防守方：兵营释放的守军
+};
+
+/**
+ * @enum       BattleAttackKind
+ * @brief      单位的攻击方式
+ */
+enum class BattleAttackKind : uint8_t {
+    MELEE = 0,     ///< 近战：攻击间隔到达时直接结算伤害
+    ARROW,         ///< 远程：发射箭支，飞行到达后结算伤害
+    SUICIDE        ///< 自爆：对目标造成伤害后自身死亡
+};
+
+/**
+ * @enum       BattleProjectileKind
+ * @brief      弹道类型
+ */
+enum class BattleProjectileKind : uint8_t {
+    ARROW = 0,     ///< 弓箭士兵射出的箭（命中建筑）
+    CANNONBALL     ///< 防御建筑发射的炮弹（命中士兵）
+};
+
+/**
+ * @enum       BattleOutcome
+ * @brief      战斗结果
+ */
+enum class BattleOutcome : uint8_t {
+    RUNNING = 0,   ///< 战斗进行中
+    VICTORY,       ///< 胜利：大本营与所有非围墙建筑被摧毁
+    DEFEAT         ///< 失败：战场无存活士兵且无剩余可投放士兵
+};
+
+/**
+ * @struct     BattleUnitStats
+ * @brief      兵种固有属性（原各 Soldier 子类 setupProperties 中的常量）
+ */
+struct BattleUnitStats {
+    int maxHp;                    ///< 最大生命值
+    int attackDamage;             ///< 单次攻击伤害
+    float attackRange;            ///< 攻击范围（像素）
+    float attackInterval;         ///< 攻击间隔（秒）
+    float moveSpeed;              ///< 移动速度（像素/秒）
+    float halfSize;               ///< 碰撞盒半边长（16x16 纹理放大 3 倍后为 24）
+    bool flying;                  ///< 是否为飞行单位
+    BattleAttackKind attackKind;  ///< 攻击方式
+};
+
+/**
+ * @struct     BattleBuildingDesc
+ * @brief      关卡中单个敌方建筑的纯数据描述
+ * @details    由 BattleScene 在解析 TMX / PVP JSON 时生成，footprint 为精灵在地图节点坐标系下的包围盒，
+ *             用于陆军阻挡判定与“接触即攻击”判定
+ */
+struct BattleBuildingDesc {
+    EnemyType type;               ///< 建筑类型
+    BattleVec2 position;          ///< 建筑中心（精灵锚点）位置
+    BattleRect footprint;         ///< 占地矩形
+    int hp;                       ///< 生命值
+    int attack;                   ///< 攻击力（0 表示非攻击建筑）
+    float range;                  ///< 攻击范围（地图节点坐标系下的像素）
+    int garrison = 0;             ///< 兵营驻守的守军数量（其他建筑为 0）
+};
+
+/**
+ * @struct     BattleTrapDesc
+ * @brief      关卡中单个地雷陷阱的纯数据描述
+ */
+struct BattleTrapDesc {
+    BattleRect area;              ///< 触发与伤害区域
+    int damage;                   ///< 爆炸伤害
+};
+
+/**
+ * @struct     BattleLevelDesc
+ * @brief      一场战斗的初始布局（与渲染无关）
+ */
+struct BattleLevelDesc {
+    float mapWidth = 0.0f;                     ///< 地图宽度（像素）
+    float mapHeight = 0.0f;                    ///< 地图高度（像素）
+    float tileWidth = 32.0f;                   ///< 瓦片宽度（像素）
+    float tileHeight = 32.0f;                  ///< 瓦片高度（像素）
+    std::vector<BattleBuildingDesc> buildings; ///< 所有敌方建筑（含大本营）
+    std::vector<BattleTrapDesc> traps;         ///< 所有地雷陷阱
+    std::vector<BattleRect> forbiddenRects;    ///< 禁止投放士兵的区域
+    float cannonSplashRadius = 0.0f;           ///< 加农炮炮弹落点的溅射半径（像素，0 表示没有溅射）
+};
+
+/**
+ * @enum       BattleEventType
+ * @brief      模拟事件类型，供表现层（BattleScene）在每帧消费并驱动动画与特效
+ */
+enum class BattleEventType : uint8_t {
+    UNIT_DEPLOYED = 0,    ///< 单位投放：a=单位索引（守军出营时 b=兵营索引）
+    UNIT_ATTACKED,        ///< 单位发起攻击：a=单位索引，b=目标建筑索引（攻击敌方单位时为 BATTLE_INVALID_INDEX）
+    UNIT_DIED,            ///< 单位死亡：a=单位索引（步末伤害结算时产生；自爆单位例外，引爆时在单位 AI 阶段紧跟 UNIT_EXPLODED 产生）
+    UNIT_EXPLODED,        ///< 自爆单位引爆：a=单位索引，pos=爆炸位置
+    BUILDING_DAMAGED,     ///< 建筑受击：a=建筑索引（同一步内多次命中合并为一条）
+    BUILDING_DESTROYED,   ///< 建筑被摧毁：a=建筑索引（每座建筑只产生一次）
+    PROJECTILE_FIRED,     ///< 弹道发射：a=发射者索引，b=目标索引，pos/target=起止点，duration=飞行时间
+    TRAP_EXPLODED,        ///< 陷阱爆炸：a=陷阱索引，pos=陷阱中心
+    SPLASH_EXPLODED       ///< 炮弹溅射：a=发射的建筑索引，pos=落点
+};
+
+/**
+ * @struct     BattleEvent
+ * @brief      单条模拟事件（POD，按发生顺序追加到事件队列）
+ */
+struct BattleEvent {
+    BattleEventType type;
+    BattleProjectileKind projectile;  ///< 仅 PROJECTILE_FIRED 有效
+    int a;                            ///< 主体索引（单位/建筑/陷阱）
+    int b;                            ///< 关联索引（目标），无关联时为 BATTLE_INVALID_INDEX
+    BattleVec2 pos;                   ///< 事件发生位置
+    BattleVec2 target;                ///< 目标位置（弹道终点）
+    float duration;                   ///< 持续时间（弹道飞行时间）
+};
+
+#endif // BATTLE_TYPES_H_
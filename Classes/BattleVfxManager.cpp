@@ -0,0 +1,106 @@
+/**
+ * @file       BattleVfxManager.cpp
+ * @brief      战斗特效管理器的实现
+ * @version    1.0
+ */
+#include "BattleVfxManager.h"
+
+USING_NS_CC;
+
+const char* const BattleVfxManager::EXPLOSION_ANIMATION = "battle_explosion";
+
+namespace {
+
+/// 爆炸帧数与每帧时长（与原各处 playExplosionEffect 一致）
+const int EXPLOSION_FRAME_COUNT = 9;
+const float EXPLOSION_FRAME_DELAY = 0.1f;
+
+} // namespace
+
+Animation* BattleVfxManager::preloadExplosion()
+{
+    AnimationCache* animationCache = AnimationCache::getInstance();
+    Animation* animation = animationCache->getAnimation(EXPLOSION_ANIMATION);
+    if (animation) return animation;
+
+    // 帧直接由纹理生成并登记到 SpriteFrameCache，不再为取帧创建临时精灵
+    SpriteFrameCache* frameCache = SpriteFrameCache::getInstance();
+    TextureCache* textureCache = Director::getInstance()->getTextureCache();
+    Vector<SpriteFrame*> frames;
+    for (int i = 1; i <= EXPLOSION_FRAME_COUNT; ++i) {
+        std::string name = StringUtils::format("soldiers/Explosion%d.png", i);
+        SpriteFrame* frame = frameCache->getSpriteFrameByName(name);
+        if (!frame) {
+            Texture2D* texture = textureCache->addImage(name);
+            if (!texture) continue;
+            frame = SpriteFrame::createWithTexture(texture, Rect(Vec2::ZERO, texture->getContentSize()));
+            frameCache->addSpriteFrame(frame, name);
+        }
+        frames.pushBack(frame);
+    }
+    if (frames.empty()) return nullptr;
+
+    animation = Animation::createWithSpriteFrames(frames, EXPLOSION_FRAME_DELAY);
+    animationCache->addAnimation(animation, EXPLOSION_ANIMATION);
+    return animation;
+}
+
+bool BattleVfxManager::init()
+{
+    if (!Node::init()) return false;
+    _explosion = preloadExplosion();
+    return true;
+}
+
+Sprite* BattleVfxManager::acquireSprite()
+{
+    if (!_freeSprites.empty()) {
+        Sprite* sprite = _freeSprites.back();
+        _freeSprites.pop_back();
+        sprite->setVisible(true);
+        return sprite;
+    }
+
+    Sprite* sprite = Sprite::create();
+    this->addChild(sprite);
+    _spriteCount++;
+    return sprite;
+}
+
+void BattleVfxManager::recycle(Sprite* sprite)
+{
+    sprite->setVisible(false);
+    _freeSprites.push_back(sprite);
+    _liveCount--;
+}
+
+bool BattleVfxManager::playExplosion(const Vec2& pos, float scale, const std::function<void()>& onFinished)
+{
+    if (!_explosion || _liveCount >= MAX_LIVE_EFFECTS) {
+        // 负载过高时丢弃特效本身，但依赖特效结束的表现（如弹坑）照常出现
+        _droppedCount++;
+        if (onFinished) onFinished();
+        return false;
+    }
+    if (_hasViewRect && !_viewRect.containsPoint(pos)) {
+        _culledCount++;
+        if (onFinished) onFinished();
+        return false;
+    }
+
+    Sprite* sprite = acquireSprite();
+    sprite->setPosition(pos);
+    sprite->setScale(scale);
+    _liveCount++;
+
+    // 播放完毕后回收精灵，管理器持有全部精灵，回调捕获的指针在管理器存活期间始终有效
+    sprite->runAction(Sequence::create(
+        Animate::create(_explosion),
+        CallFunc::create([this, sprite, onFinished]() {
+            if (onFinished) onFinished();
+            this->recycle(sprite);
+        }),
+        nullptr
+    ));
+    return true;
+}
@@ -0,0 +1,88 @@
+/**
+ * @file       BattleVfxManager.h
+ * @brief      战斗特效管理器（爆炸动画缓存 + 精灵池 + 并发上限）
+ * @details    爆炸帧动画（soldiers/Explosion1~9.png）只在第一次使用时注册到 SpriteFrameCache 与
+ *             AnimationCache，之后所有建筑摧毁、自爆兵、地雷的爆炸都共享同一个 Animation；
+ *             爆炸精灵播放完毕后隐藏并回收到池中复用，不再每次爆炸临时创建 9 个精灵取帧。
+ *             同时播放的特效数量设有上限，超出时直接丢弃新的特效（仍会执行结束回调），
+ *             避免大量自爆兵同时爆炸造成卡顿；位于视野外的特效同样直接跳过
+ * @version    1.0
+ * @note       管理器作为地图的子节点，特效坐标为地图节点坐标；池中精灵由管理器持有，随场景一起释放
+ */
+#ifndef BATTLE_VFX_MANAGER_H_
+#define BATTLE_VFX_MANAGER_H_
+
+#include <functional>
+#include <vector>
+#include "cocos2d.h"
+
+/**
+ * @class      BattleVfxManager
+ * @brief      共享动画、复用精灵的战斗特效层
+ */
+class BattleVfxManager : public cocos2d::Node
+{
+public:
+    CREATE_FUNC(BattleVfxManager);
+
+    /// 同时播放的特效数量上限
+    static const int MAX_LIVE_EFFECTS = 48;
+
+    /// 爆炸动画在 AnimationCache 中的名称
+    static const char* const EXPLOSION_ANIMATION;
+
+    /**
+     * @brief      初始化：确保爆炸动画已注册
+     * @return     bool  初始化成功返回 true
+     */
+    virtual bool init() override;
+
+    /**
+     * @brief      注册爆炸动画（已注册时直接返回），可在进入战斗前提前调用
+     * @return     cocos2d::Animation*  缓存中的爆炸动画；帧资源全部缺失时返回 nullptr
+     */
+    static cocos2d::Animation* preloadExplosion();
+
+    /**
+     * @brief      在指定位置播放一次爆炸
+     * @param      pos         地图节点坐标
+     * @param      scale       特效缩放
+     * @param      onFinished  播放结束（或因超出上限被丢弃）时的回调，可为空
+     * @return     bool        实际播放返回 true；超出上限或动画缺失时返回 false
+     */
+    bool playExplosion(const cocos2d::Vec2& pos, float scale,
+        const std::function<void()>& onFinished = nullptr);
+
+    /**
+     * @brief      设置当前视野，视野外的爆炸不再播放（仍会执行结束回调）
+     * @param      viewRect  视野矩形（地图节点坐标，已包含特效尺寸的边距）
+     */
+    void setViewRect(const cocos2d::Rect& viewRect) { _viewRect = viewRect; _hasViewRect = true; }
+
+    /// 正在播放的特效数量（性能分析用）
+    int getLiveCount() const { return _liveCount; }
+
+    /// 因超出上限被丢弃的特效累计数量（性能分析用）
+    int getDroppedCount() const { return _droppedCount; }
+
+    /// 因位于视野外被跳过的特效累计数量（性能分析用）
+    int getCulledCount() const { return _culledCount; }
+
+    /// 池中精灵总数（含播放中与空闲）
+    int getPooledCount() const { return _spriteCount; }
+
+private:
+    cocos2d::Sprite* acquireSprite();
+    void recycle(cocos2d::Sprite* sprite);
+
+    cocos2d::Animation* _explosion = nullptr;          ///< 缓存中的爆炸动画（由 AnimationCache 持有）
+    std::vector<cocos2d::Sprite*> _freeSprites;        ///< 空闲的特效精灵
+    int _liveCount = 0;                                ///< 播放中的特效数量
+    int _droppedCount = 0;                             ///< 被丢弃的特效数量
+    int _culledCount = 0;                              ///< 视野外被跳过的特效数量
+    cocos2d::Rect _viewRect;                           ///< 当前视野（地图节点坐标）
+    bool _hasViewRect = false;                         ///< 是否已设置视野（未设置时不剔除）
+    int _spriteCount = 0;                              ///< 已创建的精灵数量
+};
+
+#endif // BATTLE_VFX_MANAGER_H_
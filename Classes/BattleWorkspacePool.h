@@ -0,0 +1,101 @@
+/**
+ * @file       BattleWorkspacePool.h
+ * @brief      并行任务借用的工作区池
+ * @details    BattleJobSystem 的外部线程共用一个队列，等待期间还会窃取其他任务组的任务，
+ *             所以按线程槽位索引工作区并不安全：两个外部线程（如布局优化与战斗预测的驱动线程）
+ *             可能同时执行用到同一槽位的任务。这里改为每块任务开始时从互斥锁保护的空闲列表借出一个工作区、
+ *             结束时归还；空闲列表为空时新建，因此工作区数量等于实际的最大并发数，预热后不再申请内存
+ * @version    1.0
+ * @note       该文件无引擎依赖；工作区的内容不得影响计算结果（借到哪一个工作区取决于调度）
+ */
+#ifndef BATTLE_WORKSPACE_POOL_H_
+#define BATTLE_WORKSPACE_POOL_H_
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/**
+ * @class      BattleWorkspacePool
+ * @brief      互斥锁保护的工作区空闲列表
+ * @details    使用流程：开始一轮计算前 prepare(init) 初始化已有工作区（新建的工作区也会先调用 init）
+ *             -> 每块任务内构造 Lease 借出工作区，离开作用域时自动归还
+ */
+template <typename T>
+class BattleWorkspacePool
+{
+public:
+    typedef std::function<void(T&)> Init;
+
+    /**
+     * @class      Lease
+     * @brief      借出的工作区（离开作用域时归还）
+     */
+    class Lease
+    {
+    public:
+        explicit Lease(BattleWorkspacePool& pool) : _pool(pool), _workspace(pool.acquire()) {}
+        ~Lease() { _pool.release(std::move(_workspace)); }
+
+        T& operator*() const { return *_workspace; }
+        T* operator->() const { return _workspace.get(); }
+
+    private:
+        Lease(const Lease&);
+        Lease& operator=(const Lease&);
+
+        BattleWorkspacePool& _pool;
+        std::unique_ptr<T> _workspace;
+    };
+
+    BattleWorkspacePool() {}
+
+    /**
+     * @brief      设置工作区的初始化函数并应用到所有空闲工作区
+     * @details    只能在没有借出的工作区时调用（一轮并行计算开始之前）
+     */
+    void prepare(const Init& init)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _init = init;
+        if (_init) {
+            for (auto& workspace : _free) _init(*workspace);
+        }
+    }
+
+private:
+    BattleWorkspacePool(const BattleWorkspacePool&);
+    BattleWorkspacePool& operator=(const BattleWorkspacePool&);
+
+    std::unique_ptr<T> acquire()
+    {
+        Init init;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (!_free.empty()) {
+                std::unique_ptr<T> workspace = std::move(_free.back());
+                _free.pop_back();
+                return workspace;
+            }
+            init = _init;
+        }
+
+        // 新建与初始化在锁外进行，不阻塞其他线程归还或借出
+        std::unique_ptr<T> workspace(new T());
+        if (init) init(*workspace);
+        return workspace;
+    }
+
+    void release(std::unique_ptr<T> workspace)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _free.push_back(std::move(workspace));
+    }
+
+    std::mutex _mutex;                          ///< 保护空闲列表与初始化函数
+    std::vector<std::unique_ptr<T>> _free;      ///< 空闲工作区
+    Init _init;                                 ///< 工作区初始化函数
+};
+
+#endif // BATTLE_WORKSPACE_POOL_H_
@@ -0,0 +1,1260 @@
+/**
+ * @file       BattleWorld.cpp
+ * @brief      战斗模拟核心的实现
+ * @details    规则实现与原 Soldier::update / findNewTarget / moveLogic / attackLogic、
+ *             EnemyBuilding::updateTowerLogic / takeDamage、MapTrap::checkTrigger / explode
+ *             以及 BattleScene::checkGameEnd 一一对应，只是把对精灵的读写换成了对 SoA 数组的读写
+ * @version    1.0
+ */
+#include "BattleWorld.h"
+#include "BattleRules.h"
+#include "BattleJobSystem.h"
+#include "BattleSimd.h"
+#include <chrono>
+#include <climits>
+#include <cmath>
+#include <cstring>
+
+// =========================================================
+// 1. 结构化数组存储
+// =========================================================
+
+void BattleUnitStore::clear()
+{
+    type.clear(); x.clear(); y.clear(); prevX.clear(); prevY.clear(); hp.clear(); maxHp.clear();
+    attackDamage.clear(); attackRange.clear(); attackInterval.clear(); attackTimer.clear();
+    moveSpeed.clear(); halfSize.clear(); flying.clear(); state.clear();
+    facingLeft.clear(); alive.clear(); target.clear(); team.clear(); foe.clear(); home.clear();
+}
+
+void BattleUnitStore::reserve(size_t n)
+{
+    type.reserve(n); x.reserve(n); y.reserve(n); prevX.reserve(n); prevY.reserve(n); hp.reserve(n); maxHp.reserve(n);
+    attackDamage.reserve(n); attackRange.reserve(n); attackInterval.reserve(n); attackTimer.reserve(n);
+    moveSpeed.reserve(n); halfSize.reserve(n); flying.reserve(n); state.reserve(n);
+    facingLeft.reserve(n); alive.reserve(n); target.reserve(n); team.reserve(n); foe.reserve(n); home.reserve(n);
+}
+
+int BattleUnitStore::push(SoldierType t, const BattleVec2& pos, BattleTeam side, int homeBuilding)
+{
+    const BattleUnitStats& stats = BattleRules::unitStats(t);
+    type.push_back(static_cast<uint8_t>(t));
+    x.push_back(pos.x);
+    y.push_back(pos.y);
+    prevX.push_back(pos.x);
+    prevY.push_back(pos.y);
+    hp.push_back(stats.maxHp);
+    maxHp.push_back(stats.maxHp);
+    attackDamage.push_back(stats.attackDamage);
+    attackRange.push_back(stats.attackRange);
+    attackInterval.push_back(stats.attackInterval);
+    attackTimer.push_back(0.0f);
+    moveSpeed.push_back(stats.moveSpeed);
+    halfSize.push_back(stats.halfSize);
+    flying.push_back(stats.flying ? 1 : 0);
+    state.push_back(static_cast<uint8_t>(BattleUnitState::IDLE));
+    facingLeft.push_back(0);
+    alive.push_back(1);
+    target.push_back(BATTLE_INVALID_INDEX);
+    team.push_back(static_cast<uint8_t>(side));
+    foe.push_back(BATTLE_INVALID_INDEX);
+    home.push_back(homeBuilding);
+    return static_cast<int>(type.size()) - 1;
+}
+
+void BattleBuildingStore::clear()
+{
+    type.clear(); x.clear(); y.clear(); footprint.clear(); hp.clear(); maxHp.clear();
+    attack.clear(); range.clear(); attackTimer.clear(); destroyed.clear(); garrison.clear(); alerted.clear();
+}
+
+int BattleBuildingStore::push(const BattleBuildingDesc& desc)
+{
+    type.push_back(static_cast<uint8_t>(desc.type));
+    x.push_back(desc.position.x);
+    y.push_back(desc.position.y);
+    footprint.push_back(desc.footprint);
+    hp.push_back(desc.hp);
+    maxHp.push_back(desc.hp);
+    attack.push_back(desc.attack);
+    range.push_back(desc.range);
+    attackTimer.push_back(0.0f);
+    destroyed.push_back(desc.hp <= 0 ? 1 : 0);
+    garrison.push_back(desc.type == EnemyType::BARRACKS ? desc.garrison : 0);
+    alerted.push_back(0);
+    return static_cast<int>(type.size()) - 1;
+}
+
+// =========================================================
+// 2. 初始化与兵力
+// =========================================================
+
+BattleWorld::BattleWorld()
+    : _totalReserve(0)
+    , _baseIndex(BATTLE_INVALID_INDEX)
+    , _outcome(BattleOutcome::RUNNING)
+    , _elapsed(0.0f)
+    , _steps(0)
+    , _aliveDefenders(0)
+    , _eventsEnabled(true)
+    , _profiling(false)
+    , _jobs(nullptr)
+{
+    for (int i = 0; i < BATTLE_SOLDIER_TYPE_COUNT; ++i) _reserve[i] = 0;
+}
+
+void BattleWorld::loadLevel(const BattleLevelDesc& level)
+{
+    _level = level;
+    _units.clear();
+    _buildings.clear();
+    _projectiles.reset(BattleRules::PROJECTILE_POOL_CAPACITY);
+    _events.clear();
+    _outcome = BattleOutcome::RUNNING;
+    _elapsed = 0.0f;
+    _steps = 0;
+    _aliveDefenders = 0;
+    _baseIndex = BATTLE_INVALID_INDEX;
+    _tally.reset();
+    _damage.reset(static_cast<int>(level.buildings.size()));
+    _ai.reset();
+    _separation.reset(level.mapWidth, level.mapHeight);
+
+    for (const auto& desc : level.buildings) {
+        int index = _buildings.push(desc);
+        _tally.addBuilding(desc.type, _buildings.destroyed[index] != 0);
+        if (desc.type == EnemyType::BASE && _baseIndex == BATTLE_INVALID_INDEX) {
+            _baseIndex = index;
+        }
+    }
+
+    _traps = level.traps;
+    _trapExploded.assign(_traps.size(), 0);
+
+    // 网格覆盖整张地图；地图尺寸缺失时退化为单个格子，查询结果不变
+    _unitGrid.reset(level.mapWidth, level.mapHeight, BattleRules::UNIT_GRID_CELL_SIZE);
+    _defenderGrid.reset(level.mapWidth, level.mapHeight, BattleRules::UNIT_GRID_CELL_SIZE);
+    _targetIndex.build(level.buildings, level.mapWidth, level.mapHeight, BattleRules::TARGET_INDEX_CELL_SIZE);
+    _flowFields.build(level);
+    _occupancy.build(level);
+    _deployMask.build(level, BattleRules::DEPLOY_HALF_EXTENT);
+}
+
+void BattleWorld::setReserve(SoldierType type, int count)
+{
+    int index = static_cast<int>(type);
+    if (index < 0 || index >= BATTLE_SOLDIER_TYPE_COUNT) return;
+    _totalReserve -= _reserve[index];
+    _reserve[index] = count > 0 ? count : 0;
+    _totalReserve += _reserve[index];
+    // 预留存储，避免投放过程中反复扩容
+    _units.reserve(static_cast<size_t>(_totalReserve) + _units.size());
+}
+
+int BattleWorld::getReserve(SoldierType type) const
+{
+    int index = static_cast<int>(type);
+    if (index < 0 || index >= BATTLE_SOLDIER_TYPE_COUNT) return 0;
+    return _reserve[index];
+}
+
+int BattleWorld::getTotalReserve() const
+{
+    return _totalReserve;
+}
+
+// =========================================================
+// 3. 玩家操作：投放
+// =========================================================
+
+bool BattleWorld::canDeployAt(const BattleVec2& pos) const
+{
+    return _deployMask.canDeployAt(pos);
+}
+
+int BattleWorld::deployUnit(SoldierType type, const BattleVec2& pos)
+{
+    if (_outcome != BattleOutcome::RUNNING) return BATTLE_INVALID_INDEX;
+    int index = static_cast<int>(type);
+    if (index < 0 || index >= BATTLE_SOLDIER_TYPE_COUNT || _reserve[index] <= 0) return BATTLE_INVALID_INDEX;
+    if (!canDeployAt(pos)) return BATTLE_INVALID_INDEX;
+
+    _reserve[index]--;
+    _totalReserve--;
+    int unit = _units.push(type, pos);
+    _tally.onUnitDeployed(type);
+    _unitGrid.insert(unit, pos, _units.flying[unit] ? BattleSpatialGrid::AIR : BattleSpatialGrid::GROUND);
+    emit(BattleEventType::UNIT_DEPLOYED, unit, BATTLE_INVALID_INDEX, pos);
+    return unit;
+}
+
+// =========================================================
+// 4. 模拟推进
+// =========================================================
+
+namespace {
+
+typedef std::chrono::steady_clock ProfileClock;
+
+/// 计时开启时把自 mark 以来的耗时（微秒）累加到 slot，并把 mark 移到当前时刻
+void lap(bool enabled, ProfileClock::time_point& mark, double& slot)
+{
+    if (!enabled) return;
+    const ProfileClock::time_point now = ProfileClock::now();
+    slot += std::chrono::duration<double, std::micro>(now - mark).count();
+    mark = now;
+}
+
+} // namespace
+
+void BattleWorld::step(float dt)
+{
+    if (_outcome != BattleOutcome::RUNNING) return;
+    _elapsed += dt;
+
+    _timings = BattleStepTimings();
+    ProfileClock::time_point mark;
+    if (_profiling) mark = ProfileClock::now();
+    const ProfileClock::time_point start = mark;
+
+    // 规划本步的单位 AI：滑行需要上一步的位移，须在记录本步开始前的位置之前完成。
+    // 本步内单位只会阵亡、建筑要到步末才被摧毁，规划在 updateUnits 时仍然有效
+    _ai.plan(_units, _buildings, _occupancy, _aliveDefenders > 0, _steps, dt);
+    _steps++;
+
+    // 记录本步开始前的位置，表现层在两步之间插值
+    _units.prevX = _units.x;
+    _units.prevY = _units.y;
+    lap(_profiling, mark, _timings.ai);
+
+    // 弹道先于本帧新发射的弹道结算，保证每个弹道至少飞行一帧
+    updateProjectiles(dt);
+    lap(_profiling, mark, _timings.projectiles);
+    updateTraps();
+    lap(_profiling, mark, _timings.traps);
+
+    updateUnits(dt);
+    updateDefenders(dt);
+    lap(_profiling, mark, _timings.ai);
+    separateUnits(dt);
+    lap(_profiling, mark, _timings.separation);
+    updateTowers(dt);
+    updateBarracks(dt);
+    lap(_profiling, mark, _timings.towers);
+    resolveDamage();
+    updateOutcome();
+    lap(_profiling, mark, _timings.damage);
+
+    if (_profiling) _timings.total = std::chrono::duration<double, std::micro>(mark - start).count();
+}
+
+namespace {
+
+/// FNV-1a 累加器（状态哈希用）
+struct StateHasher {
+    uint32_t value = 2166136261u;
+
+    void bytes(const void* data, size_t size) {
+        const uint8_t* p = static_cast<const uint8_t*>(data);
+        for (size_t i = 0; i < size; ++i) {
+            value ^= p[i];
+            value *= 16777619u;
+        }
+    }
+    template <typename T>
+    void pod(const T& v) { bytes(&v, sizeof(v)); }
+    template <typename T>
+    void array(const std::vector<T>& v) {
+        pod(static_cast<uint32_t>(v.size()));
+        if (!v.empty()) bytes(v.data(), v.size() * sizeof(T));
+    }
+};
+
+} // namespace
+
+uint32_t BattleWorld::computeStateHash() const
+{
+    StateHasher h;
+    h.array(_units.x);
+    h.array(_units.y);
+    h.array(_units.hp);
+    h.array(_units.attackTimer);
+    h.array(_units.state);
+    h.array(_units.alive);
+    h.array(_units.target);
+    h.array(_units.team);
+    h.array(_units.foe);
+    h.array(_buildings.hp);
+    h.array(_buildings.attackTimer);
+    h.array(_buildings.destroyed);
+    h.array(_buildings.garrison);
+    h.array(_trapExploded);
+    for (int slot : _projectiles.activeSlots()) {
+        const BattleProjectile& p = _projectiles.at(slot);
+        h.pod(p.target);
+        h.pod(p.damage);
+        h.pod(p.timeLeft);
+    }
+    for (int i = 0; i < BATTLE_SOLDIER_TYPE_COUNT; ++i) h.pod(_reserve[i]);
+    h.pod(static_cast<uint8_t>(_outcome));
+    return h.value;
+}
+
+bool BattleWorld::isPositionBlocked(const BattleVec2& pos) const
+{
+    return _occupancy.isBlocked(pos);
+}
+
+// =========================================================
+// 5. 单位 AI：状态机、寻靶、移动、攻击
+// =========================================================
+
+void BattleWorld::updateUnits(float dt)
+{
+    const int unitCount = static_cast<int>(_units.size());
+    const bool parallel = _jobs && _tally.getAliveUnitCount() >= BattleRules::PARALLEL_MIN_UNITS;
+
+    // 思考阶段：需要完整思考的单位只读地完成寻靶、流场查询与阻挡判定，互不依赖，交给任务系统并行
+    if (parallel) {
+        _decisions.resize(unitCount);
+        _jobs->parallelFor(unitCount, BattleRules::PARALLEL_GRAIN, [this, dt](int begin, int end) {
+            for (int i = begin; i < end; ++i) {
+                if (_units.alive[i] && !_units.team[i] && _ai.getPlan(i) == BattleAiScheduler::THINK) {
+                    thinkUnit(i, dt, _decisions[i]);
+                }
+            }
+        });
+    }
+
+    // 应用阶段：按索引顺序写回（攻击与事件的先后与单线程一致）；
+    // 伤害要到步末才结算，应用期间建筑不会被摧毁，思考阶段的决策始终有效
+    BattleUnitDecision planned;
+    for (int i = 0; i < unitCount; ++i) {
+        if (!_units.alive[i] || _units.team[i]) continue;
+        if (plannedDecision(i, planned)) {
+            applyDecision(i, planned, dt);
+        }
+        else if (parallel && _decisions[i].action != BattleUnitDecision::RECOMPUTE) {
+            applyDecision(i, _decisions[i], dt);
+        }
+        else {
+            updateUnit(i, dt);
+        }
+    }
+}
+
+bool BattleWorld::plannedDecision(int i, BattleUnitDecision& out) const
+{
+    out.target = _units.target[i];
+    out.foe = BATTLE_INVALID_INDEX;
+    switch (_ai.getPlan(i)) {
+        case BattleAiScheduler::KEEP_ATTACKING:
+            out.action = BattleUnitDecision::ATTACK;
+            return true;
+        case BattleAiScheduler::COAST:
+            out.action = BattleUnitDecision::STEP;
+            out.x = _ai.getCoastX(i);
+            out.y = _ai.getCoastY(i);
+            out.facingLeft = _units.facingLeft[i];
+            return true;
+        case BattleAiScheduler::WAIT_TARGET:
+            out.target = BATTLE_INVALID_INDEX;
+            out.action = BattleUnitDecision::IDLE;
+            return true;
+        case BattleAiScheduler::THINK:
+        default:
+            return false;
+    }
+}
+
+void BattleWorld::updateUnit(int i, float dt)
+{
+    BattleUnitDecision decision;
+    thinkUnit(i, dt, decision);
+    if (decision.action == BattleUnitDecision::RECOMPUTE) {
+        // 目标的流场尚未构建：构建后重新决策
+        _flowFields.nextStep(decision.target, BattleVec2(_units.x[i], _units.y[i]));
+        thinkUnit(i, dt, decision);
+    }
+    applyDecision(i, decision, dt);
+}
+
+void BattleWorld::thinkUnit(int i, float dt, BattleUnitDecision& out) const
+{
+    // 目标失效（空/血量为0/已摧毁）时重新寻靶：评分 = 距离 + 类型偏置，由建筑索引按类型分桶、由近到远剪枝搜索
+    out.foe = BATTLE_INVALID_INDEX;
+    if (thinkFoe(i, dt, out)) return;
+
+    BattleVec2 myPos(_units.x[i], _units.y[i]);
+    int t = _units.target[i];
+    if (t == BATTLE_INVALID_INDEX || _buildings.hp[t] <= 0 || _buildings.destroyed[t]) {
+        t = _targetIndex.findBestTarget(static_cast<SoldierType>(_units.type[i]), myPos);
+    }
+    out.target = t;
+
+    if (t == BATTLE_INVALID_INDEX) {
+        out.action = BattleUnitDecision::IDLE;
+        return;
+    }
+
+    BattleVec2 targetPos(_buildings.x[t], _buildings.y[t]);
+    float dist = myPos.distance(targetPos);
+    if (dist <= _units.attackRange[i] || isUnitTouchingBuilding(i, t)) {
+        out.action = BattleUnitDecision::ATTACK;
+        return;
+    }
+
+    // 移动：陆军沿目标的共享流场前进；流场要求穿过围墙时改为攻击该围墙。
+    // 没有可用路径、位于地图外或已进入目标瓦片时仍按直线接近目标
+    BattleVec2 direction = (targetPos - myPos).normalized();
+    if (!_units.flying[i]) {
+        BattleFlowStep step;
+        if (!_flowFields.peekStep(t, myPos, step)) {
+            out.action = BattleUnitDecision::RECOMPUTE;
+            return;
+        }
+        if (step.valid) {
+            if (step.wall != BATTLE_INVALID_INDEX && step.wall != t) {
+                out.target = step.wall;
+                out.action = BattleUnitDecision::HOLD;
+                return;
+            }
+            direction = (step.waypoint - myPos).normalized();
+        }
+    }
+
+    BattleVec2 nextPos = myPos + direction * (_units.moveSpeed[i] * dt);
+
+    // 陆军：下一步被建筑阻挡时，已接触目标或远程单位已在射程内则原地等待，否则改打附近围墙
+    if (!_units.flying[i] && isPositionBlocked(nextPos)) {
+        out.action = BattleUnitDecision::HOLD;
+        if (isUnitTouchingBuilding(i, t)) return;
+        bool isRanged = _units.attackRange[i] > BattleRules::RANGED_THRESHOLD;
+        if (isRanged && dist <= _units.attackRange[i]) return;
+
+        int wall = findNearestWall(i);
+        if (wall != BATTLE_INVALID_INDEX && wall != t) out.target = wall;
+        return;
+    }
+
+    out.action = BattleUnitDecision::STEP;
+    out.x = nextPos.x;
+    out.y = nextPos.y;
+    out.facingLeft = _units.facingLeft[i];
+    if (direction.x > 0) out.facingLeft = 0;
+    else if (direction.x < 0) out.facingLeft = 1;
+}
+
+bool BattleWorld::thinkFoe(int i, float dt, BattleUnitDecision& out) const
+{
+    // 有守军在交战距离内时优先与最近的守军交战（近战单位为 UNIT_AGGRO_RADIUS，远程单位为射程）
+    const SoldierType type = static_cast<SoldierType>(_units.type[i]);
+    if (_aliveDefenders == 0 || !BattleRules::fightsUnits(type)) return false;
+
+    const BattleVec2 myPos(_units.x[i], _units.y[i]);
+    const float engage = std::max(_units.attackRange[i], BattleRules::UNIT_AGGRO_RADIUS);
+    int layers = 1 << BattleSpatialGrid::GROUND;
+    if (BattleRules::canHitUnit(type, true)) layers |= 1 << BattleSpatialGrid::AIR;
+    int foe = BATTLE_INVALID_INDEX;
+    if (_defenderGrid.findKNearest(myPos, engage, layers, 1, &foe, nullptr) == 0) return false;
+
+    out.target = _units.target[i];
+    out.foe = foe;
+    const BattleVec2 foePos(_units.x[foe], _units.y[foe]);
+    if (myPos.distance(foePos) <= _units.attackRange[i]) {
+        out.action = BattleUnitDecision::ATTACK;
+        return true;
+    }
+
+    // 直线接近守军；陆军被建筑挡住时原地等待
+    const BattleVec2 direction = (foePos - myPos).normalized();
+    const BattleVec2 nextPos = myPos + direction * (_units.moveSpeed[i] * dt);
+    if (!_units.flying[i] && isPositionBlocked(nextPos)) {
+        out.action = BattleUnitDecision::HOLD;
+        return true;
+    }
+    out.action = BattleUnitDecision::STEP;
+    out.x = nextPos.x;
+    out.y = nextPos.y;
+    out.facingLeft = _units.facingLeft[i];
+    if (direction.x > 0) out.facingLeft = 0;
+    else if (direction.x < 0) out.facingLeft = 1;
+    return true;
+}
+
+void BattleWorld::applyDecision(int i, const BattleUnitDecision& decision, float dt)
+{
+    _units.target[i] = decision.target;
+    _units.foe[i] = decision.foe;
+    switch (decision.action) {
+        case BattleUnitDecision::IDLE:
+            _units.state[i] = static_cast<uint8_t>(BattleUnitState::IDLE);
+            break;
+        case BattleUnitDecision::ATTACK:
+            _units.state[i] = static_cast<uint8_t>(BattleUnitState::ATTACKING);
+            attackWithUnit(i, dt);
+            break;
+        case BattleUnitDecision::STEP:
+            _units.state[i] = static_cast<uint8_t>(BattleUnitState::MOVING);
+            _units.x[i] = decision.x;
+            _units.y[i] = decision.y;
+            _units.facingLeft[i] = decision.facingLeft;
+            gridOf(i).update(i, BattleVec2(decision.x, decision.y));
+            break;
+        case BattleUnitDecision::HOLD:
+        default:
+            _units.state[i] = static_cast<uint8_t>(BattleUnitState::MOVING);
+            break;
+    }
+}
+
+void BattleWorld::separateUnits(float dt)
+{
+    // 分离位移基于单位 AI 之后、分离之前的位置一次性算出，推入建筑的位移已在求解时放弃
+    _separation.solve(_units, _occupancy, dt);
+    for (int k = 0; k < _separation.getMoveCount(); ++k) {
+        const int i = _separation.getMoveUnit(k);
+        _units.x[i] = _separation.getMoveX(k);
+        _units.y[i] = _separation.getMoveY(k);
+        gridOf(i).update(i, BattleVec2(_units.x[i], _units.y[i]));
+    }
+}
+
+BattleSpatialGrid& BattleWorld::gridOf(int i)
+{
+    return _units.team[i] ? _defenderGrid : _unitGrid;
+}
+
+void BattleWorld::updateDefenders(float dt)
+{
+    if (_aliveDefenders == 0) return;
+
+    // 守军数量远少于进攻方，按索引顺序逐个处理；选敌通过进攻方网格上的 k 近邻查询完成
+    const int unitCount = static_cast<int>(_units.size());
+    for (int i = 0; i < unitCount; ++i) {
+        if (!_units.alive[i] || !_units.team[i]) continue;
+
+        const BattleVec2 myPos(_units.x[i], _units.y[i]);
+        int foe = _units.foe[i];
+        if (foe == BATTLE_INVALID_INDEX || !_units.alive[foe]
+            || myPos.distance(BattleVec2(_units.x[foe], _units.y[foe])) > BattleRules::DEFENDER_SIGHT_RADIUS) {
+            foe = findDefenderFoe(i);
+        }
+        _units.foe[i] = foe;
+
+        if (foe != BATTLE_INVALID_INDEX) {
+            const BattleVec2 foePos(_units.x[foe], _units.y[foe]);
+            if (myPos.distance(foePos) <= _units.attackRange[i]) {
+                _units.state[i] = static_cast<uint8_t>(BattleUnitState::ATTACKING);
+                attackWithUnit(i, dt);
+            }
+            else {
+                _units.state[i] = static_cast<uint8_t>(BattleUnitState::MOVING);
+                moveUnitToward(i, foePos, dt);
+            }
+            continue;
+        }
+
+        // 没有敌人：回到兵营附近待命
+        const int b = _units.home[i];
+        const BattleVec2 homePos(_buildings.x[b], _buildings.y[b]);
+        if (myPos.distance(homePos) > BattleRules::DEFENDER_LEASH_RADIUS) {
+            _units.state[i] = static_cast<uint8_t>(BattleUnitState::MOVING);
+            moveUnitToward(i, homePos, dt);
+        }
+        else {
+            _units.state[i] = static_cast<uint8_t>(BattleUnitState::IDLE);
+        }
+    }
+}
+
+int BattleWorld::findDefenderFoe(int i) const
+{
+    // 视野内最近的 k 个进攻方单位中集火血量最低者（血量相同取更近的）
+    const SoldierType type = static_cast<SoldierType>(_units.type[i]);
+    int layers = 1 << BattleSpatialGrid::GROUND;
+    if (BattleRules::canHitUnit(type, true)) layers |= 1 << BattleSpatialGrid::AIR;
+
+    int nearest[BattleSpatialGrid::MAX_NEAREST];
+    const int found = _unitGrid.findKNearest(BattleVec2(_units.x[i], _units.y[i]), BattleRules::DEFENDER_SIGHT_RADIUS,
+        layers, BattleRules::DEFENDER_TARGET_K, nearest, nullptr);
+
+    int best = BATTLE_INVALID_INDEX;
+    for (int k = 0; k < found; ++k) {
+        if (best == BATTLE_INVALID_INDEX || _units.hp[nearest[k]] < _units.hp[best]) best = nearest[k];
+    }
+    return best;
+}
+
+void BattleWorld::moveUnitToward(int i, const BattleVec2& goal, float dt)
+{
+    const BattleVec2 myPos(_units.x[i], _units.y[i]);
+    const BattleVec2 direction = (goal - myPos).normalized();
+    const float stepLength = _units.moveSpeed[i] * dt;
+    BattleVec2 nextPos = myPos + direction * stepLength;
+
+    // 陆军被建筑挡住时沿水平、垂直方向贴边滑动，都走不通则原地等待
+    if (!_units.flying[i] && isPositionBlocked(nextPos)) {
+        const BattleVec2 slideX(myPos.x + (direction.x < 0 ? -stepLength : stepLength), myPos.y);
+        const BattleVec2 slideY(myPos.x, myPos.y + (direction.y < 0 ? -stepLength : stepLength));
+        if (direction.x != 0.0f && !isPositionBlocked(slideX)) nextPos = slideX;
+        else if (direction.y != 0.0f && !isPositionBlocked(slideY)) nextPos = slideY;
+        else return;
+    }
+
+    _units.x[i] = nextPos.x;
+    _units.y[i] = nextPos.y;
+    if (direction.x > 0) _units.facingLeft[i] = 0;
+    else if (direction.x < 0) _units.facingLeft[i] = 1;
+    gridOf(i).update(i, nextPos);
+}
+
+bool BattleWorld::isUnitTouchingBuilding(int i, int b) const
+{
+    float h = _units.halfSize[i];
+    BattleRect box(_units.x[i] - h, _units.y[i] - h, h * 2.0f, h * 2.0f);
+    return box.intersects(_buildings.footprint[b]);
+}
+
+int BattleWorld::findNearestWall(int i) const
+{
+    return _targetIndex.findNearest(EnemyType::WALL, BattleVec2(_units.x[i], _units.y[i]),
+        BattleRules::WALL_SEARCH_RADIUS);
+}
+
+void BattleWorld::attackWithUnit(int i, float dt)
+{
+    _units.attackTimer[i] += dt;
+    if (_units.attackTimer[i] < _units.attackInterval[i]) return;
+    _units.attackTimer[i] = 0.0f;
+
+    BattleVec2 myPos(_units.x[i], _units.y[i]);
+
+    // 单位之间交战：近战与远程都直接记入伤害（不发射弹道）
+    const int foe = _units.foe[i];
+    if (foe != BATTLE_INVALID_INDEX) {
+        if (!_units.alive[foe]) return;
+        emit(BattleEventType::UNIT_ATTACKED, i, BATTLE_INVALID_INDEX, myPos);
+        _damage.addUnitDamage(foe, _units.attackDamage[i]);
+        return;
+    }
+
+    int t = _units.target[i];
+    if (t == BATTLE_INVALID_INDEX) return;
+
+    emit(BattleEventType::UNIT_ATTACKED, i, t, myPos);
+
+    const BattleUnitStats& stats = BattleRules::unitStats(static_cast<SoldierType>(_units.type[i]));
+    switch (stats.attackKind) {
+        case BattleAttackKind::ARROW:
+            if (!_buildings.destroyed[t]) {
+                fireProjectile(BattleProjectileKind::ARROW, i, myPos, t,
+                    BattleVec2(_buildings.x[t], _buildings.y[t]), _units.attackDamage[i], BattleRules::ARROW_SPEED);
+            }
+            break;
+        case BattleAttackKind::SUICIDE:
+            // 自爆：目标与占地在爆炸范围内的其他建筑都受到伤害（入队，步末结算）；
+            // 单位本身立即阵亡而不入队，否则本步后续的防御建筑仍会向已爆炸的单位开火
+            _damage.addBuildingDamage(t, _units.attackDamage[i]);
+            damageBuildingsInArea(BattleArea::circle(myPos, BattleRules::BOOM_BLAST_RADIUS), _units.attackDamage[i], t);
+            emit(BattleEventType::UNIT_EXPLODED, i, t, myPos);
+            killUnit(i);
+            return;
+        case BattleAttackKind::MELEE:
+        default:
+            _damage.addBuildingDamage(t, _units.attackDamage[i]);
+            break;
+    }
+}
+
+// =========================================================
+// 6. 防御建筑、陷阱、弹道
+// =========================================================
+
+void BattleWorld::updateTowers(float dt)
+{
+    const int count = static_cast<int>(_buildings.size());
+
+    // 并行索敌：本阶段只发射弹道，不移动也不移除单位，各防御建筑的扫描互不影响；
+    // 预先算好本步冷却结束的防御建筑的目标，未预先计算的（标记为 -2）在下面照常扫描
+    const bool parallel = _jobs && _tally.getAliveUnitCount() >= BattleRules::PARALLEL_MIN_UNITS;
+    if (parallel) {
+        _towerTargets.assign(count, -2);
+        _jobs->parallelFor(count, 1, [this, dt](int begin, int end) {
+            for (int b = begin; b < end; ++b) {
+                if (isTowerReady(b, dt)) _towerTargets[b] = findTowerTarget(b);
+            }
+        });
+    }
+
+    for (int b = 0; b < count; ++b) {
+        if (_buildings.destroyed[b] || _buildings.attack[b] <= 0) continue;
+
+        _buildings.attackTimer[b] += dt;
+        if (_buildings.attackTimer[b] < BattleRules::TOWER_COOLDOWN) continue;
+
+        int target = parallel && _towerTargets[b] != -2 ? _towerTargets[b] : findTowerTarget(b);
+        if (target == BATTLE_INVALID_INDEX) continue;
+
+        BattleVec2 from(_buildings.x[b], _buildings.y[b]);
+        fireProjectile(BattleProjectileKind::CANNONBALL, b, from, target,
+            BattleVec2(_units.x[target], _units.y[target]), _buildings.attack[b], BattleRules::CANNONBALL_SPEED);
+        _buildings.attackTimer[b] = 0.0f;
+    }
+}
+
+bool BattleWorld::isTowerReady(int b, float dt) const
+{
+    if (_buildings.destroyed[b] || _buildings.attack[b] <= 0) return false;
+    float timer = _buildings.attackTimer[b] + dt;
+    return timer >= BattleRules::TOWER_COOLDOWN;
+}
+
+int BattleWorld::findTowerTarget(int b) const
+{
+    EnemyType towerType = static_cast<EnemyType>(_buildings.type[b]);
+    BattleVec2 towerPos(_buildings.x[b], _buildings.y[b]);
+    const float range = _buildings.range[b];
+    const float rangeSq = range * range;
+
+    // 一次遍历射程覆盖的格子，地面与空中各自记录最近单位；距离相同取索引较小者，与逐个遍历的结果一致。
+    // 桶内坐标打包存放，由向量内核按平方距离一次比较 4 个单位
+    int best[BattleSpatialGrid::LAYER_COUNT] = { BATTLE_INVALID_INDEX, BATTLE_INVALID_INDEX };
+    float bestDistSq[BattleSpatialGrid::LAYER_COUNT] = { rangeSq, rangeSq };
+
+    BattleGridCellRange cells = _unitGrid.cellsInRadius(towerPos, range);
+    for (int layer = 0; layer < BattleSpatialGrid::LAYER_COUNT; ++layer) {
+        if (!BattleRules::towerCanHit(towerType, layer == BattleSpatialGrid::AIR)) continue;
+        for (int row = cells.minRow; row <= cells.maxRow; ++row) {
+            for (int col = cells.minCol; col <= cells.maxCol; ++col) {
+                const BattlePointList& bucket = _unitGrid.bucket(col, row, static_cast<BattleSpatialGrid::Layer>(layer));
+                if (bucket.empty()) continue;
+                BattleSimd::nearestSq(towerPos.x, towerPos.y, bucket.x.data(), bucket.y.data(), bucket.ids.data(),
+                    bucket.size(), bestDistSq[layer], best[layer]);
+            }
+        }
+    }
+
+    int air = best[BattleSpatialGrid::AIR];
+    int ground = best[BattleSpatialGrid::GROUND];
+
+    // 加农炮：有空中目标先打空中
+    if (BattleRules::towerPrefersAir(towerType) && air != BATTLE_INVALID_INDEX) return air;
+    if (air == BATTLE_INVALID_INDEX) return ground;
+    if (ground == BATTLE_INVALID_INDEX) return air;
+
+    // 不区分空地：取两层中更近的一个
+    float airDistSq = bestDistSq[BattleSpatialGrid::AIR];
+    float groundDistSq = bestDistSq[BattleSpatialGrid::GROUND];
+    if (airDistSq < groundDistSq || (airDistSq == groundDistSq && air < ground)) return air;
+    return ground;
+}
+
+void BattleWorld::updateTraps()
+{
+    for (size_t t = 0; t < _traps.size(); ++t) {
+        if (_trapExploded[t]) continue;
+
+        // 任一存活的地面单位踩入区域即触发（空军不受地雷影响），区域内的地面单位全部受到爆炸伤害；
+        // 只查询陷阱区域覆盖的网格格子
+        const BattleArea area = BattleArea::box(_traps[t].area);
+        if (damageUnitsInArea(area, BATTLE_AREA_GROUND, _traps[t].damage, BATTLE_INVALID_INDEX) == 0) continue;
+
+        _trapExploded[t] = 1;
+        emit(BattleEventType::TRAP_EXPLODED, static_cast<int>(t), BATTLE_INVALID_INDEX, area.center);
+    }
+}
+
+void BattleWorld::updateBarracks(float dt)
+{
+    const int count = static_cast<int>(_buildings.size());
+    for (int b = 0; b < count; ++b) {
+        if (_buildings.garrison[b] <= 0 || _buildings.destroyed[b]) continue;
+
+        // 进攻方单位进入警戒范围后惊动兵营，立即释放第一个守军，之后按间隔逐个释放
+        if (!_buildings.alerted[b]) {
+            int intruder = BATTLE_INVALID_INDEX;
+            const int layers = (1 << BattleSpatialGrid::GROUND) | (1 << BattleSpatialGrid::AIR);
+            if (_unitGrid.findKNearest(BattleVec2(_buildings.x[b], _buildings.y[b]), BattleRules::BARRACKS_ALERT_RADIUS,
+                    layers, 1, &intruder, nullptr) == 0) {
+                continue;
+            }
+            _buildings.alerted[b] = 1;
+            _buildings.attackTimer[b] = BattleRules::DEFENDER_RELEASE_INTERVAL;
+        }
+        else {
+            _buildings.attackTimer[b] += dt;
+        }
+        if (_buildings.attackTimer[b] < BattleRules::DEFENDER_RELEASE_INTERVAL) continue;
+
+        _buildings.attackTimer[b] = 0.0f;
+        releaseDefender(b);
+    }
+}
+
+void BattleWorld::releaseDefender(int b)
+{
+    const int released = _level.buildings[b].garrison - _buildings.garrison[b];
+    _buildings.garrison[b]--;
+
+    // 出口：依次尝试紧贴兵营占地的下、右、上、左四个位置，取第一个未被建筑阻挡的
+    const SoldierType type = BattleRules::defenderType(released);
+    const float h = BattleRules::unitStats(type).halfSize;
+    const BattleRect& f = _buildings.footprint[b];
+    const BattleVec2 c = f.center();
+    const BattleVec2 exits[4] = {
+        BattleVec2(c.x, f.minY() - h), BattleVec2(f.maxX() + h, c.y),
+        BattleVec2(c.x, f.maxY() + h), BattleVec2(f.minX() - h, c.y)
+    };
+    BattleVec2 pos = exits[0];
+    for (const BattleVec2& exit : exits) {
+        if (!isPositionBlocked(exit)) {
+            pos = exit;
+            break;
+        }
+    }
+
+    const int unit = _units.push(type, pos, BattleTeam::DEFENDER, b);
+    _defenderGrid.insert(unit, pos, _units.flying[unit] ? BattleSpatialGrid::AIR : BattleSpatialGrid::GROUND);
+    _aliveDefenders++;
+    emit(BattleEventType::UNIT_DEPLOYED, unit, b, pos);
+}
+
+void BattleWorld::fireProjectile(BattleProjectileKind kind, int shooter, const BattleVec2& from,
+    int target, const BattleVec2& to, int damage, float speed)
+{
+    BattleProjectile p;
+    p.kind = kind;
+    p.shooter = shooter;
+    p.target = target;
+    p.damage = damage;
+    p.from = from;
+    p.to = to;
+    p.flightTime = from.distance(to) / speed;
+    p.timeLeft = p.flightTime;
+    _projectiles.spawn(p);
+
+    if (_eventsEnabled) {
+        BattleEvent e;
+        e.type = BattleEventType::PROJECTILE_FIRED;
+        e.projectile = kind;
+        e.a = shooter;
+        e.b = target;
+        e.pos = from;
+        e.target = to;
+        e.duration = p.timeLeft;
+        _events.push_back(e);
+    }
+}
+
+void BattleWorld::updateProjectiles(float dt)
+{
+    _projectiles.advance(dt, [this](const BattleProjectile& p) {
+        // 命中时目标仍有效才记入伤害（原逻辑：箭要求建筑血量>0，炮弹要求士兵仍在场）
+        if (p.kind == BattleProjectileKind::ARROW) {
+            if (_buildings.hp[p.target] > 0) _damage.addBuildingDamage(p.target, p.damage);
+        }
+        else {
+            if (_units.alive[p.target]) _damage.addUnitDamage(p.target, p.damage);
+
+            // 加农炮溅射：落点附近与目标同层的其他单位受到相同伤害
+            if (_level.cannonSplashRadius > 0.0f
+                && static_cast<EnemyType>(_buildings.type[p.shooter]) == EnemyType::CANNON) {
+                const int layer = _units.flying[p.target] ? BATTLE_AREA_AIR : BATTLE_AREA_GROUND;
+                damageUnitsInArea(BattleArea::circle(p.to, _level.cannonSplashRadius), layer, p.damage, p.target);
+                emit(BattleEventType::SPLASH_EXPLODED, p.shooter, p.target, p.to);
+            }
+        }
+    });
+}
+
+// =========================================================
+// 7. 伤害结算
+// =========================================================
+
+void BattleWorld::resolveDamage()
+{
+    if (_damage.empty()) return;
+
+    // 按首次命中顺序结算：每个实体只扣一次合并后的伤害，受击 / 摧毁 / 阵亡事件各至多一条
+    for (int b : _damage.damagedBuildings()) damageBuilding(b, _damage.getBuildingDamage(b));
+    for (int i : _damage.damagedUnits()) damageUnit(i, _damage.getUnitDamage(i));
+    _damage.clear();
+}
+
+void BattleWorld::damageBuilding(int b, int damage)
+{
+    if (_buildings.destroyed[b]) return;
+    _buildings.hp[b] -= damage;
+    if (_buildings.hp[b] < 0) _buildings.hp[b] = 0;
+
+    BattleVec2 pos(_buildings.x[b], _buildings.y[b]);
+    emit(BattleEventType::BUILDING_DAMAGED, b, BATTLE_INVALID_INDEX, pos);
+
+    if (_buildings.hp[b] == 0) {
+        _buildings.destroyed[b] = 1;
+        _buildings.attack[b] = 0;
+        _targetIndex.remove(b);
+        _flowFields.onBuildingDestroyed(b);
+        _occupancy.clearBuilding(b);
+        _tally.onBuildingDestroyed(static_cast<EnemyType>(_buildings.type[b]));
+        emit(BattleEventType::BUILDING_DESTROYED, b, BATTLE_INVALID_INDEX, pos);
+    }
+}
+
+void BattleWorld::damageUnit(int i, int damage)
+{
+    if (!_units.alive[i]) return;
+    _units.hp[i] -= damage;
+    if (_units.hp[i] <= 0) killUnit(i);
+}
+
+int BattleWorld::damageUnitsInArea(const BattleArea& area, int layers, int damage, int skip)
+{
+    BattleAreaEffect::collectUnits(_unitGrid, area, layers, _areaHits);
+    for (int i : _areaHits) {
+        if (i != skip) _damage.addUnitDamage(i, damage);
+    }
+    return static_cast<int>(_areaHits.size());
+}
+
+int BattleWorld::damageBuildingsInArea(const BattleArea& area, int damage, int skip)
+{
+    BattleAreaEffect::collectBuildings(_targetIndex, _buildings.footprint, area, _areaHits);
+    for (int b : _areaHits) {
+        if (b != skip) _damage.addBuildingDamage(b, damage);
+    }
+    return static_cast<int>(_areaHits.size());
+}
+
+void BattleWorld::killUnit(int i)
+{
+    if (!_units.alive[i]) return;
+    _units.hp[i] = 0;
+    _units.alive[i] = 0;
+    gridOf(i).remove(i);
+    if (_units.team[i]) _aliveDefenders--;
+    else _tally.onUnitDied(static_cast<SoldierType>(_units.type[i]));
+    emit(BattleEventType::UNIT_DIED, i, BATTLE_INVALID_INDEX, BattleVec2(_units.x[i], _units.y[i]));
+}
+
+// =========================================================
+// 8. 胜负判定
+// =========================================================
+
+void BattleWorld::updateOutcome()
+{
+    // 胜利：大本营被摧毁（或不存在）且所有非围墙建筑被摧毁（大本营本身是非围墙建筑）
+    if (_tally.getAliveNonWallCount() == 0) {
+        _outcome = BattleOutcome::VICTORY;
+        return;
+    }
+
+    // 失败：战场无存活士兵且无剩余可投放士兵
+    if (_tally.getAliveUnitCount() == 0 && _totalReserve == 0) {
+        _outcome = BattleOutcome::DEFEAT;
+    }
+}
+
+void BattleWorld::emit(BattleEventType type, int a, int b, const BattleVec2& pos)
+{
+    if (!_eventsEnabled) return;
+    BattleEvent e;
+    e.type = type;
+    e.projectile = BattleProjectileKind::ARROW;
+    e.a = a;
+    e.b = b;
+    e.pos = pos;
+    e.target = pos;
+    e.duration = 0.0f;
+    _events.push_back(e);
+}
+
+// =========================================================
+// 9. 快照
+// =========================================================
+
+namespace {
+
+template <typename T>
+uint8_t* packArray(uint8_t* out, const std::vector<T>& v)
+{
+    const size_t bytes = v.size() * sizeof(T);
+    if (bytes) std::memcpy(out, v.data(), bytes);
+    return out + bytes;
+}
+
+template <typename T>
+const uint8_t* unpackArray(const uint8_t* in, std::vector<T>& v, size_t count)
+{
+    v.resize(count);
+    const size_t bytes = count * sizeof(T);
+    if (bytes) std::memcpy(v.data(), in, bytes);
+    return in + bytes;
+}
+
+/// index 是否为 [0, count) 内的下标
+inline bool isIndexIn(int index, size_t count)
+{
+    return index >= 0 && static_cast<size_t>(index) < count;
+}
+
+/// index 是否为 [0, count) 内的下标或 BATTLE_INVALID_INDEX
+inline bool isIndexOrNone(int index, size_t count)
+{
+    return index == BATTLE_INVALID_INDEX || isIndexIn(index, count);
+}
+
+/// 浮点数组是否全部为有限值
+bool allFinite(const std::vector<float>& values)
+{
+    for (float v : values) {
+        if (!std::isfinite(v)) return false;
+    }
+    return true;
+}
+
+/**
+ * @brief      快照中的坐标是否可信
+ * @details    单位可以被挤出地图边缘一点（各网格按边界夹取格子），但不会远离地图；
+ *             超出地图一倍尺寸或非有限值的坐标只能来自损坏的存档，换算格子时会越界
+ */
+bool isPlausiblePosition(float x, float y, const BattleLevelDesc& level)
+{
+    return std::isfinite(x) && std::isfinite(y)
+        && x >= -level.mapWidth && x <= level.mapWidth * 2.0f
+        && y >= -level.mapHeight && y <= level.mapHeight * 2.0f;
+}
+
+/**
+ * @brief      检查快照解包出的单位与弹道是否只引用存在的兵种、单位与建筑
+ * @details    快照可能来自磁盘上损坏或被改动的续玩存档，任何越界的枚举、索引或坐标都会在恢复后的
+ *             模拟中越界读写，因此必须在写入世界之前整体校验
+ */
+bool isRestorable(const BattleUnitStore& units, const BattleLevelDesc& level, const std::vector<float>& buildingAttackTimer,
+    const std::vector<BattleProjectile>& slots, const std::vector<int>& freeSlots, const std::vector<int>& active)
+{
+    const size_t n = units.size();
+    const size_t buildingCount = level.buildings.size();
+    for (size_t i = 0; i < n; ++i) {
+        if (units.type[i] >= BATTLE_SOLDIER_TYPE_COUNT) return false;
+        if (units.state[i] > static_cast<uint8_t>(BattleUnitState::ATTACKING)) return false;
+        if (units.team[i] > static_cast<uint8_t>(BattleTeam::DEFENDER)) return false;
+        if (!isIndexOrNone(units.target[i], buildingCount)) return false;
+        if (!isIndexOrNone(units.foe[i], n)) return false;
+        if (!isIndexOrNone(units.home[i], buildingCount)) return false;
+        if (!isPlausiblePosition(units.x[i], units.y[i], level)) return false;
+        if (!isPlausiblePosition(units.prevX[i], units.prevY[i], level)) return false;
+
+        // 兵种固有属性投放后不再改变，必须与规则表一致（防止被改成极大的移速、射程等）
+        const BattleUnitStats& stats = BattleRules::unitStats(static_cast<SoldierType>(units.type[i]));
+        if (units.maxHp[i] != stats.maxHp || units.attackDamage[i] != stats.attackDamage
+            || units.attackRange[i] != stats.attackRange || units.attackInterval[i] != stats.attackInterval
+            || units.moveSpeed[i] != stats.moveSpeed || units.halfSize[i] != stats.halfSize
+            || units.flying[i] != (stats.flying ? 1 : 0)) {
+            return false;
+        }
+    }
+    if (!allFinite(units.attackTimer) || !allFinite(buildingAttackTimer)) return false;
+
+    // 空闲栈与活动列表中的槽位必须存在且互不重复，活动弹道的发射者、目标与起止点必须可信
+    std::vector<uint8_t> used(slots.size(), 0);
+    for (int slot : freeSlots) {
+        if (!isIndexIn(slot, slots.size()) || used[slot]) return false;
+        used[slot] = 1;
+    }
+    for (int slot : active) {
+        if (!isIndexIn(slot, slots.size()) || used[slot]) return false;
+        used[slot] = 1;
+        const BattleProjectile& p = slots[slot];
+        if (p.kind == BattleProjectileKind::ARROW) {
+            if (!isIndexIn(p.shooter, n) || !isIndexIn(p.target, buildingCount)) return false;
+        }
+        else if (p.kind == BattleProjectileKind::CANNONBALL) {
+            if (!isIndexIn(p.shooter, buildingCount) || !isIndexIn(p.target, n)) return false;
+        }
+        else {
+            return false;
+        }
+        if (!isPlausiblePosition(p.from.x, p.from.y, level) || !isPlausiblePosition(p.to.x, p.to.y, level)) return false;
+        if (!std::isfinite(p.flightTime) || !std::isfinite(p.timeLeft)) return false;
+    }
+    return true;
+}
+
+} // namespace
+
+void BattleWorld::captureSnapshot(BattleSnapshot& out, int tick) const
+{
+    BattleSnapshotHeader& h = out._header;
+    h.magic = BattleSnapshot::MAGIC;
+    h.version = BattleSnapshot::FORMAT_VERSION;
+    h.tick = static_cast<uint32_t>(tick);
+    h.elapsed = _elapsed;
+    h.steps = static_cast<uint32_t>(_steps);
+    h.separationCursor = static_cast<uint32_t>(_separation.getCursor());
+    for (int i = 0; i < BATTLE_SOLDIER_TYPE_COUNT; ++i) h.reserve[i] = _reserve[i];
+    h.outcome = static_cast<uint32_t>(_outcome);
+    h.unitCount = static_cast<uint32_t>(_units.size());
+    h.buildingCount = static_cast<uint32_t>(_buildings.size());
+    h.trapCount = static_cast<uint32_t>(_trapExploded.size());
+    h.projectileSlotCount = static_cast<uint32_t>(_projectiles.slots().size());
+    h.projectileFreeCount = static_cast<uint32_t>(_projectiles.freeSlots().size());
+    h.projectileActiveCount = static_cast<uint32_t>(_projectiles.activeSlots().size());
+
+    // resize 不会缩小容量：同一快照对象反复截取时只在单位数量超过历史最大值时分配
+    out._payload.resize(BattleSnapshot::payloadSize(h));
+    uint8_t* p = out._payload.data();
+    p = packArray(p, _units.type);
+    p = packArray(p, _units.x);
+    p = packArray(p, _units.y);
+    p = packArray(p, _units.prevX);
+    p = packArray(p, _units.prevY);
+    p = packArray(p, _units.hp);
+    p = packArray(p, _units.maxHp);
+    p = packArray(p, _units.attackDamage);
+    p = packArray(p, _units.attackRange);
+    p = packArray(p, _units.attackInterval);
+    p = packArray(p, _units.attackTimer);
+    p = packArray(p, _units.moveSpeed);
+    p = packArray(p, _units.halfSize);
+    p = packArray(p, _units.flying);
+    p = packArray(p, _units.state);
+    p = packArray(p, _units.facingLeft);
+    p = packArray(p, _units.alive);
+    p = packArray(p, _units.target);
+    p = packArray(p, _units.team);
+    p = packArray(p, _units.foe);
+    p = packArray(p, _units.home);
+    p = packArray(p, _buildings.hp);
+    p = packArray(p, _buildings.attack);
+    p = packArray(p, _buildings.attackTimer);
+    p = packArray(p, _buildings.destroyed);
+    p = packArray(p, _buildings.garrison);
+    p = packArray(p, _buildings.alerted);
+    p = packArray(p, _trapExploded);
+    p = packArray(p, _projectiles.slots());
+    p = packArray(p, _projectiles.freeSlots());
+    packArray(p, _projectiles.activeSlots());
+}
+
+bool BattleWorld::restoreSnapshot(const BattleSnapshot& snapshot)
+{
+    const BattleSnapshotHeader& h = snapshot.header();
+    if (!snapshot.isValid() || snapshot.payload().size() != BattleSnapshot::payloadSize(h)) return false;
+    if (h.buildingCount != _buildings.size() || h.trapCount != _trapExploded.size()) return false;
+    if (h.outcome > static_cast<uint32_t>(BattleOutcome::DEFEAT) || !std::isfinite(h.elapsed)) return false;
+    // 步数参与 AI 错峰相位的整数运算，留出余量避免恢复后继续推进时溢出
+    if (h.steps > static_cast<uint32_t>(INT_MAX / 2) || h.separationCursor > static_cast<uint32_t>(INT_MAX)) return false;
+    for (int i = 0; i < BATTLE_SOLDIER_TYPE_COUNT; ++i) {
+        if (h.reserve[i] < 0) return false;
+    }
+
+    // 先解包到临时存储并校验，全部通过后才写入世界；校验失败时世界保持原状，调用方改为按录像快进
+    const size_t n = h.unitCount;
+    BattleUnitStore units;
+    std::vector<int> buildingHp;
+    std::vector<int> buildingAttack;
+    std::vector<float> buildingAttackTimer;
+    std::vector<uint8_t> buildingDestroyed;
+    std::vector<int> buildingGarrison;
+    std::vector<uint8_t> buildingAlerted;
+    std::vector<uint8_t> trapExploded;
+    std::vector<BattleProjectile> slots;
+    std::vector<int> freeSlots;
+    std::vector<int> active;
+
+    const uint8_t* p = snapshot.payload().data();
+    p = unpackArray(p, units.type, n);
+    p = unpackArray(p, units.x, n);
+    p = unpackArray(p, units.y, n);
+    p = unpackArray(p, units.prevX, n);
+    p = unpackArray(p, units.prevY, n);
+    p = unpackArray(p, units.hp, n);
+    p = unpackArray(p, units.maxHp, n);
+    p = unpackArray(p, units.attackDamage, n);
+    p = unpackArray(p, units.attackRange, n);
+    p = unpackArray(p, units.attackInterval, n);
+    p = unpackArray(p, units.attackTimer, n);
+    p = unpackArray(p, units.moveSpeed, n);
+    p = unpackArray(p, units.halfSize, n);
+    p = unpackArray(p, units.flying, n);
+    p = unpackArray(p, units.state, n);
+    p = unpackArray(p, units.facingLeft, n);
+    p = unpackArray(p, units.alive, n);
+    p = unpackArray(p, units.target, n);
+    p = unpackArray(p, units.team, n);
+    p = unpackArray(p, units.foe, n);
+    p = unpackArray(p, units.home, n);
+    p = unpackArray(p, buildingHp, h.buildingCount);
+    p = unpackArray(p, buildingAttack, h.buildingCount);
+    p = unpackArray(p, buildingAttackTimer, h.buildingCount);
+    p = unpackArray(p, buildingDestroyed, h.buildingCount);
+    p = unpackArray(p, buildingGarrison, h.buildingCount);
+    p = unpackArray(p, buildingAlerted, h.buildingCount);
+    p = unpackArray(p, trapExploded, h.trapCount);
+    p = unpackArray(p, slots, h.projectileSlotCount);
+    p = unpackArray(p, freeSlots, h.projectileFreeCount);
+    unpackArray(p, active, h.projectileActiveCount);
+    if (!isRestorable(units, _level, buildingAttackTimer, slots, freeSlots, active)) return false;
+
+    // 逐数组赋值，保留世界已有容器的容量
+    _units = units;
+    _buildings.hp = buildingHp;
+    _buildings.attack = buildingAttack;
+    _buildings.attackTimer = buildingAttackTimer;
+    _buildings.destroyed = buildingDestroyed;
+    _buildings.garrison = buildingGarrison;
+    _buildings.alerted = buildingAlerted;
+    _trapExploded = trapExploded;
+    for (BattleProjectile& slot : slots) slot.active = false;
+    for (int slot : active) slots[slot].active = true;
+    _projectiles.restore(slots, freeSlots, active);
+
+    _totalReserve = 0;
+    for (int i = 0; i < BATTLE_SOLDIER_TYPE_COUNT; ++i) {
+        _reserve[i] = h.reserve[i];
+        _totalReserve += h.reserve[i];
+    }
+    _outcome = static_cast<BattleOutcome>(h.outcome);
+    _elapsed = h.elapsed;
+    _steps = static_cast<int>(h.steps);
+    _separation.setCursor(static_cast<int>(h.separationCursor));
+    _events.clear();
+
+    // 派生结构：先按关卡重建，再依次应用摧毁 / 阵亡。
+    // 查询结果只依赖集合内容（距离相同按索引取小），与插入 / 移除的先后无关
+    _unitGrid.reset(_level.mapWidth, _level.mapHeight, BattleRules::UNIT_GRID_CELL_SIZE);
+    _defenderGrid.reset(_level.mapWidth, _level.mapHeight, BattleRules::UNIT_GRID_CELL_SIZE);
+    _aliveDefenders = 0;
+    _targetIndex.build(_level.buildings, _level.mapWidth, _level.mapHeight, BattleRules::TARGET_INDEX_CELL_SIZE);
+    _flowFields.build(_level);
+    _occupancy.build(_level);
+    _tally.reset();
+    _damage.reset(static_cast<int>(_buildings.size()));
+
+    for (size_t b = 0; b < _buildings.size(); ++b) {
+        const EnemyType type = static_cast<EnemyType>(_buildings.type[b]);
+        const bool destroyed = _buildings.destroyed[b] != 0;
+        _tally.addBuilding(type, destroyed);
+        if (!destroyed || _level.buildings[b].hp <= 0) continue;
+        _targetIndex.remove(static_cast<int>(b));
+        _flowFields.onBuildingDestroyed(static_cast<int>(b));
+        _occupancy.clearBuilding(static_cast<int>(b));
+    }
+
+    for (size_t i = 0; i < n; ++i) {
+        const SoldierType type = static_cast<SoldierType>(_units.type[i]);
+        if (_units.team[i]) {
+            if (_units.alive[i]) _aliveDefenders++;
+        }
+        else {
+            _tally.onUnitDeployed(type);
+            if (!_units.alive[i]) _tally.onUnitDied(type);
+        }
+        if (!_units.alive[i]) continue;
+        gridOf(static_cast<int>(i)).insert(static_cast<int>(i), BattleVec2(_units.x[i], _units.y[i]),
+            _units.flying[i] ? BattleSpatialGrid::AIR : BattleSpatialGrid::GROUND);
+    }
+    return true;
+}
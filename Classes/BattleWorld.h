@@ -0,0 +1,420 @@
+/**
+ * @file       BattleWorld.h
+ * @brief      无引擎依赖的战斗模拟核心
+ * @details    BattleWorld 以结构化数组（SoA）的形式保存战斗中所有单位、建筑、陷阱与弹道的状态，
+ *             实现原先分散在 Soldier（寻靶/移动/攻击）、EnemyBuilding（防御塔索敌/发射炮弹/受击）、
+ *             MapTrap（触发/爆炸）与 BattleScene（胜负判定）中的全部战斗规则。
+ *             表现层（BattleScene 及各精灵类）只负责把关卡描述交给核心、转发玩家的投放操作，
+ *             并在每帧读取核心状态与事件来同步精灵，不再参与任何规则计算
+ * @version    1.0
+ * @note       该类不依赖 Cocos2d-x，可在无窗口环境下直接驱动整场战斗，用于批量模拟与性能分析；
+ *             单位与建筑以数组下标作为实体索引，一场战斗内索引稳定不复用
+ */
+#ifndef BATTLE_WORLD_H_
+#define BATTLE_WORLD_H_
+
+#include <vector>
+#include "BattleTypes.h"
+#include "BattleSpatialGrid.h"
+#include "BattleTargetIndex.h"
+#include "BattleFlowField.h"
+#include "BattleOccupancyMap.h"
+#include "BattleDeployMask.h"
+#include "BattleTally.h"
+#include "BattleProjectilePool.h"
+#include "BattleDamageQueue.h"
+#include "BattleAiScheduler.h"
+#include "BattleCrowdSeparation.h"
+#include "BattleAreaEffect.h"
+#include "BattleSnapshot.h"
+
+class BattleJobSystem;
+
+/**
+ * @struct     BattleUnitStore
+ * @brief      单位（士兵）状态的结构化数组存储
+ * @details    每个字段一个连续数组，同一下标对应同一单位；热点循环（索敌、移动、陷阱检测）
+ *             只会触及所需的几个数组，缓存友好且便于后续批量化处理
+ */
+struct BattleUnitStore {
+    std::vector<uint8_t> type;            ///< 兵种（SoldierType）
+    std::vector<float> x;                 ///< 位置 X
+    std::vector<float> y;                 ///< 位置 Y
+    std::vector<float> prevX;             ///< 上一步结束时的位置 X（表现层插值用）
+    std::vector<float> prevY;             ///< 上一步结束时的位置 Y
+    std::vector<int> hp;                  ///< 当前生命值
+    std::vector<int> maxHp;               ///< 最大生命值
+    std::vector<int> attackDamage;        ///< 单次伤害
+    std::vector<float> attackRange;       ///< 攻击范围
+    std::vector<float> attackInterval;    ///< 攻击间隔
+    std::vector<float> attackTimer;       ///< 攻击计时器
+    std::vector<float> moveSpeed;         ///< 移动速度
+    std::vector<float> halfSize;          ///< 碰撞盒半边长
+    std::vector<uint8_t> flying;          ///< 是否飞行
+    std::vector<uint8_t> state;           ///< BattleUnitState
+    std::vector<uint8_t> facingLeft;      ///< 朝向（1=朝左，对应精灵 setFlippedX(true)）
+    std::vector<uint8_t> alive;           ///< 是否存活
+    std::vector<int> target;              ///< 当前目标建筑索引
+    std::vector<uint8_t> team;            ///< 所属阵营（BattleTeam）
+    std::vector<int> foe;                 ///< 正在交战的敌方单位索引（没有时为 BATTLE_INVALID_INDEX）
+    std::vector<int> home;                ///< 守军所属兵营的建筑索引（进攻方为 BATTLE_INVALID_INDEX）
+
+    size_t size() const { return type.size(); }
+    void clear();
+    void reserve(size_t n);
+    int push(SoldierType t, const BattleVec2& pos, BattleTeam side = BattleTeam::ATTACKER,
+        int homeBuilding = BATTLE_INVALID_INDEX);
+};
+
+/**
+ * @struct     BattleBuildingStore
+ * @brief      敌方建筑状态的结构化数组存储（大本营、防御建筑、围墙与资源建筑统一存放）
+ */
+struct BattleBuildingStore {
+    std::vector<uint8_t> type;            ///< 建筑类型（EnemyType）
+    std::vector<float> x;                 ///< 中心位置 X
+    std::vector<float> y;                 ///< 中心位置 Y
+    std::vector<BattleRect> footprint;    ///< 占地矩形
+    std::vector<int> hp;                  ///< 当前生命值
+    std::vector<int> maxHp;               ///< 最大生命值
+    std::vector<int> attack;              ///< 攻击力
+    std::vector<float> range;             ///< 攻击范围
+    std::vector<float> attackTimer;       ///< 攻击计时器
+    std::vector<uint8_t> destroyed;       ///< 是否已被摧毁
+    std::vector<int> garrison;            ///< 兵营尚未释放的守军数量
+    std::vector<uint8_t> alerted;         ///< 兵营是否已被进攻方惊动（开始释放守军）
+
+    size_t size() const { return type.size(); }
+    void clear();
+    int push(const BattleBuildingDesc& desc);
+};
+
+/**
+ * @struct     BattleUnitDecision
+ * @brief      单位在并行思考阶段得出的本步决策
+ * @details    思考阶段只读地完成寻靶、流场查询与阻挡判定，应用阶段按单位索引顺序写回；
+ *             本步已有建筑被摧毁（寻靶索引、流场、占据栅格随之变化）或流场尚未构建时决策作废，
+ *             该单位改为按单线程流程重新计算，因此结果与单线程逐位一致。
+ *             与守军交战时 foe 为守军索引：ATTACK 攻击该守军，STEP 朝该守军移动
+ */
+struct BattleUnitDecision {
+    /// 决策动作
+    enum Action : uint8_t {
+        RECOMPUTE = 0,   ///< 无法只读地决策，应用阶段按单线程流程处理
+        IDLE,            ///< 没有目标，待机
+        ATTACK,          ///< 在射程内或已接触目标，攻击
+        HOLD,            ///< 移动状态但本步不前进（被阻挡等待或改打围墙）
+        STEP             ///< 移动到 (x, y)
+    };
+
+    int target;          ///< 决策后的目标建筑索引
+    int foe;             ///< 决策后交战的守军索引（没有时为 BATTLE_INVALID_INDEX）
+    float x;             ///< STEP：新位置 X
+    float y;             ///< STEP：新位置 Y
+    uint8_t action;      ///< 决策动作（Action）
+    uint8_t facingLeft;  ///< STEP：新朝向
+};
+
+/**
+ * @struct     BattleStepTimings
+ * @brief      单步各子系统的耗时（微秒）
+ * @details    开启计时（BattleWorld::setProfilingEnabled）后由 step() 写入，未开启时不读取时钟；
+ *             性能分析与基准用，不参与模拟，也不影响状态哈希
+ */
+struct BattleStepTimings {
+    double ai;            ///< 单位 AI：分级规划、寻靶 / 移动 / 攻击、守军
+    double separation;    ///< 兵群分离转向
+    double projectiles;   ///< 弹道飞行与命中
+    double traps;         ///< 陷阱触发
+    double towers;        ///< 防御建筑索敌与开火、兵营释放守军
+    double damage;        ///< 步末伤害结算与胜负判定
+    double total;         ///< 整步耗时
+
+    BattleStepTimings() : ai(0.0), separation(0.0), projectiles(0.0), traps(0.0), towers(0.0), damage(0.0), total(0.0) {}
+};
+
+/**
+ * @class      BattleWorld
+ * @brief      战斗模拟核心
+ * @details    使用流程：loadLevel() 载入布局 -> setReserve() 设置可投放兵力 ->
+ *             deployUnit() 投放士兵 -> 每帧 step(dt) 推进模拟 -> 读取 units()/buildings()/events() 同步表现层。
+ *             兵营被进攻方惊动后逐个释放守军：守军与士兵存放在同一个单位数组中（team 区分阵营），
+ *             但位于单独的空间网格，防御建筑与陷阱只会作用于进攻方；
+ *             双方单位都通过对方网格上的 k 近邻查询选择交战对象，不需要遍历全部单位
+ */
+class BattleWorld
+{
+public:
+    BattleWorld();
+
+    // ==========================================
+    // 初始化与兵力
+    // ==========================================
+
+    /**
+     * @brief      载入关卡布局，清空之前的所有状态
+     * @param      level  关卡描述（建筑、陷阱、禁放区域）
+     */
+    void loadLevel(const BattleLevelDesc& level);
+
+    /**
+     * @brief      设置某兵种剩余可投放数量
+     */
+    void setReserve(SoldierType type, int count);
+
+    /**
+     * @brief      获取某兵种剩余可投放数量
+     */
+    int getReserve(SoldierType type) const;
+
+    /**
+     * @brief      获取所有兵种剩余可投放数量之和（随投放增量维护，O(1)）
+     */
+    int getTotalReserve() const;
+
+    // ==========================================
+    // 玩家操作
+    // ==========================================
+
+    /**
+     * @brief      判定指定位置是否允许投放士兵（不在禁放区域内）
+     * @details    查询载入关卡时烘焙的投放掩码，O(1)
+     * @param      pos  地图节点坐标
+     */
+    bool canDeployAt(const BattleVec2& pos) const;
+
+    /**
+     * @brief      投放一个士兵
+     * @details    校验剩余兵力与投放位置，成功后扣减兵力并生成单位
+     * @return     int  新单位索引；兵力不足、位置非法或战斗已结束时返回 BATTLE_INVALID_INDEX
+     */
+    int deployUnit(SoldierType type, const BattleVec2& pos);
+
+    // ==========================================
+    // 模拟推进
+    // ==========================================
+
+    /**
+     * @brief      推进一次模拟
+     * @details    依次推进：弹道命中 -> 陷阱触发 -> 单位 AI -> 守军 AI -> 兵群分离 -> 防御建筑 -> 兵营释放守军
+     *             -> 伤害结算 -> 胜负判定；
+     *             前四个阶段产生的伤害只记入伤害队列，在伤害结算阶段按实体合并后一次性扣血、摧毁与阵亡，
+     *             因此同一步内各阶段看到的建筑与单位血量都是上一步结束时的值。
+     *             例外：自爆单位在单位 AI 阶段引爆时立即阵亡（离开网格并产生 UNIT_DIED），
+     *             其后的守军、防御建筑阶段不会再以它为目标；单位 AI 阶段按索引推进，攻击方寻敌只查询守军网格，同样不受影响。
+     *             战斗结束后调用无效果；表现层通过 BattleClock 以固定步长调用，结果与帧率无关
+     * @param      dt  时间步长（秒）
+     */
+    void step(float dt);
+
+    // ==========================================
+    // 状态查询
+    // ==========================================
+    const BattleUnitStore& units() const { return _units; }
+    const BattleBuildingStore& buildings() const { return _buildings; }
+    const std::vector<BattleTrapDesc>& traps() const { return _traps; }
+    const std::vector<uint8_t>& trapExploded() const { return _trapExploded; }
+    const BattleProjectilePool& projectiles() const { return _projectiles; }
+    const BattleLevelDesc& level() const { return _level; }
+
+    /// 存活进攻方单位的空间网格（按地面 / 空中分层）
+    const BattleSpatialGrid& unitGrid() const { return _unitGrid; }
+
+    /// 存活守军的空间网格（按地面 / 空中分层）
+    const BattleSpatialGrid& defenderGrid() const { return _defenderGrid; }
+
+    /// 存活建筑的寻靶索引（按建筑类型分桶）
+    const BattleTargetIndex& targetIndex() const { return _targetIndex; }
+
+    /// 陆军寻路的共享流场（按目标建筑缓存）
+    const BattleFlowFieldCache& flowFields() const { return _flowFields; }
+
+    /// 建筑占据栅格（陆军移动阻挡判定）
+    const BattleOccupancyMap& occupancy() const { return _occupancy; }
+
+    /// 投放合法性掩码（由禁止区域烘焙）
+    const BattleDeployMask& deployMask() const { return _deployMask; }
+
+    /// 大本营的建筑索引（无大本营时为 BATTLE_INVALID_INDEX）
+    int getBaseIndex() const { return _baseIndex; }
+
+    /// 当前战斗结果
+    BattleOutcome getOutcome() const { return _outcome; }
+
+    /// 按类别维护的存活计数（建筑类型 / 兵种）
+    const BattleTally& tally() const { return _tally; }
+
+    /// 战场上存活的进攻方单位数量
+    int getAliveUnitCount() const { return _tally.getAliveUnitCount(); }
+
+    /// 战场上存活的守军数量
+    int getAliveDefenderCount() const { return _aliveDefenders; }
+
+    /// 摧毁百分比 [0, 100]（已摧毁的非围墙建筑占比）
+    int getDestructionPercent() const { return _tally.getDestructionPercent(); }
+
+    /// 已推进的模拟总时间（秒）
+    float getElapsedTime() const { return _elapsed; }
+
+    /// 已推进的模拟步数
+    int getStepCount() const { return _steps; }
+
+    /// 单位 AI 调度（分级思考、分帧寻靶）及其计数
+    const BattleAiScheduler& aiScheduler() const { return _ai; }
+
+    /// 兵群分离转向及其计数
+    const BattleCrowdSeparation& crowdSeparation() const { return _separation; }
+
+    /**
+     * @brief      计算当前战斗状态的哈希（FNV-1a）
+     * @details    覆盖单位、建筑、陷阱、飞行中弹道、剩余兵力与战斗结果，浮点按位参与；
+     *             录像按步保存该值，回放时逐步比对以发现分叉
+     */
+    uint32_t computeStateHash() const;
+
+    // ==========================================
+    // 快照
+    // ==========================================
+
+    /**
+     * @brief      截取当前战斗状态的快照
+     * @details    单位、建筑、陷阱与弹道池的可变字段逐段 memcpy 到快照的连续缓冲区；
+     *             快照对象复用时不再分配内存（单位数量只增不减，缓冲区按需增长一次即可）
+     * @param      out   写入的快照
+     * @param      tick  当前已推进的步数（由 BattleClock 提供）
+     */
+    void captureSnapshot(BattleSnapshot& out, int tick) const;
+
+    /**
+     * @brief      恢复到快照中的战斗状态
+     * @details    要求已用同一关卡调用过 loadLevel()；单位、建筑、陷阱与弹道状态原样写回，
+     *             空间网格、寻靶索引、流场、占据栅格与存活计数按快照中的摧毁 / 存活标志重建，
+     *             之后的模拟结果与截取快照时继续推进完全一致。事件队列被清空
+     *             快照可能来自磁盘上的续玩存档，写回前先整体校验兵种与状态枚举、单位 / 建筑 / 弹道槽位索引、
+     *             兵种固有属性与坐标，任何一项不可信都不修改世界
+     * @return     bool  快照无效、与当前关卡的建筑 / 陷阱数量不符或内容越界时返回 false（状态不变）
+     */
+    bool restoreSnapshot(const BattleSnapshot& snapshot);
+
+    /**
+     * @brief      判定地图节点坐标是否被未摧毁的建筑阻挡（陆军寻路用）
+     * @details    查询瓦片占据栅格，O(1)
+     */
+    bool isPositionBlocked(const BattleVec2& pos) const;
+
+    // ==========================================
+    // 事件
+    // ==========================================
+
+    /// 自上次 clearEvents() 以来产生的事件（按发生顺序）
+    const std::vector<BattleEvent>& events() const { return _events; }
+
+    /// 清空事件队列（表现层消费完毕后调用；无表现层的批量模拟可关闭事件记录）
+    void clearEvents() { _events.clear(); }
+
+    /// 开启/关闭事件记录
+    void setEventsEnabled(bool enabled) { _eventsEnabled = enabled; }
+
+    // ==========================================
+    // 并行
+    // ==========================================
+
+    /**
+     * @brief      设置任务系统（不持有）
+     * @details    存活单位不少于 BattleRules::PARALLEL_MIN_UNITS 时，单位的寻靶 / 移动决策与防御建筑的索敌
+     *             交给任务系统并行计算，再按索引顺序应用，结果与单线程逐位一致；传 nullptr 恢复单线程
+     */
+    void setJobSystem(BattleJobSystem* jobs) { _jobs = jobs; }
+
+    /// 当前使用的任务系统（单线程时为 nullptr）
+    BattleJobSystem* getJobSystem() const { return _jobs; }
+
+    // ==========================================
+    // 性能分析
+    // ==========================================
+
+    /// 开启/关闭各子系统计时（默认关闭）
+    void setProfilingEnabled(bool enabled) { _profiling = enabled; }
+
+    /// 最近一步的各子系统耗时（未开启计时时全部为 0）
+    const BattleStepTimings& getStepTimings() const { return _timings; }
+
+private:
+    // 单位 AI
+    void updateUnits(float dt);
+    void thinkUnit(int i, float dt, BattleUnitDecision& out) const;
+    void applyDecision(int i, const BattleUnitDecision& decision, float dt);
+    void updateUnit(int i, float dt);
+    void separateUnits(float dt);
+    bool thinkFoe(int i, float dt, BattleUnitDecision& out) const;
+    BattleSpatialGrid& gridOf(int i);
+    bool plannedDecision(int i, BattleUnitDecision& out) const;
+    int findNearestWall(int i) const;
+    void attackWithUnit(int i, float dt);
+    bool isUnitTouchingBuilding(int i, int b) const;
+
+    // 守军与兵营
+    void updateDefenders(float dt);
+    int findDefenderFoe(int i) const;
+    void moveUnitToward(int i, const BattleVec2& goal, float dt);
+    void updateBarracks(float dt);
+    void releaseDefender(int b);
+
+    // 建筑、陷阱、弹道
+    void updateTowers(float dt);
+    bool isTowerReady(int b, float dt) const;
+    int findTowerTarget(int b) const;
+    void updateTraps();
+    void updateProjectiles(float dt);
+    void fireProjectile(BattleProjectileKind kind, int shooter, const BattleVec2& from,
+        int target, const BattleVec2& to, int damage, float speed);
+
+    // 伤害结算：模拟过程中只记入 _damage，步末由 resolveDamage 统一结算
+    void resolveDamage();
+    void damageBuilding(int b, int damage);
+    void damageUnit(int i, int damage);
+    int damageUnitsInArea(const BattleArea& area, int layers, int damage, int skip);
+    int damageBuildingsInArea(const BattleArea& area, int damage, int skip);
+    void killUnit(int i);
+
+    // 胜负
+    void updateOutcome();
+
+    void emit(BattleEventType type, int a, int b, const BattleVec2& pos);
+
+    BattleLevelDesc _level;                    ///< 当前关卡描述
+    BattleUnitStore _units;                    ///< 单位
+    BattleBuildingStore _buildings;            ///< 建筑
+    std::vector<BattleTrapDesc> _traps;        ///< 陷阱
+    std::vector<uint8_t> _trapExploded;        ///< 陷阱是否已爆炸
+    BattleProjectilePool _projectiles;         ///< 弹道对象池（预分配，命中后回收）
+    std::vector<BattleEvent> _events;          ///< 事件队列
+    BattleSpatialGrid _unitGrid;               ///< 存活进攻方单位的空间网格，单位移动时同步更新
+    BattleSpatialGrid _defenderGrid;           ///< 存活守军的空间网格
+    BattleTargetIndex _targetIndex;            ///< 存活建筑的寻靶索引，建筑摧毁时移出
+    BattleFlowFieldCache _flowFields;          ///< 陆军寻路流场，建筑摧毁时增量更新
+    BattleOccupancyMap _occupancy;             ///< 建筑占据栅格，建筑摧毁时清除对应格子
+    BattleDeployMask _deployMask;              ///< 投放合法性掩码，载入关卡时烘焙
+    BattleTally _tally;                        ///< 存活计数，建筑摧毁与单位投放 / 阵亡时增减
+    BattleDamageQueue _damage;                 ///< 本步累计的伤害，步末统一结算
+    BattleAiScheduler _ai;                     ///< 单位 AI 的分级思考与分帧寻靶
+    BattleCrowdSeparation _separation;         ///< 移动单位之间的分离转向
+
+    int _reserve[BATTLE_SOLDIER_TYPE_COUNT];   ///< 各兵种剩余可投放数量
+    int _totalReserve;                         ///< 剩余可投放数量之和
+    int _baseIndex;                            ///< 大本营索引
+    BattleOutcome _outcome;                    ///< 战斗结果
+    float _elapsed;                            ///< 模拟总时间
+    int _steps;                                ///< 已推进的步数（AI 错峰相位）
+    int _aliveDefenders;                       ///< 存活守军数量
+    bool _eventsEnabled;                       ///< 是否记录事件
+    bool _profiling;                           ///< 是否记录各子系统耗时
+    BattleStepTimings _timings;                ///< 最近一步的各子系统耗时
+
+    BattleJobSystem* _jobs;                    ///< 任务系统（不持有；为空时单线程）
+    std::vector<BattleUnitDecision> _decisions;///< 并行思考阶段的单位决策（按单位索引）
+    std::vector<int> _towerTargets;            ///< 并行索敌阶段的防御建筑目标（按建筑索引）
+    std::vector<int> _areaHits;                ///< 范围效果查询结果（复用）
+};
+
+#endif // BATTLE_WORLD_H_
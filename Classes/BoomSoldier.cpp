@@ -1,5 +1,6 @@
 #include "BoomSoldier.h"  // 引入自爆士兵类的头文件
 #include "BattleScene.h"  // 引入战斗场景类的头文件
+#include "BattleVfxManager.h"  // 引入战斗特效管理器
 
 /**
  * @brief  自爆士兵（BoomSoldier）的初始化函数
@@ -34,14 +35,7 @@ void BoomSoldier::setupProperties(SoldierType type)
         return;  // 纹理初始化失败则直接返回
     }
 
-    // 配置自爆士兵的核心属性值
-    _maxHp = 150;                // 最大生命值
-    _currentHp = _maxHp;         // 当前生命值初始化为最大生命值
-    _attackDamage = 20;          // 自爆伤害（攻击目标时的单次伤害值）
-    _attackRange = 50.0f;        // 攻击范围（自爆士兵为近距离攻击，范围较小）
-    _attackInterval = 1.0f;      // 攻击间隔（自爆为一次性攻击，该参数用于兼容父类逻辑）
-    _moveSpeed = 80.0f;          // 移动速度（像素/秒）
-
+    // 生命、攻击力、射程、移速等数值统一由 BattleRules::unitStats 提供（已在 Soldier::init 中读取 _maxHp）
     // 计算血条每一格对应的伤害值：血条分为5格，每格对应最大生命值的1/5
     _damagePerNotch = _maxHp / 5;
     // 确保每格伤害值不小于1（避免最大生命值过小时出现0值）
@@ -52,34 +46,13 @@ void BoomSoldier::setupProperties(SoldierType type)
 
 /**
  * @brief  播放自爆士兵的行走动画
- * @details 创建并运行循环行走动画，通过动作标签避免重复创建相同动画
+ * @details 运行兵种动画注册表中共享的循环行走动画，动作只在首次使用时创建
  * @note   动画标签101为行走动画的唯一标识，用于后续停止该动画
  */
 void BoomSoldier::playWalkAnim()
 {
-    // 检查是否已存在标签为101的行走动画，若存在则直接返回（避免重复执行）
-    if (this->getActionByTag(101)) {
-        return;
-    }
-
-    // 创建行走动画对象
-    auto animation = Animation::create();
-    // 循环加载行走动画的4帧图片（1~4帧）
-    for (int i = 1; i <= 4; ++i) {
-        // 拼接每帧的图片路径和名称
-        std::string name = StringUtils::format("%s%d.png", WALK_ANIM_BASE.c_str(), i);
-        // 向动画中添加对应帧的精灵帧
-        animation->addSpriteFrameWithFile(name);
-    }
-    // 设置动画每帧的播放间隔（0.15秒/帧）
-    animation->setDelayPerUnit(0.15f);
-
-    // 创建永久重复的行走动画动作（Animate封装动画，RepeatForever实现循环）
-    auto action = RepeatForever::create(Animate::create(animation));
-    // 为行走动画设置唯一标签101，用于后续精准停止该动画
-    action->setTag(101);
-    // 运行行走动画
-    this->runAction(action);
+    // 行走动画帧由 TroopAnimationRegistry 按兵种共享，这里只重新运行缓存的循环动作（标签101）
+    this->runTroopAnim(TroopAnimKind::WALK, 101);
 }
 
 /**
@@ -93,68 +66,18 @@ void BoomSoldier::stopAnim()
 }
 
 /**
- * @brief  自爆士兵攻击目标（敌方建筑）的核心逻辑
- * @details 对目标造成自爆伤害，播放爆炸特效，随后将自身血量置0并停止所有动作
- * @param  target  敌方建筑（EnemyBuilding）的指针，若为nullptr则不执行伤害逻辑
+ * @brief  自爆士兵的自爆特效
+ * @details 对应战斗核心的自爆事件：爆炸范围（BattleRules::BOOM_BLAST_RADIUS）内建筑的伤害结算与自身消亡由 BattleWorld 完成，这里仅播放爆炸特效并停止自身动作
+ * @param  vfx  战斗特效管理器，爆炸动画与精灵由其缓存复用
+ * @note   士兵精灵随后会在死亡事件中由 BattleScene 移除
  */
-void BoomSoldier::attackTarget(EnemyBuilding* target)
+void BoomSoldier::playExplodeEffect(BattleVfxManager* vfx)
 {
-    // 1. 对目标造成自爆伤害
-    if (target) {
-        // 调用敌方建筑的受伤害函数，传递自爆士兵的攻击伤害值
-        target->takeDamage(this->_attackDamage);
+    // 在自爆士兵当前位置播放共享的爆炸动画（放大 3 倍，与原特效一致）
+    if (vfx) {
+        vfx->playExplosion(this->getPosition(), 3.0f);
     }
 
-    // ==================== 播放自爆爆炸特效 ====================
-    // 确保当前士兵存在父节点（战斗场景节点），避免空指针异常
-    if (this->getParent())
-    {
-        // 创建爆炸特效的精灵对象（初始为空，后续通过帧动画填充内容）
-        auto explosion = Sprite::create();
-        // 设置爆炸特效的位置为自爆士兵当前的位置
-        explosion->setPosition(this->getPosition());
-        // 放大爆炸特效（缩放比例3.0f，增强视觉效果）
-        explosion->setScale(3.0f);
-
-        // 将爆炸特效添加到父节点（战斗场景），并设置渲染层级（高于士兵本身，确保特效在顶层显示）
-        this->getParent()->addChild(explosion, this->getLocalZOrder() + 10);
-
-        // 收集爆炸特效的所有精灵帧（1~9帧）
-        Vector<SpriteFrame*> animFrames;
-        char str[100] = { 0 };  // 用于拼接爆炸特效图片路径的字符数组
-        for (int i = 1; i <= 9; ++i) {
-            // 拼接爆炸特效图片路径：soldiers/Explosion1.png ~ soldiers/Explosion9.png
-            sprintf(str, "soldiers/Explosion%d.png", i);
-            // 创建对应帧的精灵对象，用于获取精灵帧
-            auto sprite = Sprite::create(str);
-            // 确保精灵创建成功，避免空指针添加到帧集合
-            if (sprite) {
-                animFrames.pushBack(sprite->getSpriteFrame());
-            }
-        }
-
-        // 创建爆炸动画（使用收集到的精灵帧，每帧播放间隔0.1秒）
-        auto animation = Animation::createWithSpriteFrames(animFrames, 0.1f);
-        // 创建爆炸特效的序列动作：播放动画 -> 播放完毕后自动移除特效精灵
-        auto seq = Sequence::create(
-            Animate::create(animation),  // 播放爆炸动画
-            RemoveSelf::create(),        // 动画结束后自动从父节点移除自身，避免内存泄漏
-            nullptr                      // 序列动作结束标记
-        );
-        // 运行爆炸特效的序列动作
-        explosion->runAction(seq);
-    }
-    // ============================================================
-
-    // 2. 停止自爆士兵的所有定时器回调（如攻击间隔定时器、移动定时器等）
-    this->unscheduleAllCallbacks();
     // 停止自爆士兵的所有动作（如行走动画等）
     this->stopAllActions();
-
-    // 3. 将自身当前血量置0，标记士兵已自爆消亡
-    // 注：BattleScene会在下一帧检测士兵血量<=0时，自动移除该士兵对象
-    this->_currentHp = 0;
-
-    // 4. 更新血条显示（血条会根据当前血量0，显示为空血状态）
-    this->updateHealthBar();
-}
\ No newline at end of file
+}
@@ -15,7 +15,7 @@
   * @class      BoomSoldier
   * @brief      自爆士兵类，实现自爆攻击的核心逻辑
   * @details    继承自 Soldier 基类，重写了基类的虚函数，主要扩展了自爆特效播放、一次性攻击后自身消亡的逻辑，
-  *             包含行走动画配置、自爆攻击、属性初始化等核心功能
+  *             包含行走动画配置、自爆特效、属性初始化等核心功能
   * @extends    Soldier
   * @note       该类为具体业务类，不支持进一步继承（若需继承可将私有成员改为保护成员）
   */
@@ -44,7 +44,7 @@ protected:
 
     /**
      * @brief      播放自爆士兵的行走动画（重写父类虚函数）
-     * @details    创建并运行循环行走动画，通过动作标签避免重复创建相同动画，动画帧来源于预定义的基础路径
+     * @details    运行兵种动画注册表中共享的循环行走动画，动作只创建一次，通过动作标签避免重复运行
      * @override   Soldier::playWalkAnim
      */
     virtual void playWalkAnim() override;
@@ -57,19 +57,19 @@ protected:
     virtual void stopAnim() override;
 
     /**
-     * @brief      自爆士兵攻击目标的核心逻辑（重写父类虚函数）
-     * @details    实现自爆攻击的完整流程：对敌方建筑造成伤害 -> 播放爆炸特效 -> 停止自身所有动作和定时器 ->
-     *             将自身血量置0 -> 更新血条，最终由战斗场景检测到血量为0后移除该士兵实例
-     * @param      target       敌方建筑指针（EnemyBuilding*），指向被攻击的目标建筑，若为 nullptr 则不执行伤害逻辑
-     * @override   Soldier::attackTarget
+     * @brief      自爆士兵的自爆特效（重写父类虚函数）
+     * @details    通过特效管理器播放爆炸帧动画并停止自身所有动作；对目标的伤害与自身消亡由战斗核心结算，
+     *             随后战斗场景在处理单位死亡事件时移除该士兵实例
+     * @param      vfx  战斗特效管理器
+     * @override   Soldier::playExplodeEffect
      */
-    virtual void attackTarget(EnemyBuilding* target) override;
+    virtual void playExplodeEffect(BattleVfxManager* vfx) override;
 
 private:
     /**
      * @brief      行走动画的基础路径常量
      * @details    自爆士兵行走动画帧的文件路径前缀，动画帧文件命名格式为 "anim/boom1.png" ~ "anim/boom4.png"，
-     *             该常量用于拼接完整的动画帧文件路径，方便加载行走动画
+     *             该常量用于拼接初始纹理（第一帧）路径；行走动画帧登记在 TroopAnimationRegistry 的兵种动画表中
      */
     const std::string WALK_ANIM_BASE = "anim/boom";
 };
@@ -4,14 +4,17 @@
 #include"SharedData.h"
 #include "cocos2d.h"
 class Soldier;
+class BattleVfxManager;
 class EnemyBuilding : public cocos2d::Sprite
 {
 public:
     void setHealthBarScale(float s);
     static EnemyBuilding* create(const std::string& filename, const std::string& hpBarFilename, int totalHp, int damagePerNotch, int attack, float range);
     virtual bool init(const std::string& filename, const std::string& hpBarFilename, int totalHp, int damagePerNotch, int attack, float range);
-    void updateTowerLogic(float dt, const cocos2d::Vector<Soldier*>& soldiers);
-    void takeDamage(int damage);
+    //从战斗核心同步血量，血量变化时刷新血条
+    void syncHp(int hp);
+    //被摧毁时的表现：爆炸（由特效管理器播放）、变灰、隐藏血条
+    void playDestroyedEffect(BattleVfxManager* vfx);
 
     //获取当前血量值
     int getCurrentHp() const 
@@ -38,9 +41,33 @@ public:
     { 
         _type = type; 
     }
+    //获取最大血量
+    int getMaxHp() const
+    {
+        return _maxHp;
+    }
+    //获取攻击力
+    int getAttack() const
+    {
+        return _attackPower;
+    }
+    //获取攻击范围
+    float getRange() const
+    {
+        return _attackRange;
+    }
+    //绑定战斗核心中的建筑索引
+    void setBuildingIndex(int index)
+    {
+        _buildingIndex = index;
+    }
+    //获取战斗核心中的建筑索引
+    int getBuildingIndex() const
+    {
+        return _buildingIndex;
+    }
 
 private:
-    void fireMissile(Soldier* target);
     //当前血量
     int _currentHp;      
     //最大血量
@@ -51,17 +78,14 @@ private:
     int _attackPower;     
     //攻击范围
     float _attackRange;  
-    //攻击间隔
-    float _attackCooldown;  
-    //计时器，等待下一次攻击的时间
-    float _attackTimer;     
+    //战斗核心中的建筑索引
+    int _buildingIndex = -1;
     //摧毁标志
     bool _isDestroyed;
     //创建一个血条对象
     cocos2d::Sprite* _healthBar; 
 
     void updateHealthBar();
-    void playExplosionEffect();
     //初始化建筑类别
     EnemyType _type = EnemyType::TOWER; 
 };
@@ -3,6 +3,7 @@
 #include "HelloWorldScene.h"
 #include "BuildingInfoLayer.h"
 #include "BattleScene.h"
+#include "BattleJobSystem.h"
 #include "Building.h" 
 #include "ShopScene.h"
 #include "SaveGame.h"
@@ -257,6 +258,10 @@ void GameScene::initUIButtons()
                 this->addShopButton();
                 // 添加保存按钮
                 this->addSaveButton();
+                // 存在被中断的战斗时添加继续战斗按钮
+                this->addResumeBattleButton();
+                // 添加布局优化按钮
+                this->addOptimizeLayoutButton();
 
                 // 创建返回按钮（带云保存功能）
                 if (g_currentUsername != "LocalPlayer")
@@ -1226,6 +1231,199 @@ void GameScene::addSaveButton()
     this->addChild(save_menu, 200);
 }
 
+// 添加继续战斗按钮函数
+void GameScene::addResumeBattleButton()
+{
+    // 没有续玩存档（上一场战斗已正常结束或主动退出）时不显示
+    if (!BattleScene::hasCheckpoint())
+    {
+        return;
+    }
+    const auto visible_size = Director::getInstance()->getVisibleSize();
+    const Vec2 origin = Director::getInstance()->getVisibleOrigin();
+
+    // 创建继续战斗按钮标签
+    auto resume_label = Label::createWithTTF("RESUME BATTLE", "fonts/Marker Felt.ttf", 28);
+    resume_label->setColor(Color3B::ORANGE);
+    resume_label->enableOutline(Color4B::BLACK, 2);
+
+    // 创建继续战斗按钮菜单项，从续玩存档恢复被中断的战斗
+    auto resume_item = MenuItemLabel::create(resume_label, [=](Ref* p_sender)
+        {
+            auto scene = BattleScene::createResumeScene(BattleScene::getCheckpointPath());
+            if (!scene)
+            {
+                // 存档损坏，删除后不再显示按钮
+                FileUtils::getInstance()->removeFile(BattleScene::getCheckpointPath());
+                static_cast<Node*>(p_sender)->removeFromParent();
+                this->showToast("Battle checkpoint is damaged!", Color3B::RED);
+                return;
+            }
+            Director::getInstance()->replaceScene(TransitionFade::create(0.5f, scene));
+        });
+
+    // 设置按钮位置（保存按钮上方）
+    resume_item->setPosition(Vec2(origin.x + visible_size.width - 150, origin.y + 180));
+
+    // 创建菜单并添加按钮
+    auto resume_menu = Menu::create(resume_item, NULL);
+    resume_menu->setPosition(Vec2::ZERO);
+    this->addChild(resume_menu, 200);
+}
+
+// 添加布局优化按钮函数
+void GameScene::addOptimizeLayoutButton()
+{
+    const auto visible_size = Director::getInstance()->getVisibleSize();
+    const Vec2 origin = Director::getInstance()->getVisibleOrigin();
+
+    // 创建布局优化按钮标签
+    auto optimize_label = Label::createWithTTF("OPTIMIZE LAYOUT", "fonts/Marker Felt.ttf", 28);
+    optimize_label->setColor(Color3B(120, 200, 255));
+    optimize_label->enableOutline(Color4B::BLACK, 2);
+
+    // 创建布局优化按钮菜单项
+    auto optimize_item = MenuItemLabel::create(optimize_label, [=](Ref* p_sender)
+        {
+            this->startLayoutOptimization();
+        });
+
+    // 设置按钮位置（继续战斗按钮上方）
+    optimize_item->setPosition(Vec2(origin.x + visible_size.width - 150, origin.y + 260));
+
+    // 创建菜单并添加按钮
+    auto optimize_menu = Menu::create(optimize_item, NULL);
+    optimize_menu->setPosition(Vec2::ZERO);
+    this->addChild(optimize_menu, 200);
+}
+
+// 开始优化防御布局函数
+void GameScene::startLayoutOptimization()
+{
+    if (layout_optimizer_ && layout_optimizer_->isRunning())
+    {
+        this->showToast("Still optimizing...", Color3B::YELLOW);
+        return;
+    }
+
+    // 和进攻自己的基地一样，用存档数据解析出PVP关卡（只解析，不进入战斗）
+    std::string pvp_data = SaveGame::getInstance()->getGameStateAsJsonString();
+    BattleLevelDesc level;
+    if (!BattleScene::describeLevel(0, pvp_data, level))
+    {
+        this->showToast("No buildings to optimize!", Color3B::RED);
+        return;
+    }
+
+    // 关卡中的建筑按存档顺序创建（跳过无法识别的类型），按顺序对应回家园中的建筑
+    layout_buildings_.clear();
+    layout_origins_.clear();
+    std::vector<BattleRect> collisions;
+    for (auto building : g_allPurchasedBuildings)
+    {
+        size_t index = layout_buildings_.size();
+        if (!building || index >= level.buildings.size())
+            continue;
+        const BattleBuildingDesc& desc = level.buildings[index];
+        if (static_cast<int>(desc.type) != static_cast<int>(building->getType()) ||
+            desc.position.x != building->getPositionX() || desc.position.y != building->getPositionY())
+            continue;
+
+        // 碰撞矩形取家园中的包围盒，与checkCollision一致
+        Rect box = building->getBoundingBox();
+        collisions.push_back(BattleRect(box.origin.x, box.origin.y, box.size.width, box.size.height));
+        layout_buildings_.push_back(building);
+        layout_origins_.push_back(building->getPosition());
+    }
+    if (layout_buildings_.size() != level.buildings.size())
+    {
+        this->showToast("Layout is not ready, try again later!", Color3B::RED);
+        return;
+    }
+
+    // 装饰物等其余障碍物保持不动
+    std::vector<BattleRect> obstacles;
+    for (auto node : obstacles_)
+    {
+        if (!node || !node->getParent())
+            continue;
+        if (std::find(layout_buildings_.begin(), layout_buildings_.end(), node) != layout_buildings_.end())
+            continue;
+        Rect box = node->getBoundingBox();
+        obstacles.push_back(BattleRect(box.origin.x, box.origin.y, box.size.width, box.size.height));
+    }
+    const Size map_size = tiled_map_->getContentSize();
+    BattleRect bounds(0.0f, 0.0f, map_size.width, map_size.height);
+
+    std::vector<BattleLayoutAttack> attacks;
+    BattleLayoutOptimizer::makeStandardAttacks(level, attacks);
+
+    if (!layout_optimizer_)
+        layout_optimizer_.reset(new BattleLayoutOptimizer());
+    if (!layout_optimizer_->start(level, collisions, obstacles, bounds, attacks, BattleJobSystem::getInstance()))
+    {
+        this->showToast("No buildings to optimize!", Color3B::RED);
+        return;
+    }
+    this->showToast("Simulating attacks on your base...", Color3B::WHITE);
+    this->schedule(CC_CALLBACK_1(GameScene::updateLayoutOptimization, this), 0.1f, "layout_optimizer_key");
+}
+
+// 轮询布局优化进度函数
+void GameScene::updateLayoutOptimization(float dt)
+{
+    if (!layout_optimizer_ || !layout_optimizer_->isFinished())
+        return;
+    this->unschedule("layout_optimizer_key");
+    this->applyLayoutSuggestion(layout_optimizer_->getResult());
+}
+
+// 应用优化给出的布局函数
+void GameScene::applyLayoutSuggestion(const BattleLayoutResult& result)
+{
+    if (!result.improved || result.positions.size() != layout_buildings_.size())
+    {
+        this->showToast("Your layout is already strong!", Color3B::GREEN);
+        return;
+    }
+
+    // 优化期间建筑被移动或出售时放弃本次建议
+    for (size_t i = 0; i < layout_buildings_.size(); ++i)
+    {
+        Building* building = layout_buildings_[i];
+        if (!g_allPurchasedBuildings.contains(building) || !building->getPosition().equals(layout_origins_[i]))
+        {
+            this->showToast("Layout changed, please optimize again!", Color3B::RED);
+            return;
+        }
+    }
+
+    // 先整体移动，再用checkCollision复核被移动的建筑，任何一个碰撞就整体还原
+    for (size_t i = 0; i < layout_buildings_.size(); ++i)
+    {
+        layout_buildings_[i]->setPosition(Vec2(result.positions[i].x, result.positions[i].y));
+    }
+    for (size_t i = 0; i < layout_buildings_.size(); ++i)
+    {
+        Building* building = layout_buildings_[i];
+        if (building->getPosition().equals(layout_origins_[i]))
+            continue;
+        if (this->checkCollision(building->getBoundingBox(), building))
+        {
+            for (size_t j = 0; j < layout_buildings_.size(); ++j)
+            {
+                layout_buildings_[j]->setPosition(layout_origins_[j]);
+            }
+            this->showToast("Suggested layout does not fit!", Color3B::RED);
+            return;
+        }
+    }
+
+    this->showToast(StringUtils::format("Layout optimized!\nDestruction %.0f%% -> %.0f%%, attacks won %.0f%% -> %.0f%%",
+        result.baselineDestruction, result.bestDestruction,
+        result.baselineWinRate * 100.0f, result.bestWinRate * 100.0f), Color3B::GREEN);
+}
+
 // 保存游戏回调函数
 void GameScene::menuSaveGameCallback(Ref* p_sender)
 {
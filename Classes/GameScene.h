@@ -2,7 +2,10 @@
 #define GAME_SCENE_H_
 
 #include "cocos2d.h"
+#include <memory>
+#include <vector>
 #include"Building.h"
+#include "BattleLayoutOptimizer.h"
 
 // 全局变量声明：所有已购买的建筑容器
 extern cocos2d::Vector<Building*> g_allPurchasedBuildings;
@@ -33,6 +36,13 @@ private:
     // 地图拖动标志
     bool is_map_dragging_;
 
+    // 防御布局优化器（后台运行）
+    std::unique_ptr<BattleLayoutOptimizer> layout_optimizer_;
+    // 参与优化的建筑（下标与关卡描述中的建筑一致）
+    std::vector<Building*> layout_buildings_;
+    // 优化开始时各建筑的位置，用于判断优化期间布局是否被改动
+    std::vector<cocos2d::Vec2> layout_origins_;
+
     // init()函数的辅助函数
     bool loadMap();                     // 加载地图
     void loadMapDecorations();          // 加载地图装饰物
@@ -47,6 +57,16 @@ public:
     void addSaveButton();
     // 保存游戏回调
     void menuSaveGameCallback(Ref* p_sender);
+    // 添加继续战斗按钮（存在续玩存档时显示）
+    void addResumeBattleButton();
+    // 添加布局优化按钮
+    void addOptimizeLayoutButton();
+    // 开始优化防御布局
+    void startLayoutOptimization();
+    // 轮询布局优化进度
+    void updateLayoutOptimization(float dt);
+    // 应用优化给出的布局
+    void applyLayoutSuggestion(const BattleLayoutResult& result);
 
     // 障碍物容器
     cocos2d::Vector<Node*> obstacles_;
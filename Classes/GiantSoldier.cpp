@@ -7,7 +7,7 @@
  * @version    1.0
  * @note       该类依赖 Cocos2d-x 引擎的 Animation、StringUtils 等组件；
  *             行走动画资源路径为 "anim/giant1.png" ~ "anim/giant4.png"，需确保资源文件存在于 Resources 目录下；
- *             巨人士兵暂使用父类默认近战攻击逻辑，若需自定义可扩展 attackTarget 函数
+ *             巨人士兵暂使用父类默认近战攻击逻辑，若需自定义可扩展 playAttackEffect 函数
  */
 #include "GiantSoldier.h"
 #include "BattleScene.h"
@@ -49,14 +49,7 @@ void GiantSoldier::setupProperties(SoldierType type)
     // 拼接行走动画基础路径与第一帧序号，加载初始纹理，加载失败则直接返回
     if (!this->initWithFile(StringUtils::format("%s%d.png", WALK_ANIM_BASE.c_str(), 1))) return;
 
-    // 配置巨人士兵的核心属性值（肉盾近战单位专属配置：高生命值、低攻击力）
-    _maxHp = 100;                // 最大生命值（远高于其他士兵，适配肉盾定位）
-    _currentHp = _maxHp;         // 当前生命值初始化为最大生命值
-    _attackDamage = 3;           // 近战攻击伤害值（肉盾单位侧重抗伤，攻击力较低）
-    _attackRange = 80.0f;        // 近战攻击范围
-    _attackInterval = 1.0f;      // 攻击间隔（每秒1次近战攻击）
-    _moveSpeed = 80.0f;          // 地面行走移动速度（像素/秒）
-
+    // 生命、攻击力、射程、移速等数值统一由 BattleRules::unitStats 提供（已在 Soldier::init 中读取 _maxHp）
     // 计算血条每一格对应的伤害值
     const int NOTCH_COUNT = 5;   // 血条总格数（常量定义，便于后续修改维护）
     _damagePerNotch = _maxHp / NOTCH_COUNT;
@@ -66,33 +59,15 @@ void GiantSoldier::setupProperties(SoldierType type)
 
 /**
  * @brief      播放巨人士兵的行走动画（重写父类纯虚函数）
- * @details    1.  通过动作标签101判断是否已存在行走动画，避免重复创建与运行；
- *             2.  加载4帧行走动画纹理，设置每帧播放间隔，创建永久循环动画；
- *             3.  为动画设置专属标签101，用于后续精准停止动画
+ * @details    运行兵种动画注册表中共享的4帧行走动画（giant1.png ~ giant4.png），
+ *             循环动作首次使用时创建并由士兵持有，之后状态切换不再加载任何帧；
+ *             动作绑定专属标签101，用于后续精准停止动画
  * @override   Soldier::playWalkAnim
  */
 void GiantSoldier::playWalkAnim()
 {
-    // 检查标签101对应的行走动画是否已存在，存在则直接返回
-    if (this->getActionByTag(101)) return;
-
-    // 创建行走动画对象
-    auto animation = Animation::create();
-    // 循环加载4帧行走动画纹理（giant1.png ~ giant4.png）
-    for (int i = 1; i <= 4; ++i) {
-        // 拼接每帧纹理的完整路径
-        std::string name = StringUtils::format("%s%d.png", WALK_ANIM_BASE.c_str(), i);
-        // 向动画对象中添加对应精灵帧
-        animation->addSpriteFrameWithFile(name);
-    }
-
-    // 设置动画每帧播放间隔（0.15秒/帧，适配巨人士兵庞大体型的行走视觉效果）
-    animation->setDelayPerUnit(0.15f);
-
-    // 创建永久循环的行走动画动作，并设置标签101
-    auto action = RepeatForever::create(Animate::create(animation));
-    action->setTag(101);
-    this->runAction(action);
+    // 行走动画帧由 TroopAnimationRegistry 按兵种共享，这里只重新运行缓存的循环动作（标签101）
+    this->runTroopAnim(TroopAnimKind::WALK, 101);
 }
 
 /**
@@ -6,7 +6,7 @@
  *             具备更高的生命值和抗伤能力，通过私有常量指定专属行走动画路径
  * @version    1.0
  * @note       该类依赖 Soldier 基类和 BattleScene 相关头文件，使用前需确保依赖文件已正确引入；
- *             巨人士兵的近战攻击逻辑暂使用父类默认实现（若需自定义可扩展 attackTarget 函数）
+ *             巨人士兵的近战攻击逻辑暂使用父类默认实现（若需自定义可扩展 playAttackEffect 函数）
  */
 #ifndef GIANT_SOLDIER_H_
 #define GIANT_SOLDIER_H_
@@ -20,7 +20,7 @@
   *             作为地面近战单位，行走动画依赖私有常量指定的纹理路径，适配其庞大体型的移动视觉效果
   * @extends    Soldier
   * @note       该类保护成员可被子类继承扩展，私有成员为行走动画基础路径，仅内部可访问；
-  *             若需实现专属近战攻击逻辑，可在 cpp 文件中重写 attackTarget 函数
+  *             若需实现专属近战攻击逻辑，可在 cpp 文件中重写 playAttackEffect 函数
   */
 class GiantSoldier : public Soldier
 {
@@ -48,8 +48,8 @@ protected:
 
     /**
      * @brief      播放巨人士兵的行走动画（重写父类纯虚函数）
-     * @details    根据私有常量指定的行走动画基础路径，加载并运行循环行走动画，
-     *             通过动作标签避免重复创建相同动画实例，适配巨人士兵庞大体型的移动特性
+     * @details    运行兵种动画注册表中共享的循环行走动画，
+     *             动作只创建一次并由士兵持有，通过动作标签避免重复运行，适配巨人士兵庞大体型的移动特性
      * @override   Soldier::playWalkAnim
      */
     virtual void playWalkAnim() override;
@@ -66,7 +66,7 @@ private:
     /**
      * @brief      巨人士兵行走动画的基础路径常量
      * @details    巨人士兵行走动画帧的文件路径前缀，动画帧文件命名格式为 "anim/giant1.png" ~ "anim/giantN.png"（N为动画帧总数），
-     *             该常量用于拼接完整的动画帧文件路径，方便加载专属行走动画纹理
+     *             该常量用于拼接初始纹理（第一帧）路径；行走动画帧登记在 TroopAnimationRegistry 的兵种动画表中
      */
     const std::string WALK_ANIM_BASE = "anim/giant";
 };
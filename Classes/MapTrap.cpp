@@ -1,4 +1,5 @@
 #include "MapTrap.h"
+#include "BattleVfxManager.h"
 
 USING_NS_CC;
 
@@ -21,106 +22,37 @@ bool MapTrap::init(const Rect& area, int damage1)
     trapArea = area;     //ʼը
     damage = damage1;    //ʼ˺ֵ
     isExploded = false;  //ʼΪûը
+    trapIndex = -1;      //δս
 
     return true;
 }
 
-bool MapTrap::checkTrigger(const Vector<Soldier*>& soldiers)
-{
-    if (isExploded) 
-        return false;
-
-    // лŵʿ
-    for (auto soldier : soldiers) {
-        if (soldier && soldier->getCurrentHp() > 0) {
-
-            // жʿλõ㣬Ƿ
-            // getPosition() ʿߵͼ꣬ȡĲ㼶ṹ
-            //  Soldier  MapTrap  _tileMap ϣϵһ
-            if (soldier->getSoldierType() == SoldierType::AIRFORCE) {
-                continue;      //ձֲըӰ
-            }
-            if (trapArea.containsPoint(soldier->getPosition())) {
-
-                this->explode(soldiers); // ը
-                return true;
-            }
-        }
-    }
-    return false;
-}
-
-void MapTrap::explode(const Vector<Soldier*>& soldiers)
+void MapTrap::playExplosionEffect(BattleVfxManager* vfx)
 {
+    if (isExploded)    //Ѿը
+        return;
     isExploded = true;
 
-    // űըЧ
-    this->playExplosionEffect();
-
-    // ɷΧ˺ (ڵʿѪ)
-    for (auto soldier : soldiers) {
-        if (soldier && soldier->getCurrentHp() > 0) {
-            if (soldier->getSoldierType() == SoldierType::AIRFORCE) {
-                continue;          //ձֲըӰ
-            }
-            if (trapArea.containsPoint(soldier->getPosition())) {
-                soldier->takeDamage(damage);     //ʿ˺ĺ
-            }
-        }
-    }
-}
-
-void MapTrap::playExplosionEffect()
-{
-    // ը Sprite
-    auto explosion = Sprite::create();
-    // 
-    explosion->setPosition(trapArea.origin + trapArea.size / 2);
-    explosion->setScale(3.0f); 
-    // Ч TileMap 
     Node* mapNode = this->getParent();
-    if (mapNode) { 
-        mapNode->addChild(explosion, 999); // ըЧϲ
-    }
-    // ض֡EnemyBUilding߼
-    Vector<SpriteFrame*> frames;
-    char str[100] = { 0 };
-    for (int i = 1; i <= 9; i++) {     //ȡűըͼƬ
-        sprintf(str, "soldiers/Explosion%d.png", i);
-        auto sp = Sprite::create(str);
-        if (sp) 
-            frames.pushBack(sp->getSpriteFrame());   //ѶȡͼƬŽ׼γɶ
-    }
-
-    if (!frames.empty()) {
-        auto anim = Animation::createWithSpriteFrames(frames, 0.1f);  //׼ը屬ըٶ0.1
-
-        auto leaveCraterFunc = CallFunc::create([mapNode, this]() {  //Lambdaʽǰը͵ͼ
-            // ȷͼ
-            if (!mapNode) 
-                return;
-
-            // ͼƬ֪ը
-            auto crater = Sprite::create("soldiers/Bomb.png");
-
-            if (crater) {
-                // úλһ
-                crater->setPosition(trapArea.origin + trapArea.size / 2);
-
-                crater->setOpacity(200); // ΢͸
-                crater->setScale(5.0f); 
-                crater->getTexture()->setAliasTexParameters();
-                mapNode->addChild(crater, 100);  //ӵͼΪӽڵ
-
-            }
-        });
+    Vec2 center = trapArea.origin + trapArea.size / 2;   // 
+
+    // ըµӣ֪ըˣЧع߱ʱҲµӣ
+    auto leaveCrater = [mapNode, center]() {
+        if (!mapNode)
+            return;
+        auto crater = Sprite::create("soldiers/Bomb.png");
+        if (crater) {
+            crater->setPosition(center);   // úλһ
+            crater->setOpacity(200);       // ΢͸
+            crater->setScale(5.0f);
+            crater->getTexture()->setAliasTexParameters();
+            mapNode->addChild(crater, 100);  //ӵͼΪӽڵ
+        }
+    };
 
-        // ը  -> ɵ -> ƳըЧ
-        explosion->runAction(Sequence::create(
-            Animate::create(anim),
-            leaveCraterFunc,       // صըʾ
-            RemoveSelf::create(),  // ƳըЧ
-            nullptr
-        ));
-    }
+    // ը뾫Ч渴ãصֻͼڵ꣬ٲ
+    if (vfx)
+        vfx->playExplosion(center, 3.0f, leaveCrater);
+    else
+        leaveCrater();
 }
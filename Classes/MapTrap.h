@@ -2,7 +2,8 @@
 #define MAP_TRAP_H_
 
 #include "cocos2d.h"
-#include "Soldier.h"
+
+class BattleVfxManager;
 
 class MapTrap : public cocos2d::Node // ̳ Node  SpriteΪƽʱε
 {
@@ -12,16 +13,22 @@ public:
     //ʼ
     bool init(const cocos2d::Rect& area, int damage);
 
-    // ⴥʿжû˲
-    bool checkTrigger(const cocos2d::Vector<Soldier*>& soldiers);
+    // ж뷶Χ˺ս BattleWorld ֻṩؿҪ
+    const cocos2d::Rect& getArea() const { return trapArea; }
+    int getDamage() const { return damage; }
+
+    // սе
+    void setTrapIndex(int index) { trapIndex = index; }
+    int getTrapIndex() const { return trapIndex; }
+
+    // յĵ屬ը¼ãЧűըµӣֻᲥһΣ
+    void playExplosionEffect(BattleVfxManager* vfx);
 
 private:
     cocos2d::Rect trapArea; // Чľ
     int damage;             // ˺ֵ
     bool isExploded;        // ǷѾը
-
-    void explode(const cocos2d::Vector<Soldier*>& soldiers); // ը߼
-    void playExplosionEffect(); // Ч
+    int trapIndex;          // սе
 };
 
 #endif
\ No newline at end of file
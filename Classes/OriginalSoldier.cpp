@@ -47,14 +47,7 @@ void OriginalSoldier::setupProperties(SoldierType type)
     // 拼接行走动画基础路径与第一帧序号，加载初始纹理，加载失败则直接返回
     if (!this->initWithFile(StringUtils::format("%s%d.png", WALK_ANIM_BASE.c_str(), 1))) return;
 
-    // 配置原始士兵核心属性（均衡值，无特殊偏向，贴合基础步兵定位）
-    _maxHp = 75;                // 最大生命值（基础均衡值）
-    _currentHp = _maxHp;         // 当前生命值初始化为最大生命值
-    _attackDamage = 4;          // 近战攻击伤害值（基础均衡值）
-    _attackRange = 80.0f;       // 近战攻击范围（与其他近战士兵保持一致）
-    _attackInterval = 1.0f;     // 攻击间隔（每秒1次，通用近战配置）
-    _moveSpeed = 80.0f;         // 地面行走移动速度（基础均衡值，像素/秒）
-
+    // 生命、攻击力、射程、移速等数值统一由 BattleRules::unitStats 提供（已在 Soldier::init 中读取 _maxHp）
     // 计算血条每一格对应的伤害值（血条固定分为5格）
     _damagePerNotch = _maxHp / 5;
     // 保底处理：确保每格伤害值不小于1，避免低生命值时血条显示异常
@@ -63,33 +56,15 @@ void OriginalSoldier::setupProperties(SoldierType type)
 
 /**
  * @brief      播放原始士兵的行走动画（重写父类虚函数）
- * @details    1.  通过动作标签101判断动画是否已存在，避免重复创建与运行，节省系统资源；
- *             2.  加载4帧行走动画纹理，设置合理播放间隔，适配基础步兵行走节奏；
- *             3.  创建永久循环动作并绑定标签101，用于后续精准停止动画。
+ * @details    运行兵种动画注册表中共享的4帧行走动画（man1.png ~ man4.png，0.15秒/帧），
+ *             循环动作首次使用时创建并由士兵持有，之后状态切换不再加载任何帧；
+ *             动作绑定标签101，用于后续精准停止动画。
  * @override   Soldier::playWalkAnim
  */
 void OriginalSoldier::playWalkAnim()
 {
-    // 检查标签101对应的行走动画是否已存在，存在则直接返回
-    if (this->getActionByTag(101)) return;
-
-    // 创建行走动画对象
-    auto animation = Animation::create();
-    // 循环加载4帧行走动画纹理（man1.png ~ man4.png）
-    for (int i = 1; i <= 4; ++i) {
-        // 拼接每帧纹理的完整路径
-        std::string name = StringUtils::format("%s%d.png", WALK_ANIM_BASE.c_str(), i);
-        // 向动画对象中添加对应精灵帧
-        animation->addSpriteFrameWithFile(name);
-    }
-
-    // 设置动画每帧播放间隔（0.15秒/帧，适配基础步兵行走视觉效果）
-    animation->setDelayPerUnit(0.15f);
-
-    // 创建永久循环行走动画，并绑定专属标签101
-    auto action = RepeatForever::create(Animate::create(animation));
-    action->setTag(101);
-    this->runAction(action);
+    // 行走动画帧由 TroopAnimationRegistry 按兵种共享，这里只重新运行缓存的循环动作（标签101）
+    this->runTroopAnim(TroopAnimKind::WALK, 101);
 }
 
 /**
@@ -6,7 +6,7 @@
  *             具备均衡的各项属性，无特殊差异化能力，是其他特种士兵的基础模板
  * @version    1.0
  * @note       该类依赖 Soldier 基类和 BattleScene 相关头文件，使用前需确保依赖文件已正确引入；
- *             原始士兵暂使用父类默认近战攻击逻辑，若需自定义攻击特效可扩展 attackTarget 函数
+ *             原始士兵暂使用父类默认近战攻击逻辑，若需自定义攻击特效可扩展 playAttackEffect 函数
  */
 #ifndef ORIGINAL_SOLDIER_H_
 #define ORIGINAL_SOLDIER_H_
@@ -21,7 +21,7 @@
   *             的基础参考模板
   * @extends    Soldier
   * @note       该类保护成员可被子类继承扩展，私有成员为行走动画基础路径，仅内部可访问；
-  *             若需实现专属攻击逻辑，可在 cpp 文件中重写 attackTarget 函数
+  *             若需实现专属攻击逻辑，可在 cpp 文件中重写 playAttackEffect 函数
   */
 class OriginalSoldier : public Soldier
 {
@@ -49,8 +49,8 @@ protected:
 
     /**
      * @brief      播放原始士兵的行走动画（重写父类虚函数）
-     * @details    根据私有常量指定的行走动画基础路径，加载并运行循环行走动画，
-     *             通过动作标签避免重复创建相同动画实例，适配基础步兵的地面移动特性
+     * @details    运行兵种动画注册表中共享的循环行走动画，
+     *             动作只创建一次并由士兵持有，通过动作标签避免重复运行，适配基础步兵的地面移动特性
      * @override   Soldier::playWalkAnim
      */
     virtual void playWalkAnim() override;
@@ -67,7 +67,7 @@ private:
     /**
      * @brief      原始士兵行走动画的基础路径常量
      * @details    原始士兵行走动画帧的文件路径前缀，动画帧文件命名格式为 "anim/man1.png" ~ "anim/manN.png"（N为动画帧总数），
-     *             该常量用于拼接完整的动画帧文件路径，方便加载基础步兵专属行走动画纹理
+     *             该常量用于拼接初始纹理（第一帧）路径；行走动画帧登记在 TroopAnimationRegistry 的兵种动画表中
      */
     const std::string WALK_ANIM_BASE = "anim/man";
 };
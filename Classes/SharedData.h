@@ -49,6 +49,21 @@ enum class EnemyType {
     UNKNOWN                ///< 未知敌方建筑类型（用于容错判断，默认无效类型）
 };
 
+/**
+ * @enum       SoldierType
+ * @brief      士兵类型枚举
+ * @details    定义了所有支持的士兵类型标识，用于工厂方法创建对应士兵实例，
+ *             每个枚举值对应一个具体士兵子类；同时作为战斗核心（BattleWorld）的兵种索引，
+ *             因此放在无引擎依赖的共享头文件中，便于统一管理与扩展
+ */
+enum SoldierType {
+    ORIGINAL = 0,  ///< 原始士兵（基础步兵）
+    ARROW = 1,     ///< 弓箭士兵（远程单位）
+    BOOM = 2,      ///< 自爆士兵（近战自爆单位）
+    GIANT = 3,     ///< 巨人士兵（肉盾近战单位）
+    AIRFORCE = 4   ///< 空军士兵（飞行单位）
+};
+
 /**
  * @enum       BuildingState
  * @brief      建筑运行状态枚举
@@ -2,12 +2,12 @@
  * @file       Soldier.cpp
  * @brief      士兵抽象基类（Soldier）的实现文件
  * @details    该文件实现了 Soldier 头文件声明的所有通用接口，包括工厂方法创建士兵实例、
- *             通用初始化流程、AI 状态机逻辑（寻靶、移动、攻击）、受击处理、血条管理等核心功能，
- *             同时实现了飞行单位与陆军的差异化行为逻辑，为子类提供统一的基础支撑，子类可重写虚函数实现差异化特性
+ *             通用初始化流程、从战斗核心同步状态、血条管理与攻击反馈等表现层功能；
+ *             寻靶、移动、攻击等规则已迁移至 BattleWorld，子类可重写虚函数实现差异化特效
  * @version    1.0
  * @note       该文件依赖各士兵子类（GiantSoldier/OriginalSoldier 等）及 BattleScene、EnemyBuilding 头文件；
- *             工厂方法支持扩展新的士兵类型，只需在 switch 分支中添加对应子类创建逻辑；
- *             飞行单位与陆军的寻路逻辑已分离，新增飞行士兵无需修改核心寻路逻辑
+ *             工厂方法支持扩展新的士兵类型，只需在 switch 分支中添加对应子类创建逻辑，
+ *             并在 BattleRules 兵种属性表中补充对应数值
  */
 #include "Soldier.h"
 #include "GiantSoldier.h"    // 巨人士兵子类
@@ -16,7 +16,8 @@
 #include "BoomSoldier.h"     // 自爆士兵子类
 #include "AirforceSoldier.h" // 空军士兵子类
 #include "BattleScene.h"
-#include "EnemyBuilding.h" 
+#include "EnemyBuilding.h"
+#include "BattleRules.h"
 
  // =========================================================
  // 1. 工厂方法：创建具体士兵实例
@@ -111,314 +112,147 @@ Soldier* Soldier::create(BattleScene* battleScene, SoldierType type)
     return ret;
 }
 
+
 // =========================================================
-// 2. 通用初始化：士兵基础属性与状态初始化
+// 2. 通用初始化：表现层基础属性与状态初始化
 // =========================================================
 /**
  * @brief      士兵通用初始化函数
- * @details    完成士兵的基础初始化流程，包括父类 Sprite 初始化、成员变量赋值、状态初始化、
- *             缩放设置与 update 调度开启，子类重写时需优先调用该函数
+ * @details    完成士兵的基础初始化流程，包括父类 Sprite 初始化、成员变量赋值、
+ *             从 BattleRules 兵种属性表读取生命值与缩放设置，子类重写时需优先调用该函数
  * @param      battleScene  战斗场景指针，关联士兵所在的战斗场景上下文
- * @param      type         士兵类型枚举（SoldierType），保存当前士兵类型用于后续AI判断
+ * @param      type         士兵类型枚举（SoldierType），保存当前士兵类型
  * @return     bool         初始化成功返回 true；父类 Sprite 初始化失败返回 false
+ * @note       士兵逻辑统一由 BattleScene 驱动 BattleWorld 推进，不再开启每帧 update 调度
  */
 bool Soldier::init(BattleScene* battleScene, SoldierType type)
 {
     // 初始化父类 Sprite
     if (!Sprite::init()) return false;
 
-    // 初始化战斗场景关联与计时变量
+    // 初始化战斗场景关联与核心单位绑定
     _battleScene = battleScene;
-    _attackTimer = 0.0f;
-    // 初始化士兵状态与攻击目标
-    _state = State::IDLE;
-    _target = nullptr;
-    // 保存士兵类型，用于后续AI逻辑差异化处理
+    _unitIndex = BATTLE_INVALID_INDEX;
+    _state = BattleUnitState::IDLE;
+    _healthBar = nullptr;
+    // 保存士兵类型
     _soldierType = type;
 
+    // 生命值以规则表为准，血条分段在子类 setupProperties 中计算
+    _maxHp = BattleRules::unitStats(type).maxHp;
+    _currentHp = _maxHp;
+    _damagePerNotch = 1;
+
     // 设置士兵缩放比例，适配视觉显示
     this->setScale(3.0f);
-    // 开启每帧update调度，驱动AI逻辑
-    this->scheduleUpdate();
     return true;
 }
 
-// =========================================================
-// 3. 通用AI逻辑：状态机驱动与行为控制
-// =========================================================
-
 /**
- * @brief      士兵AI主更新函数，每帧调用
- * @details    核心状态机驱动函数，先校验当前攻击目标的有效性，目标失效时自动寻找新目标；
- *             再根据士兵与目标的距离，切换移动/攻击/闲置状态，并执行对应行为逻辑
- * @param      dt  帧间隔时间（秒），用于时间相关逻辑计算（移动距离、攻击计时）
+ * @brief      投放前重置表现状态
+ * @details    对象池中的士兵可能停留在上一局的最后一帧、残血或翻转状态，
+ *             这里统一恢复为与新建士兵一致的外观后再绑定新的核心单位
+ * @param      unitIndex  BattleWorld 中的单位索引
+ * @param      pos        地图节点坐标
  */
-void Soldier::update(float dt)
+void Soldier::resetForDeploy(int unitIndex, const Vec2& pos)
 {
-    // 校验当前目标有效性：目标为空/生命值为0/已被摧毁，标记目标失效
-    if (!_target || _target->getCurrentHp() <= 0 || _target->isDestroyed()) {
-        _target = nullptr;
-        // 目标失效，寻找新的攻击目标
-        findNewTarget();
-    }
+    this->stopAllActions();
 
-    // 无有效目标时，切换为闲置状态并停止动画
-    if (!_target) {
-        if (_state != State::IDLE) {
-            _state = State::IDLE;
-            stopAnim(); // 停止移动动画
-        }
-        return;
-    }
+    _unitIndex = unitIndex;
+    _state = BattleUnitState::IDLE;
+    _currentHp = _maxHp;
+    updateHealthBar();
 
-    // ==========================================
-    // 距离判断：切换移动/攻击状态
-    // ==========================================
-    // 计算士兵与目标的直线距离
-    float dist = this->getPosition().distance(_target->getPosition());
-    // 判断士兵与目标是否碰撞（直接接触）
-    bool isTouching = this->getBoundingBox().intersectsRect(_target->getBoundingBox());
-
-    // 进入攻击范围或直接接触，切换为攻击状态
-    if (dist <= _attackRange || isTouching) {
-        if (_state != State::ATTACKING) {
-            _state = State::ATTACKING;
-            stopAnim(); // 停止移动动画
-        }
-        // 执行攻击逻辑
-        attackLogic(dt);
-    }
-    // 未进入攻击范围，切换为移动状态
-    else {
-        if (_state != State::MOVING) {
-            _state = State::MOVING;
-            playWalkAnim(); // 播放移动动画
-        }
-        // 执行移动逻辑
-        moveLogic(dt);
+    // 恢复初始纹理（待机动画帧，即行走第一帧）
+    Animation* idle = TroopAnimationRegistry::getAnimation(_soldierType, TroopAnimKind::IDLE);
+    if (idle && !idle->getFrames().empty()) {
+        this->setSpriteFrame(idle->getFrames().front()->getSpriteFrame());
     }
+
+    this->setScale(3.0f);
+    this->setFlippedX(false);
+    this->setVisible(true);
+    this->setPosition(pos);
 }
 
 /**
- * @brief      寻找新的有效攻击目标
- * @details    遍历战斗场景中的防御塔与基地，根据士兵类型设置差异化优先级（分数越低优先级越高），
- *             筛选出最优目标并赋值给 _target，实现士兵的差异化寻靶逻辑（空军无视围墙、巨人优先攻击防御塔等）
+ * @brief      析构函数：释放 runTroopAnim 中持有的循环动作
  */
-void Soldier::findNewTarget()
+Soldier::~Soldier()
 {
-    // 战斗场景为空，直接返回
-    if (!_battleScene) return;
-
-    // 获取场景中所有防御塔
-    auto& towers = _battleScene->getTowers();
-    EnemyBuilding* bestTarget = nullptr;
-    // 初始化最小优先级分数为浮点数最大值
-    float minScore = FLT_MAX;
-    // 获取士兵当前位置
-    Vec2 myPos = this->getPosition();
-
-    // 遍历所有防御塔，计算优先级分数
-    for (auto tower : towers) {
-        // 防御塔无效（为空/已被摧毁），跳过
-        if (tower && !tower->isDestroyed()) {
-            // 基础分数：士兵与防御塔的距离（距离越近分数越低，优先级越高）
-            float dist = myPos.distance(tower->getPosition());
-            float score = dist;
-            // 获取防御塔类型
-            EnemyType enemyType = tower->getType();
-
-            // ============================================================
-            // 优先级核心逻辑：按士兵类型差异化调整分数
-            // ============================================================
-            if (_soldierType == SoldierType::AIRFORCE) {
-                // 空军逻辑：无视围墙，优先攻击加农炮，其次防御塔
-                if (enemyType == EnemyType::WALL) {
-                    // 围墙添加巨额罚分，优先级最低（几乎不会选择）
-                    score += 1000000.0f;
-                }
-                else if (enemyType == EnemyType::CANNON) {
-                    // 加农炮减巨额分数，优先级最高
-                    score -= 5000.0f;
-                }
-                else if (enemyType == EnemyType::TOWER) {
-                    // 防御塔减适量分数，优先级次之
-                    score -= 2000.0f;
-                }
-            }
-            else if (_soldierType == SoldierType::GIANT) {
-                // 巨人逻辑：讨厌围墙，优先攻击防御塔与加农炮
-                if (enemyType == EnemyType::WALL) {
-                    // 围墙添加高额罚分，优先级降低
-                    score += 10000.0f;
-                }
-                else if (enemyType == EnemyType::CANNON || enemyType == EnemyType::TOWER) {
-                    // 防御塔与加农炮减巨额分数，优先级最高
-                    score -= 5000.0f;
-                }
-            }
-            else {
-                // 其他陆军（原始/弓箭/自爆）：讨厌围墙，优先攻击最近目标
-                if (enemyType == EnemyType::WALL) {
-                    // 围墙添加高额罚分，除非挡路否则不选择
-                    score += 10000.0f;
-                }
-            }
-
-            // 更新最优目标（分数越低优先级越高）
-            if (score < minScore) {
-                minScore = score;
-                bestTarget = tower;
-            }
-        }
-    }
-
-    // 单独校验基地优先级，对比当前最优目标
-    auto base = _battleScene->getBase();
-    if (base && !base->isDestroyed()) {
-        float dist = myPos.distance(base->getPosition());
-        float score = dist; // 基地基础分数为距离
-
-        // 基地优先级无需额外调整，自然低于防御塔（空军/巨人逻辑）
-        if (score < minScore) {
-            bestTarget = base;
-        }
+    for (Action*& action : _animActions) {
+        CC_SAFE_RELEASE_NULL(action);
     }
-
-    // 赋值最优目标
-    _target = bestTarget;
 }
 
 /**
- * @brief      寻找距离当前士兵最近的围墙建筑
- * @details    遍历战斗场景中的所有防御塔，筛选出围墙类型且未被摧毁的建筑，
- *             计算并返回距离士兵最近的围墙指针，用于陆军寻路被阻挡时切换攻击目标
- * @return     EnemyBuilding*  最近的围墙建筑指针；无有效围墙时返回 nullptr
+ * @brief      运行本兵种的共享循环动画
+ * @details    同一士兵的同种动画只创建一次动作对象并长期持有，Animate 每次运行时会从第一帧重新开始；
+ *             帧与 Animation 由 TroopAnimationRegistry 在战斗载入时按兵种注册，所有士兵共享
+ * @param      kind  动画种类
+ * @param      tag   动作标签
  */
-EnemyBuilding* Soldier::findNearestWall()
+void Soldier::runTroopAnim(TroopAnimKind kind, int tag)
 {
-    if (!_battleScene) return nullptr;
-    EnemyBuilding* nearest = nullptr;
-    // 初始化最小距离，仅寻找近距离围墙（避免无效远距离匹配）
-    float minDst = 100.0f;
-
-    Vec2 myPos = this->getPosition();
-    // 遍历所有防御塔，筛选围墙类型
-    for (auto b : _battleScene->getTowers()) {
-        if (b && !b->isDestroyed() && b->getType() == EnemyType::WALL) {
-            float dst = myPos.distance(b->getPosition());
-            // 更新最近围墙
-            if (dst < minDst) {
-                minDst = dst;
-                nearest = b;
-            }
-        }
+    if (this->getActionByTag(tag)) return;
+
+    Action*& action = _animActions[static_cast<int>(kind)];
+    if (!action) {
+        action = TroopAnimationRegistry::createLoop(_soldierType, kind);
+        if (!action) return;
+        action->retain();
     }
-    return nearest;
+    action->setTag(tag);
+    this->runAction(action);
 }
 
+// =========================================================
+// 3. 状态同步：从战斗核心读取单位状态
+// =========================================================
+
 /**
- * @brief      士兵移动逻辑，仅在移动状态下执行
- * @details    实现飞行单位与陆军的差异化移动逻辑：飞行单位无视地形阻挡，直接向目标移动；
- *             陆军需校验移动位置是否被阻挡，被阻挡时自动切换攻击最近围墙，同时实现士兵朝向调整
- * @param      dt  帧间隔时间（秒），用于计算本次帧的移动距离
+ * @brief      从战斗核心同步士兵表现
+ * @details    位置在上一步与当前步之间插值，朝向直接写入精灵；状态由非移动切换为移动时播放行走动画，反之停止；
+ *             血量变化时刷新血条，避免每帧重复计算纹理矩形
+ * @param      world  战斗核心
+ * @param      alpha  插值系数
  */
-void Soldier::moveLogic(float dt)
+void Soldier::syncWithWorld(const BattleWorld& world, float alpha)
 {
-    // 无有效目标，直接返回
-    if (!_target) return;
-
-    // 获取士兵当前位置与目标位置
-    Vec2 myPos = this->getPosition();
-    Vec2 targetPos = _target->getPosition();
-    // 计算归一化移动方向（确保移动速度一致）
-    Vec2 direction = (targetPos - myPos).getNormalized();
-    // 计算本次帧的目标移动位置
-    Vec2 nextPos = myPos + direction * _moveSpeed * dt;
-
-    // 【核心差异化】飞行单位：无视阻挡，直接移动
-    if (this->isFlying()) {
-        // 朝向调整：根据X轴方向翻转精灵
-        if (direction.x > 0) this->setFlippedX(false);
-        else if (direction.x < 0) this->setFlippedX(true);
-
-        // 直接设置移动后的位置
-        this->setPosition(nextPos);
-        return;
-    }
-
-    // --- 陆军移动逻辑：包含阻挡判断与被迫打墙逻辑 ---
-    // 将本地坐标转换为世界坐标，用于地形阻挡判断
-    Vec2 nextWorldPos = this->getParent()->convertToWorldSpace(nextPos);
-
-    // 校验移动位置是否被阻挡
-    if (_battleScene->isPositionBlocked(nextWorldPos))
-    {
-        // 士兵与目标已碰撞，无需继续移动
-        Rect myRect = this->getBoundingBox();
-        Rect targetRect = _target->getBoundingBox();
-        if (myRect.intersectsRect(targetRect)) { return; }
-
-        // 判断是否为弓箭士兵（远程单位），已进入攻击范围则无需移动
-        bool isArcher = (_attackRange > 150.0f);
-        float distToTarget = myPos.distance(targetPos);
-        if (isArcher && distToTarget <= _attackRange) { return; }
-
-        // 被阻挡时，切换攻击最近的围墙
-        EnemyBuilding* wall = findNearestWall();
-        if (wall && _target != wall) {
-            _target = wall;
-        }
-        return;
+    const BattleUnitStore& units = world.units();
+    if (_unitIndex < 0 || _unitIndex >= static_cast<int>(units.size())) return;
+
+    // 1. 位置（两步之间插值，渲染帧率高于模拟频率时移动依然平滑）与朝向
+    const float px = units.prevX[_unitIndex];
+    const float py = units.prevY[_unitIndex];
+    this->setPosition(px + (units.x[_unitIndex] - px) * alpha, py + (units.y[_unitIndex] - py) * alpha);
+    this->setFlippedX(units.facingLeft[_unitIndex] != 0);
+
+    // 2. 状态切换驱动动画
+    BattleUnitState state = static_cast<BattleUnitState>(units.state[_unitIndex]);
+    if (state != _state) {
+        if (state == BattleUnitState::MOVING) playWalkAnim();
+        else stopAnim();
+        _state = state;
     }
 
-    // 移动位置有效，更新士兵位置与朝向
-    this->setPosition(nextPos);
-    if (direction.x > 0) this->setFlippedX(false);
-    else if (direction.x < 0) this->setFlippedX(true);
-}
-
-/**
- * @brief      士兵攻击逻辑，仅在攻击状态下执行
- * @details    每帧更新攻击计时器，当计时器达到攻击间隔时，执行攻击动画、触发通用攻击逻辑，
- *             并重置计时器；同时包含士兵与目标的有效性容错判断，避免空指针异常
- * @param      dt  帧间隔时间（秒），用于更新攻击计时器
- */
-void Soldier::attackLogic(float dt) {
-    // 更新攻击计时器
-    _attackTimer += dt;
-    // 达到攻击间隔，执行攻击操作
-    if (_attackTimer >= _attackInterval) {
-        _attackTimer = 0.0f; // 重置攻击计时器
-        if (_target) {
-            // 播放攻击缩放动画（视觉反馈）
-            auto seq = Sequence::create(ScaleTo::create(0.1f, 2.8f), ScaleTo::create(0.1f, 3.0f), nullptr);
-            this->runAction(seq);
-            // 执行通用攻击逻辑
-            this->attackTarget(_target);
-            // 容错判断：士兵已销毁或生命值为0，直接返回
-            if (this->getReferenceCount() == 0 || this->getCurrentHp() <= 0)
-                return;
-            // 目标被摧毁，标记目标失效
-            if (_target && _target->getCurrentHp() <= 0) _target = nullptr;
-        }
+    // 3. 血量变化刷新血条
+    int hp = units.hp[_unitIndex];
+    if (hp != _currentHp) {
+        _currentHp = hp;
+        updateHealthBar();
     }
 }
 
 /**
- * @brief      士兵受击逻辑，处理伤害扣除与血条更新
- * @details    扣除士兵对应生命值，做保底处理（确保生命值不小于0），并调用血条更新函数，
- *             直观展示士兵当前存活状态
- * @param      damage  本次受到的伤害值
+ * @brief      播放攻击动作反馈
+ * @details    原 attackLogic 中的攻击缩放动画：0.1 秒缩小再 0.1 秒恢复
  */
-void Soldier::takeDamage(int damage)
+void Soldier::playAttackEffect()
 {
-    // 扣除生命值
-    _currentHp -= damage;
-    // 保底处理：确保生命值不小于0
-    if (_currentHp < 0) _currentHp = 0;
-
-    // 更新血条显示
-    updateHealthBar();
+    auto seq = Sequence::create(ScaleTo::create(0.1f, 2.8f), ScaleTo::create(0.1f, 3.0f), nullptr);
+    this->runAction(seq);
 }
 
 // =========================================================
@@ -492,17 +326,3 @@ void Soldier::updateHealthBar()
     // 更新血条纹理显示
     _healthBar->setTextureRect(Rect(frameIndex * frameWidth, 0, frameWidth, textureHeight));
 }
-
-/**
- * @brief      士兵通用攻击逻辑（虚函数）
- * @details    提供默认攻击实现：对目标造成对应伤害，子类可重写该函数实现差异化攻击特效（如射箭、自爆），
- *             是士兵攻击逻辑的扩展入口
- * @param      target  被攻击的敌方建筑指针，为空时不执行任何操作
- */
-void Soldier::attackTarget(EnemyBuilding* target)
-{
-    // 目标有效时，触发目标受击逻辑
-    if (target) {
-        target->takeDamage(this->_attackDamage);
-    }
-}
\ No newline at end of file
@@ -0,0 +1,69 @@
+/**
+ * @file       SoldierPool.cpp
+ * @brief      士兵精灵对象池的实现
+ * @version    1.0
+ */
+#include "SoldierPool.h"
+#include "Soldier.h"
+
+USING_NS_CC;
+
+SoldierPool::SoldierPool()
+    : _scene(nullptr)
+    , _createdCount(0)
+{
+}
+
+Soldier* SoldierPool::createSoldier(SoldierType type)
+{
+    Soldier* soldier = Soldier::create(_scene, type);
+    if (soldier) _createdCount++;
+    return soldier;
+}
+
+void SoldierPool::prewarm(SoldierType type, int count)
+{
+    if (type < 0 || type >= BATTLE_SOLDIER_TYPE_COUNT) return;
+    Vector<Soldier*>& list = _free[type];
+    list.reserve(count);
+    while (static_cast<int>(list.size()) < count) {
+        Soldier* soldier = createSoldier(type);
+        if (!soldier) break;
+        list.pushBack(soldier);
+    }
+}
+
+Soldier* SoldierPool::acquire(SoldierType type)
+{
+    if (type < 0 || type >= BATTLE_SOLDIER_TYPE_COUNT) return nullptr;
+    Vector<Soldier*>& list = _free[type];
+    if (list.empty()) return createSoldier(type);
+
+    // 先持有再移出列表，避免引用计数归零；交由自动释放池平衡
+    Soldier* soldier = list.back();
+    soldier->retain();
+    soldier->autorelease();
+    list.popBack();
+    return soldier;
+}
+
+void SoldierPool::release(Soldier* soldier)
+{
+    if (!soldier) return;
+    SoldierType type = soldier->getSoldierType();
+    if (type < 0 || type >= BATTLE_SOLDIER_TYPE_COUNT) {
+        soldier->removeFromParent();
+        return;
+    }
+
+    // 先放入池中持有，再从父节点摘下（摘下时会停止动作与调度）
+    _free[type].pushBack(soldier);
+    soldier->removeFromParent();
+    soldier->setUnitIndex(BATTLE_INVALID_INDEX);
+}
+
+int SoldierPool::getFreeCount(SoldierType type) const
+{
+    if (type < 0 || type >= BATTLE_SOLDIER_TYPE_COUNT) return 0;
+    return static_cast<int>(_free[type].size());
+}
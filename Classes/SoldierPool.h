@@ -0,0 +1,69 @@
+/**
+ * @file       SoldierPool.h
+ * @brief      按兵种划分的士兵精灵对象池
+ * @details    士兵精灵的创建（纹理初始化、血条精灵、动画动作）全部发生在载入战斗时：
+ *             根据 DataManager 中的兵力数量为每个兵种预先创建足量的士兵；
+ *             投放时只需取出一个士兵、重置状态并挂到地图上，阵亡后从地图摘下放回池中，
+ *             长按连续投放大量士兵时不会在触摸帧里集中创建精灵造成卡顿
+ * @version    1.0
+ * @note       池持有（retain）所有空闲士兵，随战斗场景一起释放；池为空时按需创建，不会投放失败
+ */
+#ifndef SOLDIER_POOL_H_
+#define SOLDIER_POOL_H_
+
+#include "cocos2d.h"
+#include "SharedData.h"
+#include "BattleTypes.h"
+
+class Soldier;
+class BattleScene;
+
+/**
+ * @class      SoldierPool
+ * @brief      按 SoldierType 复用士兵精灵
+ */
+class SoldierPool
+{
+public:
+    SoldierPool();
+
+    /**
+     * @brief      绑定所属战斗场景（新建士兵时传给 Soldier::create）
+     */
+    void setScene(BattleScene* scene) { _scene = scene; }
+
+    /**
+     * @brief      预先创建士兵，使该兵种的空闲数量至少为 count
+     * @param      type   兵种
+     * @param      count  期望的空闲数量（通常为本局该兵种的可投放数量）
+     */
+    void prewarm(SoldierType type, int count);
+
+    /**
+     * @brief      取出一个士兵（池为空时新建），返回的士兵尚未挂到任何节点上
+     * @param      type  兵种
+     * @return     Soldier*  士兵；兵种非法或创建失败时返回 nullptr
+     */
+    Soldier* acquire(SoldierType type);
+
+    /**
+     * @brief      回收士兵：从父节点摘下、停止动作并放回对应兵种的空闲列表
+     * @param      soldier  士兵
+     */
+    void release(Soldier* soldier);
+
+    /// 指定兵种的空闲士兵数量（性能分析用）
+    int getFreeCount(SoldierType type) const;
+
+    /// 累计创建的士兵数量（含预热），投放过程中增长说明预热不足
+    int getCreatedCount() const { return _createdCount; }
+
+private:
+    Soldier* createSoldier(SoldierType type);
+
+    BattleScene* _scene;                          ///< 所属战斗场景
+    cocos2d::Vector<Soldier*> _free[BATTLE_SOLDIER_TYPE_COUNT];  ///< 各兵种的空闲士兵
+    int _createdCount;                            ///< 累计创建数量
+};
+
+#endif // SOLDIER_POOL_H_
@@ -1,6 +1,7 @@
 #include "TrainingLayer.h"
 #include "DataManager.h" 
 #include "BattleScene.h"
+#include "BattleJobSystem.h"
 
 USING_NS_CC;
 //将设置文字的标签的功能封装成一个函数
@@ -119,6 +120,20 @@ bool TrainingLayer::init()
         //设置位置
         btn->setPosition(center.x + 80, baseY + yOffset);
         menu->addChild(btn);
+
+        //每关旁边放一个预测按钮，出战前先看看胜算
+        auto oddsLbl = Label::createWithTTF("ODDS", "fonts/Marker Felt.ttf", 22);
+        oddsLbl->setColor(isLevelLocked ? Color3B::GRAY : Color3B(120, 200, 255));
+        auto oddsBtn = MenuItemLabel::create(oddsLbl, [=](Ref*) {
+            if (isLevelLocked) {
+                auto warning = this->showText("Pass previous level first!", center.x, center.y - 50, Color4B::ORANGE);
+                warning->runAction(Sequence::create(MoveBy::create(1.0f, Vec2(0, 30)), FadeOut::create(0.5f), RemoveSelf::create(), nullptr));
+                return;
+            }
+            this->startPrediction(levelRequired);
+            });
+        oddsBtn->setPosition(center.x + 250, baseY + yOffset);
+        menu->addChild(oddsBtn);
         };
 
     //设置四个关卡
@@ -130,6 +145,12 @@ bool TrainingLayer::init()
     menu->setPosition(Vec2::ZERO);
     this->addChild(menu, 10);
 
+    //预测结果显示在关闭按钮下面
+    predictLabel = Label::createWithTTF("", "fonts/Marker Felt.ttf", 22);
+    predictLabel->setPosition(center.x - 220, baseY - 90);
+    predictLabel->setAlignment(TextHAlignment::CENTER);
+    this->addChild(predictLabel, 100);
+
     return true;
 }
 //创建士兵卡片
@@ -218,6 +239,62 @@ void TrainingLayer::refreshLabels()
         label->setString(std::to_string(count));
     }
 }
+//开始预测：用当前训练好的兵力在后台模拟几百场
+void TrainingLayer::startPrediction(int level)
+{
+    //和战斗界面一样的兵种名字与类型对应
+    struct TroopKey {
+        SoldierType type;
+        std::string name;
+    };
+    const TroopKey keys[] = {
+        { SoldierType::ORIGINAL, "Soldier" },
+        { SoldierType::ARROW,    "Arrow" },
+        { SoldierType::BOOM,     "Boom" },
+        { SoldierType::GIANT,    "Giant" },
+        { SoldierType::AIRFORCE, "Airforce" }
+    };
+    std::map<std::string, int> armyData = DataManager::getInstance()->getAllArmyData();
+    int army[BATTLE_SOLDIER_TYPE_COUNT] = { 0 };
+    for (const auto& key : keys) {
+        auto it = armyData.find(key.name);
+        if (it != armyData.end()) army[static_cast<int>(key.type)] = it->second;
+    }
+
+    //只解析关卡，不进入战斗
+    BattleLevelDesc levelDesc;
+    if (!BattleScene::describeLevel(level, "", levelDesc)) {
+        predictLabel->setTextColor(Color4B::RED);
+        predictLabel->setString("Map not found");
+        return;
+    }
+
+    if (!predictor) predictor.reset(new BattlePredictor());
+    if (!predictor->start(levelDesc, army, BattleJobSystem::getInstance())) {
+        predictLabel->setTextColor(Color4B::RED);
+        predictLabel->setString("Train troops first!");
+        return;
+    }
+    predictLevel = level;
+    predictLabel->setTextColor(Color4B::WHITE);
+    predictLabel->setString(StringUtils::format("Pass %d\nSimulating...", level));
+    this->schedule(CC_SCHEDULE_SELECTOR(TrainingLayer::updatePrediction), 0.1f);
+}
+//轮询预测结果，完成后显示胜率与平均摧毁率
+void TrainingLayer::updatePrediction(float dt)
+{
+    if (!predictor || !predictor->isFinished())
+        return;
+    this->unschedule(CC_SCHEDULE_SELECTOR(TrainingLayer::updatePrediction));
+
+    const BattlePrediction& result = predictor->getResult();
+    //胜率高显示绿色，一般显示黄色，低显示红色
+    Color4B color = result.winRate >= 0.7f ? Color4B::GREEN : (result.winRate >= 0.3f ? Color4B::YELLOW : Color4B::RED);
+    predictLabel->setTextColor(color);
+    predictLabel->setString(StringUtils::format("Pass %d\nWin %d%%  Destroy %d%%\n(%d sims in %.1fs)",
+        predictLevel, static_cast<int>(result.winRate * 100.0f + 0.5f), static_cast<int>(result.meanDestruction + 0.5f),
+        result.runs, result.elapsedSeconds));
+}
 //关闭这个训练士兵界面
 void TrainingLayer::closeLayer()
 {
@@ -2,6 +2,8 @@
 #define TRAINING_LAYER_H_
 
 #include "cocos2d.h"
+#include <memory>
+#include "BattlePredictor.h"
 
 class TrainingLayer : public cocos2d::Layer
 {
@@ -14,8 +16,15 @@ private:
     void createTroopCard(std::string name, std::string image, int index, cocos2d::Vec2 pos, bool isLocked);
     cocos2d::Label* showText(std::string content, float x, float y, cocos2d::Color4B color);
     void refreshLabels();
+    //胜率预测：后台模拟当前兵力攻打某一关，结果显示在左下角
+    void startPrediction(int level);
+    void updatePrediction(float dt);
     //存储兵种名字
     std::vector<cocos2d::Label*> countLabels;
+    //预测器与结果标签
+    std::unique_ptr<BattlePredictor> predictor;
+    cocos2d::Label* predictLabel = nullptr;
+    int predictLevel = 0;
 };
 
 #endif
@@ -0,0 +1,114 @@
+/**
+ * @file       TroopAnimationRegistry.cpp
+ * @brief      兵种动画注册表的实现
+ * @version    1.0
+ */
+#include "TroopAnimationRegistry.h"
+
+USING_NS_CC;
+
+namespace {
+
+/**
+ * @brief      单个兵种的动画配置
+ * @note       attackFormat 为空时攻击动画复用行走帧，填写后只需把对应帧放入 Resources 即可生效
+ */
+struct TroopAnimDesc {
+    const char* walkFormat;     ///< 行走帧路径格式（序号从 1 开始）
+    int walkFrames;             ///< 行走帧数
+    float walkDelay;            ///< 行走每帧时长
+    const char* attackFormat;   ///< 攻击帧路径格式
+    int attackFrames;           ///< 攻击帧数
+    float attackDelay;          ///< 攻击每帧时长
+};
+
+/// 按 SoldierType 索引的动画表（行走帧与帧时长与原各兵种 playWalkAnim 一致）
+const TroopAnimDesc TROOP_ANIMS[] = {
+    { "anim/man%d.png",   4, 0.15f, nullptr, 0, 0.1f },  // ORIGINAL
+    { "anim/arrow%d.png", 4, 0.15f, nullptr, 0, 0.1f },  // ARROW
+    { "anim/boom%d.png",  4, 0.15f, nullptr, 0, 0.1f },  // BOOM
+    { "anim/giant%d.png", 4, 0.15f, nullptr, 0, 0.1f },  // GIANT
+    { "anim/Owl%d.png",   4, 0.1f,  nullptr, 0, 0.1f },  // AIRFORCE
+};
+const int TROOP_TYPE_COUNT = sizeof(TROOP_ANIMS) / sizeof(TROOP_ANIMS[0]);
+
+const char* const KIND_NAMES[] = { "walk", "idle", "attack" };
+
+std::string animationName(SoldierType type, TroopAnimKind kind)
+{
+    return StringUtils::format("troop_%d_%s", static_cast<int>(type), KIND_NAMES[static_cast<int>(kind)]);
+}
+
+/// 读取（必要时登记）一组帧，帧直接由纹理生成，不创建临时精灵
+Vector<SpriteFrame*> loadFrames(const char* format, int count)
+{
+    SpriteFrameCache* frameCache = SpriteFrameCache::getInstance();
+    TextureCache* textureCache = Director::getInstance()->getTextureCache();
+    Vector<SpriteFrame*> frames;
+    for (int i = 1; i <= count; ++i) {
+        std::string name = StringUtils::format(format, i);
+        SpriteFrame* frame = frameCache->getSpriteFrameByName(name);
+        if (!frame) {
+            Texture2D* texture = textureCache->addImage(name);
+            if (!texture) continue;
+            frame = SpriteFrame::createWithTexture(texture, Rect(Vec2::ZERO, texture->getContentSize()));
+            frameCache->addSpriteFrame(frame, name);
+        }
+        frames.pushBack(frame);
+    }
+    return frames;
+}
+
+} // namespace
+
+void TroopAnimationRegistry::preload()
+{
+    for (int t = 0; t < TROOP_TYPE_COUNT; ++t) {
+        for (int k = 0; k < static_cast<int>(TroopAnimKind::COUNT); ++k) {
+            getAnimation(static_cast<SoldierType>(t), static_cast<TroopAnimKind>(k));
+        }
+    }
+}
+
+Animation* TroopAnimationRegistry::getAnimation(SoldierType type, TroopAnimKind kind)
+{
+    if (type < 0 || type >= TROOP_TYPE_COUNT || kind == TroopAnimKind::COUNT) return nullptr;
+    Animation* animation = AnimationCache::getInstance()->getAnimation(animationName(type, kind));
+    return animation ? animation : registerType(type, kind);
+}
+
+Animation* TroopAnimationRegistry::registerType(SoldierType type, TroopAnimKind kind)
+{
+    const TroopAnimDesc& desc = TROOP_ANIMS[type];
+    Vector<SpriteFrame*> frames;
+    float delay = desc.walkDelay;
+
+    switch (kind) {
+    case TroopAnimKind::WALK:
+        frames = loadFrames(desc.walkFormat, desc.walkFrames);
+        break;
+    case TroopAnimKind::IDLE:
+        // 待机只用行走第一帧，与士兵初始纹理一致
+        frames = loadFrames(desc.walkFormat, 1);
+        break;
+    case TroopAnimKind::ATTACK:
+        frames = desc.attackFormat ? loadFrames(desc.attackFormat, desc.attackFrames)
+                                   : loadFrames(desc.walkFormat, desc.walkFrames);
+        delay = desc.attackDelay;
+        break;
+    default:
+        break;
+    }
+    if (frames.empty()) return nullptr;
+
+    Animation* animation = Animation::createWithSpriteFrames(frames, delay);
+    AnimationCache::getInstance()->addAnimation(animation, animationName(type, kind));
+    return animation;
+}
+
+Action* TroopAnimationRegistry::createLoop(SoldierType type, TroopAnimKind kind)
+{
+    Animation* animation = getAnimation(type, kind);
+    if (!animation) return nullptr;
+    return RepeatForever::create(Animate::create(animation));
+}
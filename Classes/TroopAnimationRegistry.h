@@ -0,0 +1,63 @@
+/**
+ * @file       TroopAnimationRegistry.h
+ * @brief      兵种动画注册表（行走 / 待机 / 攻击动画按兵种共享）
+ * @details    进入战斗时一次性把各兵种的动画帧登记到 SpriteFrameCache，并按“兵种 + 动画种类”
+ *             注册到 AnimationCache，所有同兵种士兵共享同一组 SpriteFrame 与 Animation。
+ *             士兵在 MOVING / ATTACKING 之间频繁切换时，只需重新运行自身缓存的循环动作，
+ *             不再每次切换都新建 Animation 并逐帧 addSpriteFrameWithFile。
+ *             新增攻击动画只需在 .cpp 的兵种动画表中填写帧路径，无需改动士兵类
+ * @version    1.0
+ * @note       注册表为纯静态接口；动画由 AnimationCache 持有，未预加载时首次查询会按需注册
+ */
+#ifndef TROOP_ANIMATION_REGISTRY_H_
+#define TROOP_ANIMATION_REGISTRY_H_
+
+#include "cocos2d.h"
+#include "SharedData.h"
+
+/**
+ * @enum       TroopAnimKind
+ * @brief      兵种动画种类
+ */
+enum class TroopAnimKind {
+    WALK = 0,   ///< 行走（空军为飞行）循环动画
+    IDLE = 1,   ///< 待机动画（默认为行走第一帧）
+    ATTACK = 2, ///< 攻击动画（未配置专属帧时复用行走帧）
+    COUNT = 3   ///< 种类数量
+};
+
+/**
+ * @class      TroopAnimationRegistry
+ * @brief      按兵种缓存共享动画的注册表
+ */
+class TroopAnimationRegistry
+{
+public:
+    /**
+     * @brief      注册全部兵种的动画（已注册的兵种直接跳过），在战斗载入时调用一次
+     */
+    static void preload();
+
+    /**
+     * @brief      获取指定兵种、指定种类的共享动画
+     * @param      type  兵种
+     * @param      kind  动画种类
+     * @return     cocos2d::Animation*  缓存中的动画；帧资源全部缺失时返回 nullptr
+     */
+    static cocos2d::Animation* getAnimation(SoldierType type, TroopAnimKind kind);
+
+    /**
+     * @brief      基于共享动画创建一个永久循环动作
+     * @details    动作只引用共享的 Animation，不加载任何帧；返回的动作为 autorelease 对象，
+     *             士兵应持有（retain）并在状态切换时反复运行，而不是每次重新创建
+     * @param      type  兵种
+     * @param      kind  动画种类
+     * @return     cocos2d::Action*  循环动作；动画缺失时返回 nullptr
+     */
+    static cocos2d::Action* createLoop(SoldierType type, TroopAnimKind kind);
+
+private:
+    static cocos2d::Animation* registerType(SoldierType type, TroopAnimKind kind);
+};
+
+#endif // TROOP_ANIMATION_REGISTRY_H_